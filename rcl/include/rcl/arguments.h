@@ -108,6 +108,8 @@ rcl_get_zero_initialized_arguments(void);
  *
  * Parameter override rule parsing is supported via `-p/--param` flags e.g. `--param name:=value`
  * or `-p name:=value`.
+ * Consecutive parameter files given with `--params-file` may be parsed on several threads, but
+ * only if `allocator` is the default allocator, as other allocators need not be thread safe.
  *
  * The default log level will be parsed as `--log-level level` and logger levels will be parsed as
  * multiple `--log-level name:=level`, where `level` is a name representing one of the log levels
@@ -403,20 +405,22 @@ rcl_arguments_get_log_levels(
 
 /// Copy one arguments structure into another.
 /**
+ * Parsed arguments are immutable, so the copy shares them with `args`
+ * instead of duplicating every remap rule, parameter override and string.
+ * They are reference counted and released by the last call to rcl_arguments_fini().
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
- * Allocates Memory   | Yes
+ * Allocates Memory   | No
  * Thread-Safe        | No
- * Uses Atomics       | No
+ * Uses Atomics       | Yes
  * Lock-Free          | Yes
  *
  * \param[in] args The structure to be copied.
- *  Its allocator is used to copy memory into the new structure.
  * \param[out] args_out A zero-initialized arguments structure to be copied into.
  * \return #RCL_RET_OK if the structure was copied successfully, or
  * \return #RCL_RET_INVALID_ARGUMENT if any function arguments are invalid, or
- * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
  * \return #RCL_RET_ERROR if an unspecified error occurs.
  */
 RCL_PUBLIC
@@ -428,12 +432,14 @@ rcl_arguments_copy(
 
 /// Reclaim resources held inside rcl_arguments_t structure.
 /**
+ * Arguments shared with copies are only released once the last of them is finalized.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
  * Allocates Memory   | No
  * Thread-Safe        | Yes
- * Uses Atomics       | No
+ * Uses Atomics       | Yes
  * Lock-Free          | Yes
  *
  * \param[in] args The structure to be deallocated.
@@ -55,6 +55,20 @@ typedef struct rcl_client_options_s
   rcl_allocator_t allocator;
 } rcl_client_options_t;
 
+/// Deadline value for in-flight requests which never expire.
+#define RCL_CLIENT_REQUEST_NO_TIMEOUT -1
+
+/// Information about a tracked request whose deadline has passed.
+typedef struct rcl_client_expired_request_s
+{
+  /// Sequence number of the request, as returned by rcl_send_tracked_request().
+  int64_t sequence_number;
+  /// Absolute deadline of the request, in the time base of the tracking clock.
+  rcl_time_point_value_t deadline;
+  /// Opaque pointer given to rcl_send_tracked_request().
+  void * user_data;
+} rcl_client_expired_request_t;
+
 /// Return a rcl_client_t struct with members set to `NULL`.
 /**
  * Should be called to get a null rcl_client_t before passing to
@@ -237,11 +251,12 @@ rcl_client_get_default_options(void);
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
- * Allocates Memory   | No
+ * Allocates Memory   | Maybe [2]
  * Thread-Safe        | Yes [1]
- * Uses Atomics       | No
+ * Uses Atomics       | Yes
  * Lock-Free          | Yes
  * <i>[1] for unique pairs of clients and requests, see above for more</i>
+ * <i>[2] only when service introspection is enabled</i>
  *
  * \param[in] client handle to the client which will make the response
  * \param[in] ros_request type-erased pointer to the ROS request message
@@ -540,6 +555,263 @@ rcl_client_configure_service_introspection(
   const rcl_publisher_options_t publisher_options,
   rcl_service_introspection_state_t introspection_state);
 
+/// Configure in-flight request tracking for the client.
+/**
+ * Once enabled, requests sent with rcl_send_tracked_request() are recorded in a
+ * fixed-capacity table keyed by sequence number, together with a deadline and
+ * an opaque user pointer.
+ * Responses taken with rcl_take_tracked_response() are matched against this
+ * table in constant time, and requests whose deadline passes without a
+ * response can be collected in bulk with rcl_client_take_expired_requests(),
+ * typically from the callback of a timer.
+ *
+ * The table is allocated once, here, so the memory used for tracking is
+ * bounded by `capacity` no matter how many responses get lost.
+ * Reconfiguring the client drops every tracked request, and a `capacity` of
+ * zero disables tracking altogether.
+ *
+ * Requests sent with rcl_send_request() are never tracked.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] client client on which to configure request tracking
+ * \param[in] clock valid clock used to compute and check request deadlines,
+ *   it must remain valid as long as tracking is enabled
+ * \param[in] capacity maximum number of in-flight requests, or 0 to disable tracking
+ * \return #RCL_RET_OK if the call was successful, or
+ * \return #RCL_RET_CLIENT_INVALID if the client is invalid, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory fails.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_configure_request_tracking(
+  rcl_client_t * client,
+  rcl_clock_t * clock,
+  size_t capacity);
+
+/// Send a ROS request using a client, and track it until it completes or expires.
+/**
+ * Behaves like rcl_send_request(), and additionally records the request in the
+ * client's in-flight table.
+ * The request expires `timeout` nanoseconds after it was sent, as measured by
+ * the clock given to rcl_client_configure_request_tracking().
+ * Pass #RCL_CLIENT_REQUEST_NO_TIMEOUT for a request which never expires.
+ *
+ * If the table is full the request is not sent.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] client handle to the client which will make the request
+ * \param[in] ros_request type-erased pointer to the ROS request message
+ * \param[in] timeout time in nanoseconds after which the request expires
+ * \param[in] user_data opaque pointer handed back when the request completes or expires
+ * \param[out] sequence_number the sequence number
+ * \return #RCL_RET_OK if the request was sent successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_CLIENT_INVALID if the client is invalid, or
+ * \return #RCL_RET_CLIENT_REQUEST_TABLE_FULL if too many requests are in flight, or
+ * \return #RCL_RET_ERROR if request tracking is not enabled or an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_send_tracked_request(
+  const rcl_client_t * client,
+  const void * ros_request,
+  rcl_duration_value_t timeout,
+  void * user_data,
+  int64_t * sequence_number);
+
+/// Take a ROS response using a client, and match it to its tracked request.
+/**
+ * Behaves like rcl_take_response_with_info(), and additionally looks the
+ * response's sequence number up in the client's in-flight table.
+ * On a match, the request stops being tracked and its user pointer is returned.
+ *
+ * Responses which match no tracked request, e.g. late responses to requests
+ * which already expired, are still taken, but
+ * #RCL_RET_CLIENT_RESPONSE_UNMATCHED is returned so they can be discarded.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only if required when filling the message, avoided for fixed sizes</i>
+ *
+ * \param[in] client handle to the client which will take the response
+ * \param[inout] request_header pointer to the request header
+ * \param[inout] ros_response type-erased pointer to the ROS response message
+ * \param[out] user_data opaque pointer given when the request was sent
+ * \return #RCL_RET_OK if the response was taken and matched successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_CLIENT_INVALID if the client is invalid, or
+ * \return #RCL_RET_CLIENT_TAKE_FAILED if take failed but no error occurred
+ *         in the middleware, or
+ * \return #RCL_RET_CLIENT_RESPONSE_UNMATCHED if the response matches no tracked request, or
+ * \return #RCL_RET_ERROR if request tracking is not enabled or an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_tracked_response(
+  const rcl_client_t * client,
+  rmw_service_info_t * request_header,
+  void * ros_response,
+  void ** user_data);
+
+/// Collect the tracked requests whose deadline has passed.
+/**
+ * Every tracked request whose deadline is at or before the current time of the
+ * tracking clock stops being tracked and is reported in `expired`, up to
+ * `expired_capacity` of them per call.
+ * A response arriving later for one of these requests is reported as
+ * #RCL_RET_CLIENT_RESPONSE_UNMATCHED by rcl_take_tracked_response().
+ *
+ * This function scans the whole table and is meant to be called periodically,
+ * e.g. from a timer whose period is the acceptable expiration latency, or at
+ * the time given by rcl_client_get_next_request_deadline().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] client handle to the client
+ * \param[out] expired caller allocated array filled with the expired requests
+ * \param[in] expired_capacity number of elements in `expired`
+ * \param[out] expired_count number of elements written to `expired`
+ * \return #RCL_RET_OK if the call was successful, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_CLIENT_INVALID if the client is invalid, or
+ * \return #RCL_RET_ERROR if request tracking is not enabled or an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_take_expired_requests(
+  const rcl_client_t * client,
+  rcl_client_expired_request_t * expired,
+  size_t expired_capacity,
+  size_t * expired_count);
+
+/// Get the earliest deadline of the client's tracked requests.
+/**
+ * `deadline` is set to INT64_MAX when no tracked request can expire.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] client handle to the client
+ * \param[out] deadline earliest deadline, in the time base of the tracking clock
+ * \param[out] pending_count number of tracked requests, may be NULL
+ * \return #RCL_RET_OK if the call was successful, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_CLIENT_INVALID if the client is invalid, or
+ * \return #RCL_RET_ERROR if request tracking is not enabled.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_get_next_request_deadline(
+  const rcl_client_t * client,
+  rcl_time_point_value_t * deadline,
+  size_t * pending_count);
+
+/// Configure which requests have their service events published by the client.
+/**
+ * With the default options, the events of every request are published.
+ * A `ratio` of N publishes the events of the requests whose sequence number is
+ * a multiple of N, and a positive `min_period` publishes the events of at most
+ * one request per period.
+ * In both cases the request and response events of a sampled call are
+ * published together.
+ *
+ * The options are kept across calls to
+ * rcl_client_configure_service_introspection(), and can be set whether or not
+ * introspection is currently enabled.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] client client on which to configure introspection sampling
+ * \param[in] sampling_options which requests get their events published
+ * \return #RCL_RET_OK if the call was successful, or
+ * \return #RCL_RET_CLIENT_INVALID if the client is invalid, or
+ * \return #RCL_RET_INVALID_ARGUMENT if the sampling options are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_configure_service_introspection_sampling(
+  rcl_client_t * client,
+  const rcl_service_introspection_sampling_options_t * sampling_options);
+
+/// Cache the answer of rcl_service_server_is_available() for a client.
+/**
+ * While enabled, rcl_service_server_is_available() only asks the middleware
+ * when the graph version of `node`, see rcl_node_get_graph_version(), has
+ * changed since the last answer, and otherwise returns the cached answer with
+ * a single atomic load.
+ *
+ * The graph version only advances when something waits on the node's graph
+ * guard condition, e.g. a graph listener thread or rcl_wait_for_service_server().
+ * If nothing does, the cached answer is never refreshed, even after the
+ * service server appears or goes away.
+ * Only enable the cache when something waits on the graph guard condition.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] client client whose server availability is cached
+ * \param[in] node node the client was created with, unused when disabling
+ * \param[in] enable whether or not to cache the server availability
+ * \return #RCL_RET_OK if the call was successful, or
+ * \return #RCL_RET_CLIENT_INVALID if the client is invalid, or
+ * \return #RCL_RET_NODE_INVALID if the node is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_configure_server_availability_cache(
+  rcl_client_t * client,
+  const rcl_node_t * node,
+  bool enable);
+
 #ifdef __cplusplus
 }
 #endif
@@ -314,6 +314,65 @@ RCL_WARN_UNUSED
 rmw_context_t *
 rcl_context_get_rmw_context(rcl_context_t * context);
 
+/// Intern a name in the context, taking a reference on the interned copy.
+/**
+ * Names are interned in a table shared by everything created in the context.
+ * rcl interns the logger names of nodes and the remapped names of clients and
+ * services there, and packages layered on rcl may intern their own names.
+ * Equal names share one immutable copy, so a name used by many entities is
+ * only stored once, and two names interned in the same context are equal if
+ * and only if they are the same pointer.
+ * Names are still compared by content throughout rcl.
+ *
+ * Each successful call must be matched by a call to rcl_context_release_name().
+ * The interned name stays valid until then, even past rcl_context_fini().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No [1]
+ * <i>[1] the table is guarded by a spin lock, held for a single lookup and never
+ *  across a call to the allocator</i>
+ *
+ * \param[in] context initialized context, it does not need to be valid
+ * \param[in] name name to intern
+ * \param[out] interned_name the interned copy of `name`
+ * \return #RCL_RET_OK if the name was interned, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_context_intern_name(
+  rcl_context_t * context,
+  const char * name,
+  const char ** interned_name);
+
+/// Release a reference on a name interned by rcl_context_intern_name().
+/**
+ * The name is removed from the table, and freed, once its last reference is released.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[in] interned_name name returned by rcl_context_intern_name()
+ * \return #RCL_RET_OK if the reference was released, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_context_release_name(const char * interned_name);
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,12 +22,18 @@ extern "C"
 {
 #endif
 
+#include <stddef.h>
+
 #include "rcutils/types/string_map.h"
+#include "rmw/validate_full_topic_name.h"
 #include "rcl/allocator.h"
 #include "rcl/macros.h"
 #include "rcl/types.h"
 #include "rcl/visibility_control.h"
 
+/// Size of a buffer large enough for any expanded topic name rmw accepts, null terminator included.
+#define RCL_EXPANDED_TOPIC_NAME_BUFFER_SIZE ((RMW_TOPIC_MAX_NAME_LENGTH) + 1u)
+
 /// Expand a given topic name into a fully-qualified topic name.
 /**
  * The input_topic_name, node_name, and node_namespace arguments must all be
@@ -124,6 +130,68 @@ rcl_expand_topic_name(
   rcl_allocator_t allocator,
   char ** output_topic_name);
 
+/// Expand a given topic name into a caller provided buffer.
+/**
+ * Does the same as rcl_expand_topic_name(), but writes the fully-qualified
+ * topic name into `output_buffer` instead of allocating it.
+ * The substitutions are done in a single pass and no memory is allocated,
+ * so this can be used from real-time threads.
+ *
+ * A buffer of #RCL_EXPANDED_TOPIC_NAME_BUFFER_SIZE bytes holds any name rmw
+ * accepts:
+ *
+ * ```c
+ * char expanded_topic_name[RCL_EXPANDED_TOPIC_NAME_BUFFER_SIZE];
+ * size_t length;
+ * rcl_ret_t ret = rcl_expand_topic_name_to_buffer(
+ *   "some/topic", "my_node", "/my_ns", &substitutions_map,
+ *   expanded_topic_name, sizeof(expanded_topic_name), &length);
+ * ```
+ *
+ * The length of the expanded name, without the null terminator, is always
+ * stored in `output_length` once the arguments are valid and all the
+ * substitutions are known.
+ * If it does not fit in the buffer, the buffer holds an empty string and
+ * #RCL_RET_INVALID_ARGUMENT is returned, so a buffer of `output_length + 1`
+ * bytes may be used to try again.
+ * Passing a `NULL` buffer of size 0 only measures the expanded name.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] input_topic_name topic name to be expanded
+ * \param[in] node_name name of the node associated with the topic
+ * \param[in] node_namespace namespace of the node associated with the topic
+ * \param[in] substitutions string map with possible substitutions
+ * \param[out] output_buffer buffer receiving the null terminated expanded name
+ * \param[in] output_buffer_size size of `output_buffer` in bytes
+ * \param[out] output_length length of the expanded name
+ * \return #RCL_RET_OK if the topic name was expanded successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid or
+ *   if the expanded name does not fit in the buffer, or
+ * \return #RCL_RET_TOPIC_NAME_INVALID if the given topic name is invalid, or
+ * \return #RCL_RET_NODE_INVALID_NAME if the name is invalid, or
+ * \return #RCL_RET_NODE_INVALID_NAMESPACE if the namespace_ is invalid, or
+ * \return #RCL_RET_UNKNOWN_SUBSTITUTION for unknown substitutions in name, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_expand_topic_name_to_buffer(
+  const char * input_topic_name,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions,
+  char * output_buffer,
+  size_t output_buffer_size,
+  size_t * output_length);
+
 /// Fill a given string map with the default substitution pairs.
 /**
  * If the string map is not initialized RCL_RET_INVALID_ARGUMENT is returned.
@@ -57,6 +57,85 @@ typedef rmw_topic_endpoint_info_array_t rcl_topic_endpoint_info_array_t;
 /// Finalize a topic_endpoint_info_array_t structure.
 #define rcl_topic_endpoint_info_array_fini rmw_topic_endpoint_info_array_fini
 
+/// A names and types list held in a single block of memory.
+/**
+ * The names, the type arrays and every string of `names_and_types` point into
+ * `block`, so the whole list is released with a single deallocation by
+ * rcl_names_and_types_arena_fini().
+ * It must not be passed to rcl_names_and_types_fini().
+ */
+typedef struct rcl_names_and_types_arena_s
+{
+  /// The list, read only
+  rcl_names_and_types_t names_and_types;
+  /// The single allocation backing the list, `NULL` if the list is empty
+  void * block;
+  /// Allocator used for `block`
+  rcl_allocator_t allocator;
+} rcl_names_and_types_arena_t;
+
+/// A condition on the endpoints of a topic, waited for by rcl_wait_for_topic_endpoints().
+typedef struct rcl_topic_endpoint_condition_s
+{
+  /// Fully qualified name of the topic
+  const char * topic_name;
+  /// Kind of endpoint to count, RMW_ENDPOINT_PUBLISHER or RMW_ENDPOINT_SUBSCRIPTION
+  rmw_endpoint_type_t endpoint_type;
+  /// Number of endpoints to wait for
+  size_t expected_count;
+  /// Output, `true` once the expected number of endpoints was seen
+  bool is_satisfied;
+} rcl_topic_endpoint_condition_t;
+
+/// Kind of change of the ROS graph reported by rcl_get_graph_changes().
+typedef enum rcl_graph_change_kind_e
+{
+  /// A node joined the graph
+  RCL_GRAPH_CHANGE_NODE_ADDED = 0,
+  /// A node left the graph
+  RCL_GRAPH_CHANGE_NODE_REMOVED,
+  /// A publisher or subscription was created
+  RCL_GRAPH_CHANGE_ENDPOINT_ADDED,
+  /// A publisher or subscription was destroyed
+  RCL_GRAPH_CHANGE_ENDPOINT_REMOVED
+} rcl_graph_change_kind_t;
+
+/// A single change of the ROS graph.
+typedef struct rcl_graph_change_s
+{
+  /// Kind of change
+  rcl_graph_change_kind_t kind;
+  /// Version of the change stream which includes this change
+  uint64_t version;
+  /// Name of the node, or of the node owning the endpoint
+  char * node_name;
+  /// Namespace of the node, or of the node owning the endpoint
+  char * node_namespace;
+  /// Type of the endpoint, RMW_ENDPOINT_INVALID for node changes
+  rmw_endpoint_type_t endpoint_type;
+  /// Topic of the endpoint, `NULL` for node changes
+  char * topic_name;
+  /// Type of the topic of the endpoint, `NULL` for node changes
+  char * topic_type;
+  /// GID of the endpoint
+  uint8_t endpoint_gid[RMW_GID_STORAGE_SIZE];
+  /// QoS profile of the endpoint
+  rmw_qos_profile_t qos_profile;
+} rcl_graph_change_t;
+
+/// An array of changes of the ROS graph.
+typedef struct rcl_graph_change_array_s
+{
+  /// Changes, oldest first
+  rcl_graph_change_t * data;
+  /// Number of changes
+  size_t size;
+  /// `true` if the changes are the whole graph, as additions, instead of a delta
+  bool is_full_snapshot;
+  /// Allocator used for the changes
+  rcl_allocator_t allocator;
+} rcl_graph_change_array_t;
+
 /// Return a list of topic names and types for publishers associated with a node.
 /**
  * The `node` parameter must point to a valid node.
@@ -401,6 +480,108 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_names_and_types_fini(rcl_names_and_types_t * names_and_types);
 
+/// Return a zero initialized rcl_names_and_types_arena_t.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_names_and_types_arena_t
+rcl_get_zero_initialized_names_and_types_arena(void);
+
+/// Copy a names and types list into a single block of memory, optionally filtering it.
+/**
+ * The copy needs one allocation however long the list is, instead of one per
+ * name, per types array and per type.
+ *
+ * If `name_suffix` is not `NULL`, only the names ending with it are kept, and
+ * the suffix is removed from them.
+ * If `type_suffix` is not `NULL`, it is removed from the types ending with it.
+ * Suffixes are compared against the end of each string, without searching it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] names_and_types list to copy
+ * \param[in] name_suffix suffix of the names to keep, or `NULL` to keep them all
+ * \param[in] type_suffix suffix to trim from the types, or `NULL`
+ * \param[in] allocator allocator for the block
+ * \param[out] arena zero initialized arena, holding the copy on success
+ * \return #RCL_RET_OK if the list was copied, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_names_and_types_arena_copy(
+  const rcl_names_and_types_t * names_and_types,
+  const char * name_suffix,
+  const char * type_suffix,
+  rcl_allocator_t * allocator,
+  rcl_names_and_types_arena_t * arena);
+
+/// Finalize a rcl_names_and_types_arena_t, releasing its block.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] arena arena to finalize, zero initialized afterwards
+ * \return #RCL_RET_OK if successful, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_names_and_types_arena_fini(rcl_names_and_types_arena_t * arena);
+
+/// Return a list of topic names and their types, held in a single block of memory.
+/**
+ * Same as rcl_get_topic_names_and_types(), with the result packed and
+ * filtered as by rcl_names_and_types_arena_copy().
+ * When the graph cache of the context answers the query, see
+ * rcl_context_configure_graph_cache(), the whole result takes a single
+ * allocation and only the kept entries are copied.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[in] allocator allocator for the block
+ * \param[in] no_demangle if true, list all topics without any demangling
+ * \param[in] name_suffix suffix of the names to keep, or `NULL` to keep them all
+ * \param[in] type_suffix suffix to trim from the types, or `NULL`
+ * \param[out] arena zero initialized arena, holding the list on success
+ * \return #RCL_RET_OK if the query was successful, or
+ * \return #RCL_RET_NODE_INVALID if the node is invalid, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_get_topic_names_and_types_arena(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  bool no_demangle,
+  const char * name_suffix,
+  const char * type_suffix,
+  rcl_names_and_types_arena_t * arena);
+
 /// Return a list of available nodes in the ROS graph.
 /**
  * The `node` parameter must point to a valid node.
@@ -674,6 +855,56 @@ rcl_wait_for_subscribers(
   rcutils_duration_value_t timeout,
   bool * success);
 
+/// Wait for several topics to have a specified number of publishers or subscribers.
+/**
+ * Waits until every one of `conditions` is satisfied, using a single wait set
+ * on the graph guard condition of `node`, see rcl_wait_for_publishers().
+ *
+ * Each time the graph changes, the endpoints of all the topics are counted in
+ * a single pass over the graph snapshot shared with rcl_get_graph_changes(),
+ * instead of querying the middleware once per topic.
+ * If the snapshot is in use by another thread, the topics are counted one by
+ * one instead.
+ *
+ * A condition stays satisfied once its count was reached, even if endpoints
+ * go away again before the other conditions are satisfied.
+ * On return, `is_satisfied` tells which conditions were met, so the caller
+ * can report what is missing after a timeout.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[in] allocator to allocate space for the wait set and the counts
+ * \param[inout] conditions the conditions to wait for, `is_satisfied` is set by this function
+ * \param[in] condition_count number of conditions, must not be zero
+ * \param[in] timeout maximum duration to wait for the conditions
+ * \param[out] success `true` if every condition was satisfied, or
+ *   `false` if a timeout occurred.
+ * \return #RCL_RET_OK if there was no errors, or
+ * \return #RCL_RET_NODE_INVALID if the node is invalid, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_TIMEOUT if a timeout occurs before every condition is satisfied, or
+ * \return #RCL_RET_ERROR if an unspecified error occurred.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_for_topic_endpoints(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  rcl_topic_endpoint_condition_t * conditions,
+  size_t condition_count,
+  rcutils_duration_value_t timeout,
+  bool * success);
+
 /// Return a list of all publishers to a topic.
 /**
  * The `node` parameter must point to a valid node.
@@ -814,12 +1045,16 @@ rcl_get_subscriptions_info_by_topic(
  * In the event that error handling needs to allocate memory, this function
  * will try to use the node's allocator.
  *
+ * If the client caches its server availability, see
+ * rcl_client_configure_server_availability_cache(), the middleware is only
+ * queried when the node's graph version has changed since the last query.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
  * Allocates Memory   | Yes
  * Thread-Safe        | No
- * Uses Atomics       | No
+ * Uses Atomics       | Yes
  * Lock-Free          | Maybe [1]
  * <i>[1] implementation may need to protect the data structure with a lock</i>
  *
@@ -839,6 +1074,186 @@ rcl_service_server_is_available(
   const rcl_client_t * client,
   bool * is_available);
 
+/// Wait for a service server to be available for the given service client.
+/**
+ * The node's graph guard condition is waited on, and the availability is only
+ * checked again when it is triggered, or when the timeout expires.
+ * Waiting also advances the node's graph version, so clients caching their
+ * server availability see graph changes through this function.
+ *
+ * A negative `timeout` waits indefinitely.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node the client was created with
+ * \param[in] allocator to allocate space for the rcl_wait_set_t used to wait for graph events
+ * \param[in] client the handle to the service client waiting for a server
+ * \param[in] timeout maximum duration to wait for a server
+ * \param[out] success `true` if a server is available, or
+ *   `false` if a timeout occurred waiting for one.
+ * \return #RCL_RET_OK if there was no errors, or
+ * \return #RCL_RET_NODE_INVALID if the node is invalid, or
+ * \return #RCL_RET_CLIENT_INVALID if the client is invalid, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_TIMEOUT if a timeout occurs before a server is available, or
+ * \return #RCL_RET_ERROR if an unspecified error occurred.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_for_service_server(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  const rcl_client_t * client,
+  rcutils_duration_value_t timeout,
+  bool * success);
+
+/// Answer graph queries of a context from a local cache.
+/**
+ * While enabled, the results of the following functions are cached per
+ * context, and handed out again for as long as the graph version of the
+ * context, see rcl_context_get_graph_version(), does not change:
+ *   - rcl_get_topic_names_and_types()
+ *   - rcl_get_service_names_and_types()
+ *   - rcl_get_node_names()
+ *   - rcl_count_publishers()
+ *   - rcl_count_subscribers()
+ *
+ * Cached answers are still copied into memory owned by the caller, but the
+ * middleware is only queried once per graph version.
+ *
+ * The graph version only moves when the graph guard condition of a node of the
+ * context is seen triggered by rcl_wait().
+ * The cache is therefore only useful, and only enabled on request, when
+ * something waits on a graph guard condition, e.g. a graph listener thread.
+ *
+ * The cache never blocks, a query made while another one is using the cache
+ * goes to the middleware instead.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] context initialized context
+ * \param[in] enable whether or not to answer graph queries from the cache
+ * \return #RCL_RET_OK if the call was successful, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_context_configure_graph_cache(rcl_context_t * context, bool enable);
+
+/// Return a version number of the ROS graph as observed within a context.
+/**
+ * The version increases every time a graph guard condition of a node of the
+ * context is seen triggered by rcl_wait(), and whenever the graph cache is
+ * enabled or disabled.
+ * Callers can compare it against the version of their last query to tell
+ * whether anything changed since.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] context initialized context
+ * \param[out] version current graph version
+ * \return #RCL_RET_OK if the call was successful, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_context_get_graph_version(const rcl_context_t * context, uint64_t * version);
+
+/// Return a zero initialized rcl_graph_change_array_t.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_graph_change_array_t
+rcl_get_zero_initialized_graph_change_array(void);
+
+/// Finalize an array of graph changes, releasing all of its memory.
+/**
+ * \param[inout] changes array to finalize, zero initialized afterwards
+ * \return #RCL_RET_OK if the array was finalized successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_graph_change_array_fini(rcl_graph_change_array_t * changes);
+
+/// Get the changes of the ROS graph since a given version of the change stream.
+/**
+ * Each context keeps a stream of graph changes: nodes added and removed, and
+ * publishers and subscriptions created and destroyed, along with their topic,
+ * type, GID and QoS.
+ * A caller keeps the `latest_version` of its previous call and passes it back
+ * as `since_version`, to only get what changed in between.
+ *
+ * Passing a `since_version` of `0`, or one older than the changes the context
+ * still remembers, returns the whole graph as additions instead, with
+ * `is_full_snapshot` set, after which the caller should drop what it knew.
+ *
+ * The middleware does not report what changed, so the context takes a
+ * snapshot of the graph whenever its graph version changed, see
+ * rcl_context_get_graph_version(), and records the differences with the
+ * previous snapshot.
+ * Taking a snapshot costs as much as querying the whole graph: the node names,
+ * the topic names, then the publishers and subscriptions of every topic.
+ * It is only done when a call finds the graph version changed, once for all
+ * callers of the context, so each caller otherwise only pays for the changes
+ * it is given.
+ * As with the graph cache, changes are only noticed once something waits on
+ * a graph guard condition of the context.
+ *
+ * Services are not reported, only topic endpoints.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes [1]
+ * Uses Atomics       | Yes
+ * Lock-Free          | No [1]
+ * <i>[1] concurrent calls with nodes of the same context wait for each other</i>
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[in] allocator allocator used for the returned changes
+ * \param[in] since_version latest version returned by a previous call, or `0`
+ * \param[out] changes zero initialized array, filled with the changes
+ * \param[out] latest_version version of the change stream including every returned change
+ * \return #RCL_RET_OK if the call was successful, or
+ * \return #RCL_RET_NODE_INVALID if the node is invalid, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_get_graph_changes(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  uint64_t since_version,
+  rcl_graph_change_array_t * changes,
+  uint64_t * latest_version);
+
 #ifdef __cplusplus
 }
 #endif
@@ -467,6 +467,36 @@ RCL_WARN_UNUSED
 const rcl_guard_condition_t *
 rcl_node_get_graph_guard_condition(const rcl_node_t * node);
 
+/// Return a version number of the ROS graph as observed through this node.
+/**
+ * The version increases every time the node's graph guard condition is seen
+ * triggered by rcl_wait(), or is triggered through rcl_trigger_guard_condition().
+ * Anything derived from the graph while the version had a given value can be
+ * reused for as long as the version does not change.
+ *
+ * The version only moves when something waits on the graph guard condition,
+ * e.g. a graph listener thread or rcl_wait_for_service_server().
+ * If nothing does, the version stays the same even though the graph changes.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] node pointer to the rcl node
+ * \param[out] version current graph version
+ * \return #RCL_RET_OK if the version was retrieved successfully, or
+ * \return #RCL_RET_NODE_INVALID if the node is invalid, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_node_get_graph_version(const rcl_node_t * node, uint64_t * version);
+
 /// Return the logger name of the node.
 /**
  * This function returns the node's internal logger name string.
@@ -82,6 +82,10 @@ rcl_get_zero_initialized_remap(void);
  * Given `foo:=bar alice:foo:=baz` and topic name `foo` the remapped topic name will always be
  * `bar` regardless of the node name given.
  *
+ * The match side of a rule may use wildcards: `*` matches exactly one token and `**` matches
+ * zero or more tokens.
+ * Given rule `/foo/*:=/bar` the topics `/foo/a` and `/foo/b` are both remapped to `/bar`.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
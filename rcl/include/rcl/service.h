@@ -33,6 +33,7 @@ extern "C"
 #include "rcl/time.h"
 #include "rcl/visibility_control.h"
 
+#include "rmw/message_sequence.h"
 #include "rmw/types.h"
 
 /// Internal rcl implementation struct.
@@ -55,6 +56,42 @@ typedef struct rcl_service_options_s
   rcl_allocator_t allocator;
 } rcl_service_options_t;
 
+/// Options controlling how a service copes with more requests than it can handle.
+typedef struct rcl_service_backpressure_options_s
+{
+  /// Count the requests received by the middleware but not taken yet.
+  bool track_pending_requests;
+  /// Requests which waited longer than this, in nanoseconds, are discarded when taken.
+  /** Zero disables load shedding. */
+  rcl_duration_value_t max_request_age;
+} rcl_service_backpressure_options_t;
+
+/// Snapshot of the request queue of a service.
+typedef struct rcl_service_request_queue_status_s
+{
+  /// Number of requests received by the middleware and not taken yet.
+  /**
+   * Always zero unless pending requests are tracked.
+   * This is an estimate: requests dropped by the middleware, e.g. when its
+   * history is full, are only accounted for once a take finds no request.
+   */
+  size_t pending_count;
+  /// Time in nanoseconds the last taken request had waited when it was taken.
+  /**
+   * This is not the age of the oldest pending request, which the middleware
+   * does not expose.
+   * It is measured from the source timestamp of the request against the local
+   * system clock, so it includes the clock skew between the client and service
+   * hosts.
+   * Only measured while pending requests are tracked or load shedding is
+   * enabled, so that other services do not read the clock on every take.
+   * Zero until such a request with a source timestamp is taken.
+   */
+  rcl_duration_value_t last_taken_request_age;
+  /// Number of requests discarded by load shedding since the service was initialized.
+  uint64_t shed_count;
+} rcl_service_request_queue_status_t;
+
 /// Return a rcl_service_t struct with members set to `NULL`.
 /**
  * Should be called to get a null rcl_service_t before passing to
@@ -318,11 +355,12 @@ rcl_take_request(
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
- * Allocates Memory   | No
+ * Allocates Memory   | Maybe [2]
  * Thread-Safe        | Yes [1]
- * Uses Atomics       | No
+ * Uses Atomics       | Maybe [2]
  * Lock-Free          | Yes
  * <i>[1] for unique pairs of services and responses, see above for more</i>
+ * <i>[2] only when service introspection is enabled</i>
  *
  * \param[in] service handle to the service which will make the response
  * \param[inout] response_header ptr to the struct holding metadata about the request ID
@@ -340,6 +378,99 @@ rcl_send_response(
   rmw_request_id_t * response_header,
   void * ros_response);
 
+/// Take a sequence of pending ROS requests using a rcl service.
+/**
+ * In contrast to rcl_take_request_with_info(), this function can take
+ * multiple requests at the same time, checking the service and the arguments
+ * only once, so a server under load can drain its queue in a single call.
+ * It is the job of the caller to ensure that the type of the requests in
+ * `request_sequence` and the type associated with the service, via the type
+ * support, match.
+ *
+ * The request_sequence pointer should point to an already allocated sequence
+ * of ROS requests of the correct type, into which the taken requests will be
+ * copied if requests are available.
+ * The request_sequence `size` member will be set to the number of requests
+ * correctly taken.
+ *
+ * `request_headers` must point to an array of at least `count` elements, the
+ * element at each index is filled with the meta information of the request at
+ * the same index in `request_sequence`.
+ *
+ * If an error occurs after some requests were taken, `size` still reflects
+ * the requests which were taken, and they must be responded to.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only if required when filling the requests, avoided for fixed sizes</i>
+ *
+ * \param[in] service the handle to the service from which to take
+ * \param[in] count number of requests to attempt to take
+ * \param[inout] request_sequence pointer to a (pre-allocated) request sequence
+ * \param[out] request_headers array of at least `count` request headers
+ * \return #RCL_RET_OK if one or more requests were taken, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_SERVICE_INVALID if the service is invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_SERVICE_TAKE_FAILED if take failed but no error occurred
+ *         in the middleware, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_request_sequence(
+  const rcl_service_t * service,
+  size_t count,
+  rmw_message_sequence_t * request_sequence,
+  rmw_service_info_t * request_headers);
+
+/// Send a batch of ROS responses to clients using a service.
+/**
+ * In contrast to rcl_send_response(), this function sends the
+ * `response_sequence->size` responses of the sequence in one call, checking
+ * the service and the arguments only once.
+ * The response at each index of `response_sequence` is sent to the request
+ * identified by the header at the same index of `response_headers`, which
+ * must hold at least `response_sequence->size` elements.
+ *
+ * Responses are sent in order, and sending stops at the first failure, in
+ * which case the responses before the failing one have already been sent.
+ *
+ * The same thread safety rules as for rcl_send_response() apply to each of
+ * the responses.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [2]
+ * Thread-Safe        | Yes [1]
+ * Uses Atomics       | Maybe [2]
+ * Lock-Free          | Yes
+ * <i>[1] for unique pairs of services and responses, see rcl_send_response()</i>
+ * <i>[2] only when service introspection is enabled</i>
+ *
+ * \param[in] service handle to the service which will make the responses
+ * \param[inout] response_headers array of structs holding metadata about the request IDs
+ * \param[in] response_sequence sequence of type-erased pointers to the ROS responses
+ * \return #RCL_RET_OK if all the responses were sent successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_SERVICE_INVALID if the service is invalid, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_send_response_batch(
+  const rcl_service_t * service,
+  rmw_request_id_t * response_headers,
+  const rmw_message_sequence_t * response_sequence);
+
 /// Get the topic name for the service.
 /**
  * This function returns the service's internal topic name string.
@@ -571,6 +702,120 @@ rcl_service_configure_service_introspection(
   const rcl_publisher_options_t publisher_options,
   rcl_service_introspection_state_t introspection_state);
 
+/// Configure which requests have their service events published by the service.
+/**
+ * With the default options, the events of every request are published.
+ * A `ratio` of N publishes the events of the requests whose sequence number is
+ * a multiple of N, and a positive `min_period` publishes the events of at most
+ * one request per period.
+ * In both cases the request and response events of a sampled call are
+ * published together.
+ *
+ * The options are kept across calls to
+ * rcl_service_configure_service_introspection(), and can be set whether or not
+ * introspection is currently enabled.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] service service on which to configure introspection sampling
+ * \param[in] sampling_options which requests get their events published
+ * \return #RCL_RET_OK if the call was successful, or
+ * \return #RCL_RET_SERVICE_INVALID if the service is invalid, or
+ * \return #RCL_RET_INVALID_ARGUMENT if the sampling options are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_service_configure_service_introspection_sampling(
+  rcl_service_t * service,
+  const rcl_service_introspection_sampling_options_t * sampling_options);
+
+/// Return the default service backpressure options.
+/**
+ * The defaults are:
+ *
+ * - track_pending_requests = false
+ * - max_request_age = 0
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_service_backpressure_options_t
+rcl_service_get_default_backpressure_options(void);
+
+/// Configure request queue tracking and load shedding for the service.
+/**
+ * When `track_pending_requests` is set, rcl listens to the middleware's new
+ * request notifications to count the requests waiting to be taken, which
+ * are then reported by rcl_service_get_request_queue_status().
+ * A callback set with rcl_service_set_on_new_request_callback() keeps being
+ * called, as rcl forwards the notifications to it.
+ * Tracking should be enabled right after rcl_service_init(), before any
+ * request is taken, otherwise requests already queued are not accounted for.
+ *
+ * When `max_request_age` is positive, the take functions discard requests
+ * whose source timestamp is older than that, and take the next one instead,
+ * so an overloaded server does not spend time on requests whose clients have
+ * likely given up.
+ * No response is sent for discarded requests.
+ * Requests without a source timestamp are never discarded.
+ * The age of a request compares its source timestamp, taken on the client
+ * host, with the system clock of the service host, so shedding depends on the
+ * clock skew between them and should only be used with synchronized clocks.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] service service on which to configure backpressure
+ * \param[in] options backpressure options
+ * \return #RCL_RET_OK if the call was successful, or
+ * \return #RCL_RET_SERVICE_INVALID if the service is invalid, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_UNSUPPORTED if tracking pending requests is not supported
+ *   by the middleware, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_service_configure_backpressure(
+  rcl_service_t * service,
+  const rcl_service_backpressure_options_t * options);
+
+/// Get a snapshot of the request queue of the service.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] service service to query
+ * \param[out] status status of the request queue
+ * \return #RCL_RET_OK if the call was successful, or
+ * \return #RCL_RET_SERVICE_INVALID if the service is invalid, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_service_get_request_queue_status(
+  const rcl_service_t * service,
+  rcl_service_request_queue_status_t * status);
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,6 +15,17 @@
 #ifndef RCL__SERVICE_INTROSPECTION_H_
 #define RCL__SERVICE_INTROSPECTION_H_
 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#include "rcl/macros.h"
+#include "rcl/time.h"
+#include "rcl/visibility_control.h"
+
 #define RCL_SERVICE_INTROSPECTION_TOPIC_POSTFIX "/_service_event"
 
 /// The introspection state for a client or service.
@@ -28,4 +39,27 @@ typedef enum rcl_service_introspection_state_e
   RCL_SERVICE_INTROSPECTION_CONTENTS,
 } rcl_service_introspection_state_t;
 
+/// Options selecting which requests have their service events published.
+/**
+ * Sampling is decided per request, so the request and response events of a
+ * sampled call are published together.
+ */
+typedef struct rcl_service_introspection_sampling_options_s
+{
+  /// Publish the events of one request out of every `ratio`, 1 publishes all of them.
+  uint32_t ratio;
+  /// Minimum time in nanoseconds between two sampled requests, 0 disables rate limiting.
+  rcl_duration_value_t min_period;
+} rcl_service_introspection_sampling_options_t;
+
+/// Return the default sampling options, which publish the events of every request.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_service_introspection_sampling_options_t
+rcl_service_introspection_get_default_sampling_options(void);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif  // RCL__SERVICE_INTROSPECTION_H_
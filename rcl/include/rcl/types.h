@@ -76,6 +76,10 @@ typedef rmw_ret_t rcl_ret_t;
 #define RCL_RET_CLIENT_INVALID 500
 /// Failed to take a response from the client return code.
 #define RCL_RET_CLIENT_TAKE_FAILED 501
+/// The client's in-flight request table is full return code.
+#define RCL_RET_CLIENT_REQUEST_TABLE_FULL 502
+/// Response does not match any in-flight request of the client return code.
+#define RCL_RET_CLIENT_RESPONSE_UNMATCHED 503
 
 // rcl service server specific ret codes in 6XX
 /// Invalid rcl_service_t given return code.
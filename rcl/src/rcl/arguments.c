@@ -17,10 +17,13 @@
 #include "rcl/arguments.h"
 
 #include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "./arguments_impl.h"
 #include "./remap_impl.h"
+#include "./remap_trie.h"
 #include "rcl/error_handling.h"
 #include "rcl/lexer_lookahead.h"
 #include "rcl/validate_topic_name.h"
@@ -31,6 +34,7 @@
 #include "rcutils/format_string.h"
 #include "rcutils/logging.h"
 #include "rcutils/logging_macros.h"
+#include "rcutils/stdatomic_helper.h"
 #include "rcutils/strdup.h"
 #include "rmw/validate_namespace.h"
 #include "rmw/validate_node_name.h"
@@ -40,6 +44,22 @@ extern "C"
 {
 #endif
 
+/// Parsed arguments, shared by all their copies.
+typedef struct _rcl_shared_arguments_s
+{
+  /// Number of rcl_arguments_t using the arguments
+  atomic_uint_least64_t reference_count;
+  /// The arguments themselves, what rcl_arguments_t::impl points to
+  rcl_arguments_impl_t impl;
+} _rcl_shared_arguments_t;
+
+static
+_rcl_shared_arguments_t *
+_rcl_shared_arguments_of(rcl_arguments_impl_t * impl)
+{
+  return (_rcl_shared_arguments_t *)((char *)impl - offsetof(_rcl_shared_arguments_t, impl));
+}
+
 /// Parse an argument that may or may not be a remap rule.
 /**
  * \param[in] arg the argument to parse
@@ -183,10 +203,10 @@ _rcl_parse_external_log_config_file(
 
 /// Parse an argument that may or may not be a parameter file.
 /**
- * The syntax of the file name is not validated.
+ * The syntax of the file name is not validated, and the file is only parsed by
+ * _rcl_parse_pending_param_files().
  * \param[in] arg the argument to parse
  * \param[in] allocator an allocator to use
- * \param[in] params points to the populated parameter struct
  * \param[in,out] param_file string that could be a parameter file name
  * \return RCL_RET_OK if the rule was parsed correctly, or
  * \return RCL_RET_BAD_ALLOC if an allocation failed, or
@@ -197,9 +217,23 @@ rcl_ret_t
 _rcl_parse_param_file(
   const char * arg,
   rcl_allocator_t allocator,
-  rcl_params_t * params,
   char ** param_file);
 
+/// Parse the parameter files found since the last call into the parameter overrides.
+/**
+ * Consecutive parameter files are parsed concurrently if the arguments use the default
+ * allocator, while parameter override rules in between them still apply in command line order.
+ * \param[in] args_impl the arguments being parsed
+ * \param[in,out] num_parsed_param_files number of parameter files already parsed
+ * \return RCL_RET_OK if the files were parsed correctly, or
+ * \return RCL_RET_INVALID_ROS_ARGS if a file could not be parsed.
+ */
+RCL_LOCAL
+rcl_ret_t
+_rcl_parse_pending_param_files(
+  rcl_arguments_impl_t * args_impl,
+  int * num_parsed_param_files);
+
 /// Parse an enclave argument.
 /**
  * \param[in] arg the argument to parse
@@ -315,6 +349,7 @@ rcl_parse_arguments(
   args_impl->log_levels = log_levels;
 
   bool parsing_ros_args = false;
+  int num_parsed_param_files = 0;
   for (int i = 0; i < argc; ++i) {
     if (parsing_ros_args) {
       // Ignore ROS specific arguments flags
@@ -331,6 +366,11 @@ rcl_parse_arguments(
       // Attempt to parse argument as parameter override flag
       if (strcmp(RCL_PARAM_FLAG, argv[i]) == 0 || strcmp(RCL_SHORT_PARAM_FLAG, argv[i]) == 0) {
         if (i + 1 < argc) {
+          // Files given before the rule must not override it
+          ret = _rcl_parse_pending_param_files(args_impl, &num_parsed_param_files);
+          if (RCL_RET_OK != ret) {
+            goto fail;
+          }
           // Attempt to parse next argument as parameter override rule
           if (RCL_RET_OK == _rcl_parse_param_rule(argv[i + 1], args_impl->parameter_overrides)) {
             RCUTILS_LOG_DEBUG_NAMED(
@@ -389,7 +429,7 @@ rcl_parse_arguments(
           args_impl->parameter_files[args_impl->num_param_files_args] = NULL;
           if (
             RCL_RET_OK == _rcl_parse_param_file(
-              argv[i + 1], allocator, args_impl->parameter_overrides,
+              argv[i + 1], allocator,
               &args_impl->parameter_files[args_impl->num_param_files_args]))
           {
             ++(args_impl->num_param_files_args);
@@ -593,6 +633,11 @@ rcl_parse_arguments(
     }
   }
 
+  ret = _rcl_parse_pending_param_files(args_impl, &num_parsed_param_files);
+  if (RCL_RET_OK != ret) {
+    goto fail;
+  }
+
   // Shrink remap_rules array to match number of successfully parsed rules
   if (0 == args_impl->num_remap_rules) {
     // No remap rules
@@ -666,6 +711,13 @@ rcl_parse_arguments(
     goto fail;
   }
 
+  // Compile topic and service remap rules so names are matched by their tokens
+  ret = rcl_remap_trie_init(
+    args_impl->remap_rules, args_impl->num_remap_rules, allocator, &args_impl->remap_trie);
+  if (ret != RCL_RET_OK) {
+    goto fail;
+  }
+
   return RCL_RET_OK;
 fail:
   fail_ret = ret;
@@ -814,7 +866,6 @@ rcl_arguments_copy(
   rcl_arguments_t * args_out)
 {
   RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_INVALID_ARGUMENT);
-  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_BAD_ALLOC);
 
   RCL_CHECK_ARGUMENT_FOR_NULL(args, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(args->impl, RCL_RET_INVALID_ARGUMENT);
@@ -824,107 +875,9 @@ rcl_arguments_copy(
     return RCL_RET_INVALID_ARGUMENT;
   }
 
-  rcl_allocator_t allocator = args->impl->allocator;
-
-  rcl_ret_t ret = _rcl_allocate_initialized_arguments_impl(args_out, &allocator);
-  if (RCL_RET_OK != ret) {
-    return ret;
-  }
-
-  if (args->impl->num_unparsed_args) {
-    // Copy unparsed args
-    args_out->impl->unparsed_args = allocator.allocate(
-      sizeof(int) * args->impl->num_unparsed_args, allocator.state);
-    if (NULL == args_out->impl->unparsed_args) {
-      if (RCL_RET_OK != rcl_arguments_fini(args_out)) {
-        RCL_SET_ERROR_MSG("Error while finalizing arguments due to another error");
-      }
-      return RCL_RET_BAD_ALLOC;
-    }
-    for (int i = 0; i < args->impl->num_unparsed_args; ++i) {
-      args_out->impl->unparsed_args[i] = args->impl->unparsed_args[i];
-    }
-    args_out->impl->num_unparsed_args = args->impl->num_unparsed_args;
-  }
-
-  if (args->impl->num_unparsed_ros_args) {
-    // Copy unparsed ROS args
-    args_out->impl->unparsed_ros_args = allocator.allocate(
-      sizeof(int) * args->impl->num_unparsed_ros_args, allocator.state);
-    if (NULL == args_out->impl->unparsed_ros_args) {
-      if (RCL_RET_OK != rcl_arguments_fini(args_out)) {
-        RCL_SET_ERROR_MSG("Error while finalizing arguments due to another error");
-      }
-      return RCL_RET_BAD_ALLOC;
-    }
-    for (int i = 0; i < args->impl->num_unparsed_ros_args; ++i) {
-      args_out->impl->unparsed_ros_args[i] = args->impl->unparsed_ros_args[i];
-    }
-    args_out->impl->num_unparsed_ros_args = args->impl->num_unparsed_ros_args;
-  }
-
-  if (args->impl->num_remap_rules) {
-    // Copy remap rules
-    args_out->impl->remap_rules = allocator.allocate(
-      sizeof(rcl_remap_t) * args->impl->num_remap_rules, allocator.state);
-    if (NULL == args_out->impl->remap_rules) {
-      if (RCL_RET_OK != rcl_arguments_fini(args_out)) {
-        RCL_SET_ERROR_MSG("Error while finalizing arguments due to another error");
-      }
-      return RCL_RET_BAD_ALLOC;
-    }
-    for (int i = 0; i < args->impl->num_remap_rules; ++i) {
-      args_out->impl->remap_rules[i] = rcl_get_zero_initialized_remap();
-      ret = rcl_remap_copy(
-        &(args->impl->remap_rules[i]), &(args_out->impl->remap_rules[i]));
-      if (RCL_RET_OK != ret) {
-        if (RCL_RET_OK != rcl_arguments_fini(args_out)) {
-          RCL_SET_ERROR_MSG("Error while finalizing arguments due to another error");
-        }
-        return ret;
-      }
-      ++(args_out->impl->num_remap_rules);
-    }
-  }
-
-  // Copy parameter rules
-  if (args->impl->parameter_overrides) {
-    args_out->impl->parameter_overrides =
-      rcl_yaml_node_struct_copy(args->impl->parameter_overrides);
-  }
-
-  // Copy parameter files
-  if (args->impl->num_param_files_args) {
-    args_out->impl->parameter_files = allocator.zero_allocate(
-      args->impl->num_param_files_args, sizeof(char *), allocator.state);
-    if (NULL == args_out->impl->parameter_files) {
-      if (RCL_RET_OK != rcl_arguments_fini(args_out)) {
-        RCL_SET_ERROR_MSG("Error while finalizing arguments due to another error");
-      }
-      return RCL_RET_BAD_ALLOC;
-    }
-    for (int i = 0; i < args->impl->num_param_files_args; ++i) {
-      args_out->impl->parameter_files[i] =
-        rcutils_strdup(args->impl->parameter_files[i], allocator);
-      if (NULL == args_out->impl->parameter_files[i]) {
-        if (RCL_RET_OK != rcl_arguments_fini(args_out)) {
-          RCL_SET_ERROR_MSG("Error while finalizing arguments due to another error");
-        }
-        return RCL_RET_BAD_ALLOC;
-      }
-      ++(args_out->impl->num_param_files_args);
-    }
-  }
-  char * enclave_copy = rcutils_strdup(args->impl->enclave, allocator);
-  if (args->impl->enclave && !enclave_copy) {
-    if (RCL_RET_OK != rcl_arguments_fini(args_out)) {
-      RCL_SET_ERROR_MSG("Error while finalizing arguments due to another error");
-    } else {
-      RCL_SET_ERROR_MSG("Error while copying enclave argument");
-    }
-    return RCL_RET_BAD_ALLOC;
-  }
-  args_out->impl->enclave = enclave_copy;
+  // Parsed arguments are never modified in place, so copies share them
+  rcutils_atomic_fetch_add_uint64_t(&_rcl_shared_arguments_of(args->impl)->reference_count, 1u);
+  args_out->impl = args->impl;
   return RCL_RET_OK;
 }
 
@@ -935,6 +888,14 @@ rcl_arguments_fini(
   RCL_CHECK_ARGUMENT_FOR_NULL(args, RCL_RET_INVALID_ARGUMENT);
   if (args->impl) {
     rcl_ret_t ret = RCL_RET_OK;
+    _rcl_shared_arguments_t * shared = _rcl_shared_arguments_of(args->impl);
+    if (1u != rcutils_atomic_fetch_add_uint64_t(&shared->reference_count, (uint64_t)-1)) {
+      // Still used by a copy
+      args->impl = NULL;
+      return ret;
+    }
+    rcl_remap_trie_fini(args->impl->remap_trie);
+    args->impl->remap_trie = NULL;
     if (args->impl->remap_rules) {
       for (int i = 0; i < args->impl->num_remap_rules; ++i) {
         rcl_ret_t remap_ret = rcl_remap_fini(&(args->impl->remap_rules[i]));
@@ -988,7 +949,7 @@ rcl_arguments_fini(
       args->impl->external_log_config_file = NULL;
     }
 
-    args->impl->allocator.deallocate(args->impl, args->impl->allocator.state);
+    args->impl->allocator.deallocate(shared, args->impl->allocator.state);
     args->impl = NULL;
     return ret;
   }
@@ -1158,14 +1119,12 @@ _rcl_parse_resource_match_token(rcl_lexer_lookahead2_t * lex_lookahead)
     return ret;
   }
 
-  if (RCL_LEXEME_TOKEN == lexeme) {
+  if (
+    RCL_LEXEME_TOKEN == lexeme || RCL_LEXEME_WILD_ONE == lexeme ||
+    RCL_LEXEME_WILD_MULTI == lexeme)
+  {
+    // wildcards are matched by the remap trie
     ret = rcl_lexer_lookahead2_accept(lex_lookahead, NULL, NULL);
-  } else if (RCL_LEXEME_WILD_ONE == lexeme) {
-    RCL_SET_ERROR_MSG("Wildcard '*' is not implemented");
-    return RCL_RET_ERROR;
-  } else if (RCL_LEXEME_WILD_MULTI == lexeme) {
-    RCL_SET_ERROR_MSG("Wildcard '**' is not implemented");
-    return RCL_RET_ERROR;
   } else {
     RCL_SET_ERROR_MSG("Expecting token or wildcard");
     ret = RCL_RET_WRONG_LEXEME;
@@ -1953,23 +1912,61 @@ rcl_ret_t
 _rcl_parse_param_file(
   const char * arg,
   rcl_allocator_t allocator,
-  rcl_params_t * params,
   char ** param_file)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(arg, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(params, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(param_file, RCL_RET_INVALID_ARGUMENT);
   *param_file = rcutils_strdup(arg, allocator);
   if (NULL == *param_file) {
     RCL_SET_ERROR_MSG("Failed to allocate memory for parameters file path");
     return RCL_RET_BAD_ALLOC;
   }
-  if (!rcl_parse_yaml_file(*param_file, params)) {
-    allocator.deallocate(*param_file, allocator.state);
-    *param_file = NULL;
-    // Error message already set.
-    return RCL_RET_ERROR;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+_rcl_parse_pending_param_files(
+  rcl_arguments_impl_t * args_impl,
+  int * num_parsed_param_files)
+{
+  const int num_pending_param_files = args_impl->num_param_files_args - *num_parsed_param_files;
+  if (0 == num_pending_param_files) {
+    return RCL_RET_OK;
+  }
+  const char * const * param_files =
+    (const char * const *)&args_impl->parameter_files[*num_parsed_param_files];
+  // rcl_parse_yaml_files() allocates from several threads, the allocators given to rcl need
+  // not allow it, so files are only parsed concurrently with the default one
+  const rcl_allocator_t default_allocator = rcl_get_default_allocator();
+  const bool parse_concurrently =
+    args_impl->allocator.allocate == default_allocator.allocate &&
+    args_impl->allocator.deallocate == default_allocator.deallocate &&
+    args_impl->allocator.reallocate == default_allocator.reallocate &&
+    args_impl->allocator.zero_allocate == default_allocator.zero_allocate;
+  if (parse_concurrently) {
+    if (
+      !rcl_parse_yaml_files(
+        param_files, (size_t)num_pending_param_files, args_impl->parameter_overrides))
+    {
+      // The error names the file
+      rcl_error_string_t prev_error_string = rcl_get_error_string();
+      rcl_reset_error();
+      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Couldn't parse params file. Error: %s", prev_error_string.str);
+      return RCL_RET_INVALID_ROS_ARGS;
+    }
+  } else {
+    for (int i = 0; i < num_pending_param_files; ++i) {
+      if (!rcl_parse_yaml_file(param_files[i], args_impl->parameter_overrides)) {
+        rcl_error_string_t prev_error_string = rcl_get_error_string();
+        rcl_reset_error();
+        RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+          "Couldn't parse params file: '%s'. Error: %s", param_files[i], prev_error_string.str);
+        return RCL_RET_INVALID_ROS_ARGS;
+      }
+    }
   }
+  *num_parsed_param_files = args_impl->num_param_files_args;
   return RCL_RET_OK;
 }
 
@@ -2046,14 +2043,18 @@ _rcl_parse_disabling_flag(
 rcl_ret_t
 _rcl_allocate_initialized_arguments_impl(rcl_arguments_t * args, rcl_allocator_t * allocator)
 {
-  args->impl = allocator->allocate(sizeof(rcl_arguments_impl_t), allocator->state);
-  if (NULL == args->impl) {
+  _rcl_shared_arguments_t * shared = allocator->allocate(
+    sizeof(_rcl_shared_arguments_t), allocator->state);
+  if (NULL == shared) {
     return RCL_RET_BAD_ALLOC;
   }
+  atomic_init(&shared->reference_count, 1u);
 
-  rcl_arguments_impl_t * args_impl = args->impl;
+  rcl_arguments_impl_t * args_impl = &shared->impl;
+  args->impl = args_impl;
   args_impl->num_remap_rules = 0;
   args_impl->remap_rules = NULL;
+  args_impl->remap_trie = NULL;
   args_impl->log_levels = rcl_get_zero_initialized_log_levels();
   args_impl->external_log_config_file = NULL;
   args_impl->unparsed_args = NULL;
@@ -17,8 +17,12 @@
 
 #include "rcl/arguments.h"
 #include "rcl/log_level.h"
+#include "rcl/macros.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
 #include "rcl_yaml_param_parser/types.h"
 #include "./remap_impl.h"
+#include "./remap_trie.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -26,6 +30,10 @@ extern "C"
 #endif
 
 /// \internal
+/**
+ * Once parsed, arguments are immutable and shared by all their copies made
+ * with rcl_arguments_copy(), so they must not be modified in place.
+ */
 struct rcl_arguments_impl_s
 {
   /// Array of indices to unknown ROS specific arguments.
@@ -50,6 +58,8 @@ struct rcl_arguments_impl_s
   rcl_remap_t * remap_rules;
   /// Length of remap_rules.
   int num_remap_rules;
+  /// Topic and service rules of remap_rules indexed by their match, or NULL if there are none.
+  rcl_remap_trie_t * remap_trie;
 
   /// Log levels parsed from arguments.
   rcl_log_levels_t log_levels;
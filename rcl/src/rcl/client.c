@@ -19,6 +19,7 @@ extern "C"
 
 #include "rcl/client.h"
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -36,20 +37,12 @@ extern "C"
 
 #include "rosidl_runtime_c/service_type_support_struct.h"
 
+#include "./client_impl.h"
+#include "./client_request_table.h"
 #include "./common.h"
+#include "./context_impl.h"
 #include "./service_event_publisher.h"
 
-struct rcl_client_impl_s
-{
-  rcl_client_options_t options;
-  rmw_qos_profile_t actual_request_publisher_qos;
-  rmw_qos_profile_t actual_response_subscription_qos;
-  rmw_client_t * rmw_handle;
-  atomic_int_least64_t sequence_number;
-  rcl_service_event_publisher_t * service_event_publisher;
-  char * remapped_service_name;
-};
-
 rcl_client_t
 rcl_get_zero_initialized_client()
 {
@@ -113,13 +106,14 @@ rcl_client_init(
     return RCL_RET_BAD_ALLOC;);
 
   // Expand the given service name.
+  char * resolved_service_name = NULL;
   rcl_ret_t ret = rcl_node_resolve_name(
     node,
     service_name,
     *allocator,
     true,
     false,
-    &client->impl->remapped_service_name);
+    &resolved_service_name);
   if (ret != RCL_RET_OK) {
     if (ret == RCL_RET_SERVICE_NAME_INVALID || ret == RCL_RET_UNKNOWN_SUBSTITUTION) {
       ret = RCL_RET_SERVICE_NAME_INVALID;
@@ -129,8 +123,15 @@ rcl_client_init(
     goto free_client_impl;
   }
   RCUTILS_LOG_DEBUG_NAMED(
-    ROS_PACKAGE_NAME, "Expanded and remapped service name '%s'",
-    client->impl->remapped_service_name);
+    ROS_PACKAGE_NAME, "Expanded and remapped service name '%s'", resolved_service_name);
+  // Clients and services of the same name share one interned copy of it
+  client->impl->remapped_service_name =
+    rcl_name_table_intern(&node->context->impl->name_table, resolved_service_name);
+  allocator->deallocate(resolved_service_name, allocator->state);
+  if (NULL == client->impl->remapped_service_name) {
+    ret = RCL_RET_BAD_ALLOC;  // error already set
+    goto free_client_impl;
+  }
 
   // Fill out implementation struct.
   // rmw handle (create rmw client)
@@ -165,6 +166,15 @@ rcl_client_init(
     goto destroy_client;
   }
 
+  // The gid never changes for the lifetime of the client, so query it only once
+  // instead of for every introspected request and response.
+  rmw_ret = rmw_get_gid_for_client(client->impl->rmw_handle, &client->impl->gid);
+  if (RMW_RET_OK != rmw_ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    ret = rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+    goto destroy_client;
+  }
+
   // ROS specific namespacing conventions avoidance
   // is not retrieved by get_actual_qos
   client->impl->actual_request_publisher_qos.avoid_ros_namespace_conventions =
@@ -174,7 +184,11 @@ rcl_client_init(
 
   // options
   client->impl->options = *options;
+  client->impl->introspection_sampling_options =
+    rcl_service_introspection_get_default_sampling_options();
   atomic_init(&client->impl->sequence_number, 0);
+  client->impl->availability_cache_guard_condition = NULL;
+  atomic_init(&client->impl->availability_cache, 0);
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Client initialized");
   TRACEPOINT(
     rcl_client_init,
@@ -193,7 +207,7 @@ destroy_client:
   }
 
 free_remapped_service_name:
-  allocator->deallocate(client->impl->remapped_service_name, allocator->state);
+  rcl_name_table_release(client->impl->remapped_service_name);
   client->impl->remapped_service_name = NULL;
 
 free_client_impl:
@@ -236,7 +250,9 @@ rcl_client_fini(rcl_client_t * client, rcl_node_t * node)
       result = RCL_RET_ERROR;
     }
 
-    allocator.deallocate(client->impl->remapped_service_name, allocator.state);
+    (void)rcl_client_request_table_fini(&client->impl->request_table);
+
+    rcl_name_table_release(client->impl->remapped_service_name);
     client->impl->remapped_service_name = NULL;
 
     allocator.deallocate(client->impl, allocator.state);
@@ -305,18 +321,12 @@ rcl_send_request(const rcl_client_t * client, const void * ros_request, int64_t
   rcutils_atomic_exchange_int64_t(&client->impl->sequence_number, *sequence_number);
 
   if (client->impl->service_event_publisher != NULL) {
-    rmw_gid_t gid;
-    rmw_ret_t rmw_ret = rmw_get_gid_for_client(client->impl->rmw_handle, &gid);
-    if (rmw_ret != RMW_RET_OK) {
-      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-      return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
-    }
     rcl_ret_t ret = rcl_send_service_event_message(
       client->impl->service_event_publisher,
       service_msgs__msg__ServiceEventInfo__REQUEST_SENT,
       ros_request,
       *sequence_number,
-      gid.data);
+      client->impl->gid.data);
     if (RCL_RET_OK != ret) {
       RCL_SET_ERROR_MSG(rcl_get_error_string().str);
       return ret;
@@ -355,18 +365,12 @@ rcl_take_response_with_info(
   }
 
   if (client->impl->service_event_publisher != NULL) {
-    rmw_gid_t gid;
-    rmw_ret_t rmw_ret = rmw_get_gid_for_client(client->impl->rmw_handle, &gid);
-    if (rmw_ret != RMW_RET_OK) {
-      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-      return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
-    }
     rcl_ret_t ret = rcl_send_service_event_message(
       client->impl->service_event_publisher,
       service_msgs__msg__ServiceEventInfo__RESPONSE_RECEIVED,
       ros_response,
       request_header->request_id.sequence_number,
-      gid.data);
+      client->impl->gid.data);
     if (RCL_RET_OK != ret) {
       RCL_SET_ERROR_MSG(rcl_get_error_string().str);
       return ret;
@@ -473,12 +477,231 @@ rcl_client_configure_service_introspection(
       client->impl->service_event_publisher = NULL;
       return ret;
     }
+
+    ret = rcl_service_event_publisher_set_sampling(
+      client->impl->service_event_publisher, &client->impl->introspection_sampling_options);
+    if (RCL_RET_OK != ret) {
+      (void)unconfigure_service_introspection(node, client->impl, &allocator);
+      return ret;
+    }
   }
 
   return rcl_service_event_publisher_change_state(
     client->impl->service_event_publisher, introspection_state);
 }
 
+rcl_ret_t
+rcl_client_configure_request_tracking(
+  rcl_client_t * client,
+  rcl_clock_t * clock,
+  size_t capacity)
+{
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCL_RET_CLIENT_INVALID);
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCL_RET_INVALID_ARGUMENT);
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCL_RET_BAD_ALLOC);
+
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+
+  rcl_ret_t ret = rcl_client_request_table_fini(&client->impl->request_table);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  client->impl->request_tracking_clock = NULL;
+  if (0u == capacity) {
+    return RCL_RET_OK;
+  }
+
+  if (!rcl_clock_valid(clock)) {
+    rcutils_reset_error();
+    RCL_SET_ERROR_MSG("clock is invalid");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  ret = rcl_client_request_table_init(
+    &client->impl->request_table, capacity, client->impl->options.allocator);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  client->impl->request_tracking_clock = clock;
+  return RCL_RET_OK;
+}
+
+static inline
+bool
+_client_is_tracking_requests(const rcl_client_t * client)
+{
+  if (NULL == client->impl->request_table.entries) {
+    RCL_SET_ERROR_MSG("request tracking is not enabled on this client");
+    return false;
+  }
+  return true;
+}
+
+rcl_ret_t
+rcl_send_tracked_request(
+  const rcl_client_t * client,
+  const void * ros_request,
+  rcl_duration_value_t timeout,
+  void * user_data,
+  int64_t * sequence_number)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_request, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(sequence_number, RCL_RET_INVALID_ARGUMENT);
+  if (!_client_is_tracking_requests(client)) {
+    return RCL_RET_ERROR;
+  }
+  rcl_client_request_table_t * table = &client->impl->request_table;
+  // Refuse before sending, a request that cannot be tracked would leak a response.
+  if (table->size >= table->capacity) {
+    RCL_SET_ERROR_MSG("in-flight request table is full");
+    return RCL_RET_CLIENT_REQUEST_TABLE_FULL;
+  }
+
+  rcl_time_point_value_t deadline = INT64_MAX;
+  if (timeout >= 0) {
+    rcl_time_point_value_t now;
+    rcl_ret_t ret = rcl_clock_get_now(client->impl->request_tracking_clock, &now);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    deadline = (now > INT64_MAX - timeout) ? INT64_MAX : now + timeout;
+  }
+
+  rcl_ret_t ret = rcl_send_request(client, ros_request, sequence_number);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  return rcl_client_request_table_insert(table, *sequence_number, deadline, user_data);
+}
+
+rcl_ret_t
+rcl_take_tracked_response(
+  const rcl_client_t * client,
+  rmw_service_info_t * request_header,
+  void * ros_response,
+  void ** user_data)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(user_data, RCL_RET_INVALID_ARGUMENT);
+  if (!_client_is_tracking_requests(client)) {
+    return RCL_RET_ERROR;
+  }
+
+  rcl_ret_t ret = rcl_take_response_with_info(client, request_header, ros_response);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+
+  rcl_client_request_entry_t entry;
+  if (!rcl_client_request_table_remove(
+      &client->impl->request_table, request_header->request_id.sequence_number, &entry))
+  {
+    *user_data = NULL;
+    RCUTILS_LOG_DEBUG_NAMED(
+      ROS_PACKAGE_NAME, "Client response %" PRId64 " matches no in-flight request",
+      request_header->request_id.sequence_number);
+    return RCL_RET_CLIENT_RESPONSE_UNMATCHED;
+  }
+  *user_data = entry.user_data;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_client_take_expired_requests(
+  const rcl_client_t * client,
+  rcl_client_expired_request_t * expired,
+  size_t expired_capacity,
+  size_t * expired_count)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(expired, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(expired_count, RCL_RET_INVALID_ARGUMENT);
+  if (!_client_is_tracking_requests(client)) {
+    return RCL_RET_ERROR;
+  }
+
+  rcl_time_point_value_t now;
+  rcl_ret_t ret = rcl_clock_get_now(client->impl->request_tracking_clock, &now);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  *expired_count = rcl_client_request_table_take_expired(
+    &client->impl->request_table, now, expired, expired_capacity);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_client_get_next_request_deadline(
+  const rcl_client_t * client,
+  rcl_time_point_value_t * deadline,
+  size_t * pending_count)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(deadline, RCL_RET_INVALID_ARGUMENT);
+  if (!_client_is_tracking_requests(client)) {
+    return RCL_RET_ERROR;
+  }
+
+  (void)rcl_client_request_table_get_next_deadline(&client->impl->request_table, deadline);
+  if (NULL != pending_count) {
+    *pending_count = client->impl->request_table.size;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_client_configure_service_introspection_sampling(
+  rcl_client_t * client,
+  const rcl_service_introspection_sampling_options_t * sampling_options)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(sampling_options, RCL_RET_INVALID_ARGUMENT);
+  if (0u == sampling_options->ratio || sampling_options->min_period < 0) {
+    RCL_SET_ERROR_MSG("sampling ratio must be positive and min period not negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  client->impl->introspection_sampling_options = *sampling_options;
+  if (client->impl->service_event_publisher != NULL) {
+    return rcl_service_event_publisher_set_sampling(
+      client->impl->service_event_publisher, sampling_options);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_client_configure_server_availability_cache(
+  rcl_client_t * client,
+  const rcl_node_t * node,
+  bool enable)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  const rcl_guard_condition_t * graph_guard_condition = NULL;
+  if (enable) {
+    graph_guard_condition = rcl_node_get_graph_guard_condition(node);
+    if (NULL == graph_guard_condition) {
+      return RCL_RET_NODE_INVALID;  // error already set
+    }
+  }
+  client->impl->availability_cache_guard_condition = graph_guard_condition;
+  rcutils_atomic_store(&client->impl->availability_cache, 0);
+  return RCL_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,48 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__CLIENT_IMPL_H_
+#define RCL__CLIENT_IMPL_H_
+
+#include "rcutils/stdatomic_helper.h"
+#include "rmw/rmw.h"
+
+#include "rcl/client.h"
+#include "rcl/guard_condition.h"
+#include "rcl/service_introspection.h"
+#include "rcl/time.h"
+
+#include "./client_request_table.h"
+#include "./service_event_publisher.h"
+
+struct rcl_client_impl_s
+{
+  rcl_client_options_t options;
+  rmw_qos_profile_t actual_request_publisher_qos;
+  rmw_qos_profile_t actual_response_subscription_qos;
+  rmw_client_t * rmw_handle;
+  rmw_gid_t gid;
+  atomic_int_least64_t sequence_number;
+  rcl_service_event_publisher_t * service_event_publisher;
+  rcl_service_introspection_sampling_options_t introspection_sampling_options;
+  const char * remapped_service_name;
+  rcl_client_request_table_t request_table;
+  rcl_clock_t * request_tracking_clock;
+  // Graph guard condition the cached server availability is tied to, NULL if not cached
+  const rcl_guard_condition_t * availability_cache_guard_condition;
+  // Graph version plus one, shifted left once, with the availability in the lowest bit
+  atomic_uint_least64_t availability_cache;
+};
+
+#endif  // RCL__CLIENT_IMPL_H_
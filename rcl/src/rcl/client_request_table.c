@@ -0,0 +1,228 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./client_request_table.h"
+
+#include <stdint.h>
+
+#include "rcl/error_handling.h"
+#include "rcutils/macros.h"
+
+// 2^64 divided by the golden ratio, used for Fibonacci hashing of sequence numbers
+#define RCL_CLIENT_REQUEST_TABLE_HASH_MULTIPLIER 0x9E3779B97F4A7C15ULL
+
+rcl_client_request_table_t
+rcl_get_zero_initialized_client_request_table()
+{
+  static rcl_client_request_table_t zero_table = {0};
+  return zero_table;
+}
+
+static inline
+size_t
+_home_slot(const rcl_client_request_table_t * table, int64_t sequence_number)
+{
+  return (size_t)(((uint64_t)sequence_number * RCL_CLIENT_REQUEST_TABLE_HASH_MULTIPLIER) >>
+         table->shift);
+}
+
+static
+rcl_client_request_entry_t *
+_find(const rcl_client_request_table_t * table, int64_t sequence_number)
+{
+  size_t i = _home_slot(table, sequence_number);
+  while (table->entries[i].occupied) {
+    if (table->entries[i].sequence_number == sequence_number) {
+      return &table->entries[i];
+    }
+    i = (i + 1) & table->mask;
+  }
+  return NULL;
+}
+
+rcl_ret_t
+rcl_client_request_table_init(
+  rcl_client_request_table_t * table,
+  size_t capacity,
+  rcl_allocator_t allocator)
+{
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCL_RET_INVALID_ARGUMENT);
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCL_RET_BAD_ALLOC);
+
+  RCL_CHECK_ARGUMENT_FOR_NULL(table, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  if (0u == capacity || capacity > (SIZE_MAX >> 2)) {
+    RCL_SET_ERROR_MSG("request table capacity is out of range");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  // Keep the load factor at or below one half, so probe sequences stay short.
+  size_t num_slots = 2u;
+  unsigned int bits = 1u;
+  while (num_slots < capacity * 2u) {
+    num_slots <<= 1;
+    ++bits;
+  }
+
+  table->entries = (rcl_client_request_entry_t *)allocator.zero_allocate(
+    num_slots, sizeof(rcl_client_request_entry_t), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    table->entries, "allocating memory for request table failed", return RCL_RET_BAD_ALLOC);
+  table->mask = num_slots - 1u;
+  table->shift = 64u - bits;
+  table->capacity = capacity;
+  table->size = 0u;
+  table->allocator = allocator;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_client_request_table_fini(rcl_client_request_table_t * table)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(table, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != table->entries) {
+    table->allocator.deallocate(table->entries, table->allocator.state);
+  }
+  *table = rcl_get_zero_initialized_client_request_table();
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_client_request_table_insert(
+  rcl_client_request_table_t * table,
+  int64_t sequence_number,
+  rcl_time_point_value_t deadline,
+  void * user_data)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(table, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    table->entries, "request table is not initialized", return RCL_RET_INVALID_ARGUMENT);
+  if (table->size >= table->capacity) {
+    RCL_SET_ERROR_MSG("in-flight request table is full");
+    return RCL_RET_CLIENT_REQUEST_TABLE_FULL;
+  }
+
+  size_t i = _home_slot(table, sequence_number);
+  while (table->entries[i].occupied) {
+    if (table->entries[i].sequence_number == sequence_number) {
+      RCL_SET_ERROR_MSG("sequence number is already tracked");
+      return RCL_RET_INVALID_ARGUMENT;
+    }
+    i = (i + 1) & table->mask;
+  }
+  table->entries[i].sequence_number = sequence_number;
+  table->entries[i].deadline = deadline;
+  table->entries[i].user_data = user_data;
+  table->entries[i].occupied = true;
+  ++table->size;
+  return RCL_RET_OK;
+}
+
+bool
+rcl_client_request_table_remove(
+  rcl_client_request_table_t * table,
+  int64_t sequence_number,
+  rcl_client_request_entry_t * entry)
+{
+  if (NULL == table || NULL == table->entries) {
+    return false;
+  }
+  rcl_client_request_entry_t * found = _find(table, sequence_number);
+  if (NULL == found) {
+    return false;
+  }
+  if (NULL != entry) {
+    *entry = *found;
+  }
+
+  // Backward shift deletion: pull later members of the probe sequence into the
+  // hole until an empty slot, or an entry already at its home slot, is found.
+  size_t hole = (size_t)(found - table->entries);
+  size_t j = hole;
+  for (;;) {
+    j = (j + 1) & table->mask;
+    if (!table->entries[j].occupied) {
+      break;
+    }
+    size_t home = _home_slot(table, table->entries[j].sequence_number);
+    // The entry at j may move into the hole only if its home is not cyclically in (hole, j].
+    bool home_between = (hole <= j) ?
+      (hole < home && home <= j) :
+      (hole < home || home <= j);
+    if (!home_between) {
+      table->entries[hole] = table->entries[j];
+      hole = j;
+    }
+  }
+  table->entries[hole].occupied = false;
+  table->entries[hole].user_data = NULL;
+  --table->size;
+  return true;
+}
+
+size_t
+rcl_client_request_table_take_expired(
+  rcl_client_request_table_t * table,
+  rcl_time_point_value_t now,
+  rcl_client_expired_request_t * expired,
+  size_t expired_capacity)
+{
+  if (NULL == table || NULL == table->entries || NULL == expired) {
+    return 0u;
+  }
+  // Collect first and remove afterwards, as removal shifts entries around.
+  size_t count = 0u;
+  for (size_t i = 0u; i <= table->mask && count < expired_capacity; ++i) {
+    const rcl_client_request_entry_t * entry = &table->entries[i];
+    if (entry->occupied && entry->deadline <= now) {
+      expired[count].sequence_number = entry->sequence_number;
+      expired[count].deadline = entry->deadline;
+      expired[count].user_data = entry->user_data;
+      ++count;
+    }
+  }
+  for (size_t i = 0u; i < count; ++i) {
+    (void)rcl_client_request_table_remove(table, expired[i].sequence_number, NULL);
+  }
+  return count;
+}
+
+bool
+rcl_client_request_table_get_next_deadline(
+  const rcl_client_request_table_t * table,
+  rcl_time_point_value_t * deadline)
+{
+  if (NULL == deadline) {
+    return false;
+  }
+  *deadline = INT64_MAX;
+  if (NULL == table || NULL == table->entries || 0u == table->size) {
+    return false;
+  }
+  for (size_t i = 0u; i <= table->mask; ++i) {
+    if (table->entries[i].occupied && table->entries[i].deadline < *deadline) {
+      *deadline = table->entries[i].deadline;
+    }
+  }
+  return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,176 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__CLIENT_REQUEST_TABLE_H_
+#define RCL__CLIENT_REQUEST_TABLE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcl/allocator.h"
+#include "rcl/client.h"
+#include "rcl/macros.h"
+#include "rcl/time.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+/// A single slot of the in-flight request table.
+typedef struct rcl_client_request_entry_s
+{
+  /// Sequence number of the request, the key of the table
+  int64_t sequence_number;
+  /// Absolute deadline of the request, INT64_MAX if it never expires
+  rcl_time_point_value_t deadline;
+  /// Opaque pointer given when the request was sent
+  void * user_data;
+  /// Whether or not this slot holds a request
+  bool occupied;
+} rcl_client_request_entry_t;
+
+/// Fixed-capacity, open-addressing table of in-flight requests keyed by sequence number.
+/**
+ * The table uses linear probing with backward shift deletion, so no tombstones
+ * are left behind and lookups stay O(1) regardless of how many requests have
+ * come and gone.
+ * The slot array is sized to at least twice the capacity, which bounds the load
+ * factor to one half.
+ */
+typedef struct rcl_client_request_table_s
+{
+  /// Slot array, of size `mask + 1`
+  rcl_client_request_entry_t * entries;
+  /// Number of slots minus one, the number of slots is always a power of two
+  size_t mask;
+  /// Right shift applied to the multiplicative hash to obtain a slot index
+  unsigned int shift;
+  /// Maximum number of requests which can be tracked at once
+  size_t capacity;
+  /// Number of requests currently tracked
+  size_t size;
+  /// Allocator used for the slot array
+  rcl_allocator_t allocator;
+} rcl_client_request_table_t;
+
+/// Return a rcl_client_request_table_t struct with members set to `NULL`.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_client_request_table_t
+rcl_get_zero_initialized_client_request_table(void);
+
+/// Initialize an in-flight request table able to hold `capacity` requests.
+/**
+ * This is the only function of the table which allocates memory.
+ *
+ * \param[inout] table zero initialized table
+ * \param[in] capacity maximum number of in-flight requests, must be greater than zero
+ * \param[in] allocator allocator used for the slot array
+ * \return #RCL_RET_OK if the table was initialized successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory fails.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_request_table_init(
+  rcl_client_request_table_t * table,
+  size_t capacity,
+  rcl_allocator_t allocator);
+
+/// Finalize an in-flight request table, forgetting any tracked request.
+/**
+ * \param[inout] table table to be finalized
+ * \return #RCL_RET_OK if the table was finalized successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_request_table_fini(rcl_client_request_table_t * table);
+
+/// Start tracking a request.
+/**
+ * \param[inout] table initialized table
+ * \param[in] sequence_number sequence number of the request
+ * \param[in] deadline absolute deadline of the request
+ * \param[in] user_data opaque pointer returned when the request completes or expires
+ * \return #RCL_RET_OK if the request is now tracked, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid or the
+ *   sequence number is already tracked, or
+ * \return #RCL_RET_CLIENT_REQUEST_TABLE_FULL if the table is at capacity.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_request_table_insert(
+  rcl_client_request_table_t * table,
+  int64_t sequence_number,
+  rcl_time_point_value_t deadline,
+  void * user_data);
+
+/// Stop tracking a request, returning its entry.
+/**
+ * \param[inout] table initialized table
+ * \param[in] sequence_number sequence number of the request
+ * \param[out] entry copy of the removed entry, may be NULL
+ * \return `true` if the request was tracked and has been removed, otherwise `false`
+ */
+RCL_PUBLIC
+bool
+rcl_client_request_table_remove(
+  rcl_client_request_table_t * table,
+  int64_t sequence_number,
+  rcl_client_request_entry_t * entry);
+
+/// Remove and report the requests whose deadline is at or before `now`.
+/**
+ * At most `expired_capacity` requests are reported per call, any remaining
+ * expired request is kept and reported by the next call.
+ *
+ * \param[inout] table initialized table
+ * \param[in] now current time, in the same time base as the deadlines
+ * \param[out] expired array to be filled with the expired requests
+ * \param[in] expired_capacity number of elements in `expired`
+ * \return number of requests written to `expired`
+ */
+RCL_PUBLIC
+size_t
+rcl_client_request_table_take_expired(
+  rcl_client_request_table_t * table,
+  rcl_time_point_value_t now,
+  rcl_client_expired_request_t * expired,
+  size_t expired_capacity);
+
+/// Get the earliest deadline of all tracked requests.
+/**
+ * \param[in] table initialized table
+ * \param[out] deadline earliest deadline, INT64_MAX if no tracked request can expire
+ * \return `true` if at least one request is tracked, otherwise `false`
+ */
+RCL_PUBLIC
+bool
+rcl_client_request_table_get_next_deadline(
+  const rcl_client_request_table_t * table,
+  rcl_time_point_value_t * deadline);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__CLIENT_REQUEST_TABLE_H_
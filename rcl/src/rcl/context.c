@@ -105,6 +105,37 @@ rcl_context_get_rmw_context(rcl_context_t * context)
   return &(context->impl->rmw_context);
 }
 
+rcl_ret_t
+rcl_context_intern_name(
+  rcl_context_t * context,
+  const char * name,
+  const char ** interned_name)
+{
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCL_RET_INVALID_ARGUMENT);
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCL_RET_BAD_ALLOC);
+
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context->impl, "context is zero-initialized", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(interned_name, RCL_RET_INVALID_ARGUMENT);
+  *interned_name = rcl_name_table_intern(&context->impl->name_table, name);
+  if (NULL == *interned_name) {
+    return RCL_RET_BAD_ALLOC;  // error already set
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_context_release_name(const char * interned_name)
+{
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCL_RET_INVALID_ARGUMENT);
+
+  RCL_CHECK_ARGUMENT_FOR_NULL(interned_name, RCL_RET_INVALID_ARGUMENT);
+  rcl_name_table_release(interned_name);
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 __cleanup_context(rcl_context_t * context)
 {
@@ -172,6 +203,9 @@ __cleanup_context(rcl_context_t * context)
       }
       allocator.deallocate(context->impl->argv, allocator.state);
     }
+    rcl_graph_cache_fini(&context->impl->graph_cache);
+    rcl_graph_change_log_fini(&context->impl->graph_change_log);
+    rcl_name_table_fini(&context->impl->name_table);
     allocator.deallocate(context->impl, allocator.state);
   }  // if (NULL != context->impl)
 
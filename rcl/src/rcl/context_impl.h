@@ -18,7 +18,10 @@
 #include "rcl/context.h"
 #include "rcl/error_handling.h"
 
+#include "./graph_cache.h"
+#include "./graph_change_log.h"
 #include "./init_options_impl.h"
+#include "./name_table.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -38,6 +41,12 @@ struct rcl_context_impl_s
   char ** argv;
   /// rmw context.
   rmw_context_t rmw_context;
+  /// Cache of graph query results, and graph version of the context.
+  rcl_graph_cache_t graph_cache;
+  /// Graph snapshot and recent graph changes.
+  rcl_graph_change_log_t graph_change_log;
+  /// Interned names of the entities of the context.
+  rcl_name_table_t name_table;
 };
 
 RCL_LOCAL
@@ -27,9 +27,6 @@ extern "C"
 #include "rcl/types.h"
 #include "rcl/validate_topic_name.h"
 #include "rcutils/error_handling.h"
-#include "rcutils/format_string.h"
-#include "rcutils/repl_str.h"
-#include "rcutils/strdup.h"
 #include "rmw/error_handling.h"
 #include "rmw/types.h"
 #include "rmw/validate_namespace.h"
@@ -40,28 +37,134 @@ extern "C"
 #define SUBSTITUION_NAMESPACE "{ns}"
 #define SUBSTITUION_NAMESPACE2 "{namespace}"
 
+// Look up the replacement of the substitution `{...}` of `length` characters at `brace`.
+static
+const char *
+_get_replacement(
+  const char * brace,
+  size_t length,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions)
+{
+  if (strncmp(SUBSTITUION_NODE_NAME, brace, length) == 0) {
+    return node_name;
+  }
+  if (
+    strncmp(SUBSTITUION_NAMESPACE, brace, length) == 0 ||
+    strncmp(SUBSTITUION_NAMESPACE2, brace, length) == 0)
+  {
+    return node_namespace;
+  }
+  // compare {substitution}
+  //          ^ until    ^
+  return rcutils_string_map_getn(substitutions, brace + 1, length - 2);
+}
+
+// Copy `length` characters of `str` at `*offset`, as far as they fit in the buffer.
+static
+void
+_append(char * buffer, size_t buffer_size, size_t * offset, const char * str, size_t length)
+{
+  if (*offset < buffer_size) {
+    size_t available = buffer_size - *offset;
+    memcpy(buffer + *offset, str, length < available ? length : available);
+  }
+  *offset += length;
+}
+
+// Write the expansion of a validated topic name in a single pass.
+// Only what fits in the buffer is written, the full length is always returned in `length`.
+static
 rcl_ret_t
-rcl_expand_topic_name(
+_expand_topic_name(
   const char * input_topic_name,
   const char * node_name,
   const char * node_namespace,
   const rcutils_string_map_t * substitutions,
-  rcl_allocator_t allocator,
-  char ** output_topic_name)
+  char * buffer,
+  size_t buffer_size,
+  size_t * length)
 {
-  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_INVALID_ARGUMENT);
-  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_TOPIC_NAME_INVALID);
-  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_NODE_INVALID_NAME);
-  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_NODE_INVALID_NAMESPACE);
-  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_UNKNOWN_SUBSTITUTION);
-  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_BAD_ALLOC);
+  // special case where node_namespace is just '/'
+  // then no additional separating '/' is needed
+  const size_t namespace_length = strlen(node_namespace);
+  const size_t separator_length = namespace_length == 1 ? 0u : 1u;
+  const char * input = input_topic_name;
+  size_t offset = 0u;
+
+  // Assumptions about the topic string, checked by the validation function:
+  //
+  // - All {} are matched and balanced
+  // - There is no nesting, i.e. {{}}
+  // - There are no empty substitution substr, i.e. '{}' versus '{something}'
+  //
+  // Replacements are copied as they are, they are not expanded themselves.
+  if (input[0] == '~') {
+    _append(buffer, buffer_size, &offset, node_namespace, namespace_length);
+    _append(buffer, buffer_size, &offset, "/", separator_length);
+    _append(buffer, buffer_size, &offset, node_name, strlen(node_name));
+    ++input;
+  } else {
+    // the name is made absolute if the first character of the expansion is not a '/'
+    const char * c = input;
+    while (*c == '{') {
+      const char * closing_brace = strchr(c, '}');
+      const char * replacement = _get_replacement(
+        c, (size_t)(closing_brace - c) + 1u, node_name, node_namespace, substitutions);
+      if (NULL == replacement || replacement[0] != '\0') {
+        // an unknown substitution is reported below
+        c = NULL == replacement ? "" : replacement;
+        break;
+      }
+      c = closing_brace + 1;
+    }
+    if (*c != '/') {
+      _append(buffer, buffer_size, &offset, node_namespace, namespace_length);
+      _append(buffer, buffer_size, &offset, "/", separator_length);
+    }
+  }
 
+  const char * opening_brace;
+  while ((opening_brace = strchr(input, '{')) != NULL) {
+    _append(buffer, buffer_size, &offset, input, (size_t)(opening_brace - input));
+    const char * closing_brace = strchr(opening_brace, '}');
+    // conclusion based on above assumptions: closing_brace - opening_brace > 1
+    size_t substitution_length = (size_t)(closing_brace - opening_brace) + 1u;
+    const char * replacement = _get_replacement(
+      opening_brace, substitution_length, node_name, node_namespace, substitutions);
+    if (NULL == replacement) {
+      // in this case, it is neither node name nor ns nor in the substitutions map, so error
+      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "unknown substitution: %.*s", (int)substitution_length, opening_brace);
+      return RCL_RET_UNKNOWN_SUBSTITUTION;
+    }
+    _append(buffer, buffer_size, &offset, replacement, strlen(replacement));
+    input = closing_brace + 1;
+  }
+  _append(buffer, buffer_size, &offset, input, strlen(input));
+
+  if (offset < buffer_size) {
+    buffer[offset] = '\0';
+  }
+  *length = offset;
+  return RCL_RET_OK;
+}
+
+// Validate the arguments shared by both flavors of the expansion.
+static
+rcl_ret_t
+_validate_expand_arguments(
+  const char * input_topic_name,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions)
+{
   // check arguments that could be null
   RCL_CHECK_ARGUMENT_FOR_NULL(input_topic_name, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(node_name, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(node_namespace, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(substitutions, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(output_topic_name, RCL_RET_INVALID_ARGUMENT);
   // validate the input topic
   int validation_result;
   rcl_ret_t ret = rcl_validate_topic_name(input_topic_name, &validation_result, NULL);
@@ -94,123 +197,57 @@ rcl_expand_topic_name(
     RCL_SET_ERROR_MSG("node namespace is invalid");
     return RCL_RET_NODE_INVALID_NAMESPACE;
   }
-  // check if the topic has substitutions to be made
-  bool has_a_substitution = strchr(input_topic_name, '{') != NULL;
-  bool has_a_namespace_tilde = input_topic_name[0] == '~';
-  bool is_absolute = input_topic_name[0] == '/';
-  // if absolute and doesn't have any substitution
-  if (is_absolute && !has_a_substitution) {
-    // nothing to do, duplicate and return
-    *output_topic_name = rcutils_strdup(input_topic_name, allocator);
-    if (!*output_topic_name) {
-      *output_topic_name = NULL;
-      RCL_SET_ERROR_MSG("failed to allocate memory for output topic");
-      return RCL_RET_BAD_ALLOC;
-    }
-    return RCL_RET_OK;
-  }
-  char * local_output = NULL;
-  // if has_a_namespace_tilde, replace that first
-  if (has_a_namespace_tilde) {
-    // special case where node_namespace is just '/'
-    // then no additional separating '/' is needed
-    const char * fmt = (strlen(node_namespace) == 1) ? "%s%s%s" : "%s/%s%s";
-    local_output =
-      rcutils_format_string(allocator, fmt, node_namespace, node_name, input_topic_name + 1);
-    if (!local_output) {
-      *output_topic_name = NULL;
-      RCL_SET_ERROR_MSG("failed to allocate memory for output topic");
-      return RCL_RET_BAD_ALLOC;
-    }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_expand_topic_name(
+  const char * input_topic_name,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions,
+  rcl_allocator_t allocator,
+  char ** output_topic_name)
+{
+  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_INVALID_ARGUMENT);
+  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_TOPIC_NAME_INVALID);
+  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_NODE_INVALID_NAME);
+  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_NODE_INVALID_NAMESPACE);
+  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_UNKNOWN_SUBSTITUTION);
+  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_BAD_ALLOC);
+
+  RCL_CHECK_ARGUMENT_FOR_NULL(output_topic_name, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = _validate_expand_arguments(
+    input_topic_name, node_name, node_namespace, substitutions);
+  if (ret != RCL_RET_OK) {
+    return ret;
   }
-  // if it has any substitutions, replace those
-  if (has_a_substitution) {
-    // Assumptions entering this scope about the topic string:
-    //
-    // - All {} are matched and balanced
-    // - There is no nesting, i.e. {{}}
-    // - There are no empty substitution substr, i.e. '{}' versus '{something}'
-    //
-    // These assumptions are taken because this is checked in the validation function.
-    const char * current_output = (local_output) ? local_output : input_topic_name;
-    char * next_opening_brace = NULL;
-    // current_output may be replaced on each loop if a substitution is made
-    while ((next_opening_brace = strchr(current_output, '{')) != NULL) {
-      char * next_closing_brace = strchr(current_output, '}');
-      // conclusion based on above assumptions: next_closing_brace - next_opening_brace > 1
-      size_t substitution_substr_len = next_closing_brace - next_opening_brace + 1;
-      // figure out what the replacement is for this substitution
-      const char * replacement = NULL;
-      if (strncmp(SUBSTITUION_NODE_NAME, next_opening_brace, substitution_substr_len) == 0) {
-        replacement = node_name;
-      } else if (  // NOLINT
-        strncmp(SUBSTITUION_NAMESPACE, next_opening_brace, substitution_substr_len) == 0 ||
-        strncmp(SUBSTITUION_NAMESPACE2, next_opening_brace, substitution_substr_len) == 0)
-      {
-        replacement = node_namespace;
-      } else {
-        replacement = rcutils_string_map_getn(
-          substitutions,
-          // compare {substitution}
-          //          ^ until    ^
-          next_opening_brace + 1, substitution_substr_len - 2);
-        if (!replacement) {
-          // in this case, it is neither node name nor ns nor in the substitutions map, so error
-          *output_topic_name = NULL;
-          char * unmatched_substitution =
-            rcutils_strndup(next_opening_brace, substitution_substr_len, allocator);
-          if (unmatched_substitution) {
-            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-              "unknown substitution: %s", unmatched_substitution);
-          } else {
-            RCUTILS_SAFE_FWRITE_TO_STDERR("failed to allocate memory for unmatched substitution\n");
-          }
-          allocator.deallocate(unmatched_substitution, allocator.state);
-          allocator.deallocate(local_output, allocator.state);
-          return RCL_RET_UNKNOWN_SUBSTITUTION;
-        }
-      }
-      // at this point replacement will be set or an error would have returned out
-      // do the replacement
-      char * next_substitution =
-        rcutils_strndup(next_opening_brace, substitution_substr_len, allocator);
-      if (!next_substitution) {
-        *output_topic_name = NULL;
-        RCL_SET_ERROR_MSG("failed to allocate memory for substitution");
-        allocator.deallocate(local_output, allocator.state);
-        return RCL_RET_BAD_ALLOC;
-      }
-      char * original_local_output = local_output;
-      local_output = rcutils_repl_str(current_output, next_substitution, replacement, &allocator);
-      allocator.deallocate(next_substitution, allocator.state);  // free no matter what
-      allocator.deallocate(original_local_output, allocator.state);  // free no matter what
-      if (!local_output) {
-        *output_topic_name = NULL;
-        RCL_SET_ERROR_MSG("failed to allocate memory for expanded topic");
-        return RCL_RET_BAD_ALLOC;
-      }
-      current_output = local_output;
-      // loop until all substitutions are replaced
-    }  // while
+  // expand in a stack buffer first, it fits for any name rmw would accept
+  char buffer[RCL_EXPANDED_TOPIC_NAME_BUFFER_SIZE];
+  size_t length = 0u;
+  ret = _expand_topic_name(
+    input_topic_name, node_name, node_namespace, substitutions, buffer, sizeof(buffer), &length);
+  if (ret != RCL_RET_OK) {
+    *output_topic_name = NULL;
+    return ret;
   }
-  // finally make the name absolute if it isn't already
-  if (
-    (local_output && local_output[0] != '/') ||
-    (!local_output && input_topic_name[0] != '/'))
-  {
-    char * original_local_output = local_output;
-    // special case where node_namespace is just '/'
-    // then no additional separating '/' is needed
-    const char * fmt = (strlen(node_namespace) == 1) ? "%s%s" : "%s/%s";
-    local_output = rcutils_format_string(
-      allocator, fmt, node_namespace, (local_output) ? local_output : input_topic_name);
-    if (original_local_output) {
-      allocator.deallocate(original_local_output, allocator.state);
-    }
-    if (!local_output) {
+  char * local_output = allocator.allocate(length + 1u, allocator.state);
+  if (!local_output) {
+    *output_topic_name = NULL;
+    RCL_SET_ERROR_MSG("failed to allocate memory for output topic");
+    return RCL_RET_BAD_ALLOC;
+  }
+  if (length < sizeof(buffer)) {
+    memcpy(local_output, buffer, length + 1u);
+  } else {
+    // too long for the stack buffer, expand again now that the length is known
+    ret = _expand_topic_name(
+      input_topic_name, node_name, node_namespace, substitutions,
+      local_output, length + 1u, &length);
+    if (ret != RCL_RET_OK) {
+      allocator.deallocate(local_output, allocator.state);
       *output_topic_name = NULL;
-      RCL_SET_ERROR_MSG("failed to allocate memory for output topic");
-      return RCL_RET_BAD_ALLOC;
+      return ret;
     }
   }
   // finally store the result in the out pointer and return
@@ -218,6 +255,49 @@ rcl_expand_topic_name(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_expand_topic_name_to_buffer(
+  const char * input_topic_name,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions,
+  char * output_buffer,
+  size_t output_buffer_size,
+  size_t * output_length)
+{
+  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_INVALID_ARGUMENT);
+  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_TOPIC_NAME_INVALID);
+  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_NODE_INVALID_NAME);
+  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_NODE_INVALID_NAMESPACE);
+  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_UNKNOWN_SUBSTITUTION);
+
+  if (output_buffer_size > 0u) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(output_buffer, RCL_RET_INVALID_ARGUMENT);
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(output_length, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = _validate_expand_arguments(
+    input_topic_name, node_name, node_namespace, substitutions);
+  if (ret != RCL_RET_OK) {
+    return ret;
+  }
+  ret = _expand_topic_name(
+    input_topic_name, node_name, node_namespace, substitutions,
+    output_buffer, output_buffer_size, output_length);
+  if (ret != RCL_RET_OK) {
+    return ret;
+  }
+  if (*output_length >= output_buffer_size) {
+    if (output_buffer_size > 0u) {
+      output_buffer[0] = '\0';
+    }
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "expanded topic name needs %zu bytes, the buffer has %zu",
+      *output_length + 1u, output_buffer_size);
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_get_default_topic_name_substitutions(rcutils_string_map_t * string_map)
 {
@@ -19,6 +19,9 @@ extern "C"
 
 #include "rcl/graph.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "rcl/error_handling.h"
 #include "rcl/guard_condition.h"
 #include "rcl/wait.h"
@@ -38,7 +41,12 @@ extern "C"
 #include "rmw/validate_namespace.h"
 #include "rmw/validate_node_name.h"
 
+#include "./client_impl.h"
 #include "./common.h"
+#include "./context_impl.h"
+#include "./graph_cache.h"
+#include "./graph_change_log.h"
+#include "./guard_condition_impl.h"
 
 rcl_ret_t
 __validate_node_name_and_namespace(
@@ -253,6 +261,15 @@ rcl_get_topic_names_and_types(
   if (rmw_ret != RMW_RET_OK) {
     return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
   }
+  rcl_graph_cache_t * graph_cache = &node->context->impl->graph_cache;
+  rcl_graph_cache_names_and_types_kind_t kind =
+    no_demangle ? RCL_GRAPH_CACHE_TOPICS_NO_DEMANGLE : RCL_GRAPH_CACHE_TOPICS;
+  uint64_t graph_version;
+  if (rcl_graph_cache_get_names_and_types(
+      graph_cache, kind, allocator, topic_names_and_types, &graph_version))
+  {
+    return RCL_RET_OK;
+  }
   rcutils_allocator_t rcutils_allocator = *allocator;
   rmw_ret = rmw_get_topic_names_and_types(
     rcl_node_get_rmw_handle(node),
@@ -260,9 +277,62 @@ rcl_get_topic_names_and_types(
     no_demangle,
     topic_names_and_types
   );
+  if (RMW_RET_OK == rmw_ret) {
+    rcl_graph_cache_put_names_and_types(graph_cache, kind, graph_version, topic_names_and_types);
+  }
   return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
 }
 
+rcl_ret_t
+rcl_get_topic_names_and_types_arena(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  bool no_demangle,
+  const char * name_suffix,
+  const char * type_suffix,
+  rcl_names_and_types_arena_t * arena)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(arena, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != arena->block || 0u != arena->names_and_types.names.size) {
+    RCL_SET_ERROR_MSG("arena is not zero initialized");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_graph_cache_t * graph_cache = &node->context->impl->graph_cache;
+  rcl_graph_cache_names_and_types_kind_t kind =
+    no_demangle ? RCL_GRAPH_CACHE_TOPICS_NO_DEMANGLE : RCL_GRAPH_CACHE_TOPICS;
+  uint64_t graph_version;
+  if (rcl_graph_cache_get_names_and_types_arena(
+      graph_cache, kind, name_suffix, type_suffix, allocator, arena, &graph_version))
+  {
+    return RCL_RET_OK;
+  }
+  // The middleware fills a regular list, which is packed and released right away
+  rcl_names_and_types_t topic_names_and_types = rcl_get_zero_initialized_names_and_types();
+  rcutils_allocator_t rcutils_allocator = *allocator;
+  rmw_ret_t rmw_ret = rmw_get_topic_names_and_types(
+    rcl_node_get_rmw_handle(node), &rcutils_allocator, no_demangle, &topic_names_and_types);
+  if (RMW_RET_OK != rmw_ret) {
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  rcl_graph_cache_put_names_and_types(graph_cache, kind, graph_version, &topic_names_and_types);
+  rcl_ret_t ret = rcl_names_and_types_arena_copy(
+    &topic_names_and_types, name_suffix, type_suffix, allocator, arena);
+  rmw_ret = rmw_names_and_types_fini(&topic_names_and_types);
+  if (RMW_RET_OK != rmw_ret) {
+    if (RCL_RET_OK == ret) {
+      ret = rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+      (void)rcl_names_and_types_arena_fini(arena);
+    } else {
+      rmw_reset_error();
+    }
+  }
+  return ret;
+}
+
 rcl_ret_t
 rcl_get_service_names_and_types(
   const rcl_node_t * node,
@@ -279,12 +349,23 @@ rcl_get_service_names_and_types(
   if (rmw_ret != RMW_RET_OK) {
     return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
   }
+  rcl_graph_cache_t * graph_cache = &node->context->impl->graph_cache;
+  uint64_t graph_version;
+  if (rcl_graph_cache_get_names_and_types(
+      graph_cache, RCL_GRAPH_CACHE_SERVICES, allocator, service_names_and_types, &graph_version))
+  {
+    return RCL_RET_OK;
+  }
   rcutils_allocator_t rcutils_allocator = *allocator;
   rmw_ret = rmw_get_service_names_and_types(
     rcl_node_get_rmw_handle(node),
     &rcutils_allocator,
     service_names_and_types
   );
+  if (RMW_RET_OK == rmw_ret) {
+    rcl_graph_cache_put_names_and_types(
+      graph_cache, RCL_GRAPH_CACHE_SERVICES, graph_version, service_names_and_types);
+  }
   return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
 }
 
@@ -340,7 +421,13 @@ rcl_get_node_names(
     RCL_SET_ERROR_MSG("node_namespaces is not null");
     return RCL_RET_INVALID_ARGUMENT;
   }
-  (void)allocator;  // to be used in rmw_get_node_names in the future
+  rcl_graph_cache_t * graph_cache = &node->context->impl->graph_cache;
+  uint64_t graph_version;
+  if (rcl_graph_cache_get_node_names(
+      graph_cache, &allocator, node_names, node_namespaces, &graph_version))
+  {
+    return RCL_RET_OK;
+  }
   rmw_ret_t rmw_ret = rmw_get_node_names(
     rcl_node_get_rmw_handle(node),
     node_names,
@@ -368,6 +455,7 @@ rcl_get_node_names(
       return RCL_RET_NODE_INVALID_NAMESPACE;
     }
   }
+  rcl_graph_cache_put_node_names(graph_cache, graph_version, node_names, node_namespaces);
   return RCL_RET_OK;
 }
 
@@ -433,7 +521,18 @@ rcl_count_publishers(
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(topic_name, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(count, RCL_RET_INVALID_ARGUMENT);
+  rcl_graph_cache_t * graph_cache = &node->context->impl->graph_cache;
+  uint64_t graph_version;
+  if (rcl_graph_cache_get_count(
+      graph_cache, RCL_GRAPH_CACHE_PUBLISHERS, topic_name, count, &graph_version))
+  {
+    return RCL_RET_OK;
+  }
   rmw_ret_t rmw_ret = rmw_count_publishers(rcl_node_get_rmw_handle(node), topic_name, count);
+  if (RMW_RET_OK == rmw_ret) {
+    rcl_graph_cache_put_count(
+      graph_cache, RCL_GRAPH_CACHE_PUBLISHERS, topic_name, graph_version, *count);
+  }
   return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
 }
 
@@ -452,46 +551,143 @@ rcl_count_subscribers(
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(topic_name, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(count, RCL_RET_INVALID_ARGUMENT);
+  rcl_graph_cache_t * graph_cache = &node->context->impl->graph_cache;
+  uint64_t graph_version;
+  if (rcl_graph_cache_get_count(
+      graph_cache, RCL_GRAPH_CACHE_SUBSCRIBERS, topic_name, count, &graph_version))
+  {
+    return RCL_RET_OK;
+  }
   rmw_ret_t rmw_ret = rmw_count_subscribers(rcl_node_get_rmw_handle(node), topic_name, count);
+  if (RMW_RET_OK == rmw_ret) {
+    rcl_graph_cache_put_count(
+      graph_cache, RCL_GRAPH_CACHE_SUBSCRIBERS, topic_name, graph_version, *count);
+  }
   return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
 }
 
-typedef rcl_ret_t (* count_entities_func_t)(
-  const rcl_node_t * node,
-  const char * topic_name,
-  size_t * count);
+rcl_ret_t
+rcl_context_configure_graph_cache(rcl_context_t * context, bool enable)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context->impl, "context is not initialized", return RCL_RET_INVALID_ARGUMENT);
+  rcl_graph_cache_set_enabled(&context->impl->graph_cache, enable);
+  return RCL_RET_OK;
+}
 
 rcl_ret_t
-_rcl_wait_for_entities(
+rcl_context_get_graph_version(const rcl_context_t * context, uint64_t * version)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context->impl, "context is not initialized", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(version, RCL_RET_INVALID_ARGUMENT);
+  *version = rcl_graph_cache_get_version(&context->impl->graph_cache);
+  return RCL_RET_OK;
+}
+
+// Bring the snapshot of an acquired change log up to date with the graph version.
+static
+rcl_ret_t
+_rcl_graph_change_log_sync(const rcl_node_t * node, rcl_graph_change_log_t * log)
+{
+  // Read the version first, so a change racing with the snapshot triggers another one later
+  uint64_t graph_version = rcl_graph_cache_get_version(&node->context->impl->graph_cache);
+  if (log->has_snapshot && log->snapshot_graph_version == graph_version) {
+    return RCL_RET_OK;
+  }
+  return rcl_graph_change_log_refresh(log, rcl_node_get_rmw_handle(node), graph_version);
+}
+
+rcl_graph_change_array_t
+rcl_get_zero_initialized_graph_change_array(void)
+{
+  rcl_graph_change_array_t zero_array = {
+    .data = NULL,
+    .size = 0u,
+    .is_full_snapshot = false,
+    .allocator = rcutils_get_zero_initialized_allocator(),
+  };
+  return zero_array;
+}
+
+rcl_ret_t
+rcl_graph_change_array_fini(rcl_graph_change_array_t * changes)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(changes, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != changes->data) {
+    RCL_CHECK_ALLOCATOR_WITH_MSG(
+      &changes->allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+    for (size_t i = 0u; i < changes->size; ++i) {
+      rcl_graph_change_fini(&changes->data[i], &changes->allocator);
+    }
+    changes->allocator.deallocate(changes->data, changes->allocator.state);
+  }
+  *changes = rcl_get_zero_initialized_graph_change_array();
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_get_graph_changes(
   const rcl_node_t * node,
   rcl_allocator_t * allocator,
-  const char * topic_name,
-  const size_t expected_count,
-  rcutils_duration_value_t timeout,
-  bool * success,
-  count_entities_func_t count_entities_func)
+  uint64_t since_version,
+  rcl_graph_change_array_t * changes,
+  uint64_t * latest_version)
 {
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCL_RET_NODE_INVALID);
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCL_RET_INVALID_ARGUMENT);
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCL_RET_BAD_ALLOC);
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCL_RET_ERROR);
+
   if (!rcl_node_is_valid(node)) {
-    return RCL_RET_NODE_INVALID;
+    return RCL_RET_NODE_INVALID;  // error already set
   }
   RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(topic_name, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(success, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(changes, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != changes->data || 0u != changes->size) {
+    RCL_SET_ERROR_MSG("changes is not zero initialized");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(latest_version, RCL_RET_INVALID_ARGUMENT);
 
+  rcl_graph_change_log_t * log = &node->context->impl->graph_change_log;
+  rcl_graph_change_log_lock(log);
+  rcl_ret_t ret = _rcl_graph_change_log_sync(node, log);
+  if (RCL_RET_OK == ret) {
+    ret = rcl_graph_change_log_get_changes(
+      log, since_version, allocator, changes, latest_version);
+  }
+  rcl_graph_change_log_release(log);
+  return ret;
+}
+
+// Check whether the graph is in the state being waited for.
+typedef rcl_ret_t (* graph_condition_func_t)(
+  const rcl_node_t * node,
+  const void * arg,
+  bool * is_satisfied);
+
+static
+rcl_ret_t
+_rcl_wait_for_graph_condition(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  rcutils_duration_value_t timeout,
+  bool * success,
+  graph_condition_func_t condition_func,
+  const void * arg)
+{
   rcl_ret_t ret = RCL_RET_OK;
   *success = false;
 
-  // We can avoid waiting if there are already the expected number of entities
-  size_t count = 0u;
-  ret = count_entities_func(node, topic_name, &count);
-  if (ret != RCL_RET_OK) {
-    // Error message already set
+  // We can avoid waiting if the graph is already in the expected state
+  ret = condition_func(node, arg, success);
+  if (ret != RCL_RET_OK || *success) {
+    // Error message already set, if any
     return ret;
   }
-  if (expected_count <= count) {
-    *success = true;
-    return RCL_RET_OK;
-  }
 
   // Create a wait set and add the node graph guard condition to it
   rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
@@ -539,14 +735,10 @@ _rcl_wait_for_entities(
       break;
     }
 
-    // Check count
-    ret = count_entities_func(node, topic_name, &count);
-    if (ret != RCL_RET_OK) {
-      // Error already set
-      break;
-    }
-    if (expected_count <= count) {
-      *success = true;
+    // Check the graph again
+    ret = condition_func(node, arg, success);
+    if (ret != RCL_RET_OK || *success) {
+      // Error already set, if any
       break;
     }
 
@@ -591,6 +783,59 @@ cleanup:
   return ret;
 }
 
+typedef rcl_ret_t (* count_entities_func_t)(
+  const rcl_node_t * node,
+  const char * topic_name,
+  size_t * count);
+
+typedef struct rcl_entity_count_condition_s
+{
+  const char * topic_name;
+  size_t expected_count;
+  count_entities_func_t count_entities_func;
+} rcl_entity_count_condition_t;
+
+static
+rcl_ret_t
+_rcl_entity_count_reached(const rcl_node_t * node, const void * arg, bool * is_satisfied)
+{
+  const rcl_entity_count_condition_t * condition = (const rcl_entity_count_condition_t *)arg;
+  size_t count = 0u;
+  rcl_ret_t ret = condition->count_entities_func(node, condition->topic_name, &count);
+  if (ret != RCL_RET_OK) {
+    // Error message already set
+    return ret;
+  }
+  *is_satisfied = condition->expected_count <= count;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+_rcl_wait_for_entities(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  const char * topic_name,
+  const size_t expected_count,
+  rcutils_duration_value_t timeout,
+  bool * success,
+  count_entities_func_t count_entities_func)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;
+  }
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(success, RCL_RET_INVALID_ARGUMENT);
+
+  rcl_entity_count_condition_t condition = {
+    .topic_name = topic_name,
+    .expected_count = expected_count,
+    .count_entities_func = count_entities_func,
+  };
+  return _rcl_wait_for_graph_condition(
+    node, allocator, timeout, success, _rcl_entity_count_reached, &condition);
+}
+
 rcl_ret_t
 rcl_wait_for_publishers(
   const rcl_node_t * node,
@@ -629,6 +874,164 @@ rcl_wait_for_subscribers(
     rcl_count_subscribers);
 }
 
+typedef struct rcl_topic_endpoint_conditions_s
+{
+  rcl_topic_endpoint_condition_t * conditions;
+  size_t condition_count;
+  // The conditions sorted by topic name
+  rcl_topic_endpoint_condition_t ** order;
+  // Endpoints counted for each condition
+  size_t * counts;
+} rcl_topic_endpoint_conditions_t;
+
+static
+int
+_rcl_compare_condition_topic_names(const void * lhs, const void * rhs)
+{
+  return strcmp(
+    (*(rcl_topic_endpoint_condition_t * const *)lhs)->topic_name,
+    (*(rcl_topic_endpoint_condition_t * const *)rhs)->topic_name);
+}
+
+// Count the endpoints of every condition in a single pass over the graph snapshot.
+static
+void
+_rcl_count_topic_endpoints_in_snapshot(
+  const rcl_graph_change_log_t * log,
+  const rcl_topic_endpoint_conditions_t * conditions)
+{
+  memset(conditions->counts, 0, conditions->condition_count * sizeof(size_t));
+  for (size_t i = 0u; i < log->endpoint_count; ++i) {
+    const rcl_graph_change_t * endpoint = &log->endpoints[i];
+    // Find the first condition on the topic of the endpoint
+    size_t low = 0u;
+    size_t high = conditions->condition_count;
+    while (low < high) {
+      size_t middle = low + (high - low) / 2u;
+      if (strcmp(conditions->order[middle]->topic_name, endpoint->topic_name) < 0) {
+        low = middle + 1u;
+      } else {
+        high = middle;
+      }
+    }
+    for (; low < conditions->condition_count; ++low) {
+      const rcl_topic_endpoint_condition_t * condition = conditions->order[low];
+      if (0 != strcmp(condition->topic_name, endpoint->topic_name)) {
+        break;
+      }
+      if (condition->endpoint_type == endpoint->endpoint_type) {
+        ++conditions->counts[condition - conditions->conditions];
+      }
+    }
+  }
+}
+
+static
+rcl_ret_t
+_rcl_topic_endpoint_conditions_met(const rcl_node_t * node, const void * arg, bool * is_satisfied)
+{
+  const rcl_topic_endpoint_conditions_t * conditions = (const rcl_topic_endpoint_conditions_t *)arg;
+  rcl_ret_t ret = RCL_RET_OK;
+  rcl_graph_change_log_t * log = &node->context->impl->graph_change_log;
+  bool from_snapshot = rcl_graph_change_log_acquire(log);
+  if (from_snapshot) {
+    ret = _rcl_graph_change_log_sync(node, log);
+    if (RCL_RET_OK == ret) {
+      _rcl_count_topic_endpoints_in_snapshot(log, conditions);
+    }
+    rcl_graph_change_log_release(log);
+    if (RCL_RET_OK != ret) {
+      // Error message already set
+      return ret;
+    }
+  }
+
+  *is_satisfied = true;
+  for (size_t i = 0u; i < conditions->condition_count; ++i) {
+    rcl_topic_endpoint_condition_t * condition = &conditions->conditions[i];
+    if (condition->is_satisfied) {
+      continue;
+    }
+    if (!from_snapshot) {
+      // Someone else holds the snapshot, ask the middleware instead of waiting for it
+      ret = RMW_ENDPOINT_PUBLISHER == condition->endpoint_type ?
+        rcl_count_publishers(node, condition->topic_name, &conditions->counts[i]) :
+        rcl_count_subscribers(node, condition->topic_name, &conditions->counts[i]);
+      if (RCL_RET_OK != ret) {
+        // Error message already set
+        return ret;
+      }
+    }
+    condition->is_satisfied = condition->expected_count <= conditions->counts[i];
+    *is_satisfied = *is_satisfied && condition->is_satisfied;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_for_topic_endpoints(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  rcl_topic_endpoint_condition_t * conditions,
+  size_t condition_count,
+  rcutils_duration_value_t timeout,
+  bool * success)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;
+  }
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(conditions, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(success, RCL_RET_INVALID_ARGUMENT);
+  if (0u == condition_count) {
+    RCL_SET_ERROR_MSG("condition_count must be greater than zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  for (size_t i = 0u; i < condition_count; ++i) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(conditions[i].topic_name, RCL_RET_INVALID_ARGUMENT);
+    if (RMW_ENDPOINT_PUBLISHER != conditions[i].endpoint_type &&
+      RMW_ENDPOINT_SUBSCRIPTION != conditions[i].endpoint_type)
+    {
+      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "endpoint type of condition %zu must be a publisher or a subscription", i);
+      return RCL_RET_INVALID_ARGUMENT;
+    }
+    conditions[i].is_satisfied = false;
+  }
+
+  rcl_topic_endpoint_conditions_t arg = {
+    .conditions = conditions,
+    .condition_count = condition_count,
+    .order = allocator->allocate(
+      condition_count * sizeof(rcl_topic_endpoint_condition_t *), allocator->state),
+    .counts = allocator->zero_allocate(condition_count, sizeof(size_t), allocator->state),
+  };
+  rcl_ret_t ret = RCL_RET_OK;
+  if (NULL == arg.order || NULL == arg.counts) {
+    RCL_SET_ERROR_MSG("allocating memory for topic endpoint conditions failed");
+    ret = RCL_RET_BAD_ALLOC;
+    goto cleanup;
+  }
+  for (size_t i = 0u; i < condition_count; ++i) {
+    arg.order[i] = &conditions[i];
+  }
+  qsort(
+    arg.order, condition_count, sizeof(rcl_topic_endpoint_condition_t *),
+    _rcl_compare_condition_topic_names);
+
+  ret = _rcl_wait_for_graph_condition(
+    node, allocator, timeout, success, _rcl_topic_endpoint_conditions_met, &arg);
+
+cleanup:
+  if (NULL != arg.order) {
+    allocator->deallocate(arg.order, allocator->state);
+  }
+  if (NULL != arg.counts) {
+    allocator->deallocate(arg.counts, allocator->state);
+  }
+  return ret;
+}
+
 typedef rmw_ret_t (* get_topic_endpoint_info_func_t)(
   const rmw_node_t * node,
   rcutils_allocator_t * allocator,
@@ -731,14 +1134,66 @@ rcl_service_server_is_available(
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(client, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(is_available, RCL_RET_INVALID_ARGUMENT);
+
+  // The cache is only used with the node it was configured for.
+  const rcl_guard_condition_t * graph_guard_condition = NULL;
+  uint64_t graph_version = 0u;
+  if (NULL != client->impl &&
+    NULL != client->impl->availability_cache_guard_condition &&
+    rcl_node_get_graph_guard_condition(node) == client->impl->availability_cache_guard_condition)
+  {
+    graph_guard_condition = client->impl->availability_cache_guard_condition;
+    // Read the version before asking the middleware, so a graph change which
+    // races with the query invalidates the answer instead of being missed.
+    graph_version = rcutils_atomic_load_uint64_t(&graph_guard_condition->impl->trigger_count);
+    uint64_t cached = rcutils_atomic_load_uint64_t(&client->impl->availability_cache);
+    if ((cached >> 1) == graph_version + 1u) {
+      *is_available = (cached & 1u) != 0u;
+      return RCL_RET_OK;
+    }
+  }
+
   rmw_ret_t rmw_ret = rmw_service_server_is_available(
     rcl_node_get_rmw_handle(node),
     rcl_client_get_rmw_handle(client),
     is_available
   );
+  if (RMW_RET_OK == rmw_ret && NULL != graph_guard_condition) {
+    rcutils_atomic_store(
+      &client->impl->availability_cache,
+      ((graph_version + 1u) << 1) | (*is_available ? 1u : 0u));
+  }
   return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
 }
 
+static
+rcl_ret_t
+_rcl_service_server_available(const rcl_node_t * node, const void * arg, bool * is_satisfied)
+{
+  return rcl_service_server_is_available(node, (const rcl_client_t *)arg, is_satisfied);
+}
+
+rcl_ret_t
+rcl_wait_for_service_server(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  const rcl_client_t * client,
+  rcutils_duration_value_t timeout,
+  bool * success)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(success, RCL_RET_INVALID_ARGUMENT);
+
+  return _rcl_wait_for_graph_condition(
+    node, allocator, timeout, success, _rcl_service_server_available, client);
+}
+
 #ifdef __cplusplus
 }
 #endif
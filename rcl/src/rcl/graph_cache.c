@@ -0,0 +1,358 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./graph_cache.h"
+
+#include <string.h>
+
+#include "rcutils/error_handling.h"
+#include "rcutils/strdup.h"
+#include "rmw/error_handling.h"
+
+void
+rcl_graph_cache_init(rcl_graph_cache_t * cache, rcl_allocator_t allocator)
+{
+  atomic_init(&cache->version, 0);
+  atomic_init(&cache->enabled, false);
+  atomic_init(&cache->busy, false);
+  cache->allocator = allocator;
+  for (size_t i = 0u; i < RCL_GRAPH_CACHE_NAMES_AND_TYPES_KIND_COUNT; ++i) {
+    cache->names_and_types[i] = rmw_get_zero_initialized_names_and_types();
+    cache->names_and_types_tag[i] = 0u;
+  }
+  cache->node_names = rcutils_get_zero_initialized_string_array();
+  cache->node_namespaces = rcutils_get_zero_initialized_string_array();
+  cache->node_names_tag = 0u;
+  memset(cache->count_slots, 0, sizeof(cache->count_slots));
+}
+
+static
+void
+_clear_names_and_types(rmw_names_and_types_t * names_and_types)
+{
+  if (NULL != names_and_types->names.data) {
+    if (RMW_RET_OK != rmw_names_and_types_fini(names_and_types)) {
+      rmw_reset_error();
+    }
+  }
+  *names_and_types = rmw_get_zero_initialized_names_and_types();
+}
+
+static
+void
+_clear_string_array(rcutils_string_array_t * string_array)
+{
+  if (NULL != string_array->data) {
+    if (RCUTILS_RET_OK != rcutils_string_array_fini(string_array)) {
+      rcutils_reset_error();
+    }
+  }
+  *string_array = rcutils_get_zero_initialized_string_array();
+}
+
+void
+rcl_graph_cache_fini(rcl_graph_cache_t * cache)
+{
+  for (size_t i = 0u; i < RCL_GRAPH_CACHE_NAMES_AND_TYPES_KIND_COUNT; ++i) {
+    _clear_names_and_types(&cache->names_and_types[i]);
+    cache->names_and_types_tag[i] = 0u;
+  }
+  _clear_string_array(&cache->node_names);
+  _clear_string_array(&cache->node_namespaces);
+  cache->node_names_tag = 0u;
+  for (size_t i = 0u; i < RCL_GRAPH_CACHE_COUNT_SLOTS; ++i) {
+    if (NULL != cache->count_slots[i].topic_name) {
+      cache->allocator.deallocate(cache->count_slots[i].topic_name, cache->allocator.state);
+    }
+  }
+  memset(cache->count_slots, 0, sizeof(cache->count_slots));
+}
+
+void
+rcl_graph_cache_set_enabled(rcl_graph_cache_t * cache, bool enabled)
+{
+  // Moving the version invalidates every entry without having to touch them,
+  // their memory is reused by later stores or released by rcl_graph_cache_fini().
+  rcutils_atomic_fetch_add_uint64_t(&cache->version, 1u);
+  rcutils_atomic_store(&cache->enabled, enabled);
+}
+
+uint64_t
+rcl_graph_cache_get_version(const rcl_graph_cache_t * cache)
+{
+  return rcutils_atomic_load_uint64_t((atomic_uint_least64_t *)&cache->version);
+}
+
+static
+bool
+_acquire(rcl_graph_cache_t * cache, uint64_t * version)
+{
+  *version = rcutils_atomic_load_uint64_t(&cache->version);
+  if (!rcutils_atomic_load_bool(&cache->enabled)) {
+    return false;
+  }
+  return !rcutils_atomic_exchange_bool(&cache->busy, true);
+}
+
+static
+void
+_release(rcl_graph_cache_t * cache)
+{
+  rcutils_atomic_store(&cache->busy, false);
+}
+
+static
+bool
+_copy_string_array(
+  const rcutils_string_array_t * src,
+  rcutils_string_array_t * dst,
+  rcl_allocator_t * allocator)
+{
+  if (0u == src->size) {
+    *dst = rcutils_get_zero_initialized_string_array();
+    return true;
+  }
+  if (RCUTILS_RET_OK != rcutils_string_array_init(dst, src->size, allocator)) {
+    rcutils_reset_error();
+    return false;
+  }
+  for (size_t i = 0u; i < src->size; ++i) {
+    if (NULL == src->data[i]) {
+      continue;
+    }
+    dst->data[i] = rcutils_strdup(src->data[i], *allocator);
+    if (NULL == dst->data[i]) {
+      _clear_string_array(dst);
+      return false;
+    }
+  }
+  return true;
+}
+
+static
+bool
+_copy_names_and_types(
+  const rmw_names_and_types_t * src,
+  rmw_names_and_types_t * dst,
+  rcl_allocator_t * allocator)
+{
+  if (0u == src->names.size) {
+    *dst = rmw_get_zero_initialized_names_and_types();
+    return true;
+  }
+  if (RMW_RET_OK != rmw_names_and_types_init(dst, src->names.size, allocator)) {
+    rmw_reset_error();
+    return false;
+  }
+  for (size_t i = 0u; i < src->names.size; ++i) {
+    dst->names.data[i] = rcutils_strdup(src->names.data[i], *allocator);
+    if (NULL == dst->names.data[i] ||
+      !_copy_string_array(&src->types[i], &dst->types[i], allocator))
+    {
+      _clear_names_and_types(dst);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+rcl_graph_cache_get_names_and_types(
+  rcl_graph_cache_t * cache,
+  rcl_graph_cache_names_and_types_kind_t kind,
+  rcl_allocator_t * allocator,
+  rmw_names_and_types_t * names_and_types,
+  uint64_t * version)
+{
+  if (!_acquire(cache, version)) {
+    return false;
+  }
+  bool hit = cache->names_and_types_tag[kind] == *version + 1u &&
+    _copy_names_and_types(&cache->names_and_types[kind], names_and_types, allocator);
+  _release(cache);
+  return hit;
+}
+
+bool
+rcl_graph_cache_get_names_and_types_arena(
+  rcl_graph_cache_t * cache,
+  rcl_graph_cache_names_and_types_kind_t kind,
+  const char * name_suffix,
+  const char * type_suffix,
+  rcl_allocator_t * allocator,
+  rcl_names_and_types_arena_t * arena,
+  uint64_t * version)
+{
+  if (!_acquire(cache, version)) {
+    return false;
+  }
+  bool hit = false;
+  if (cache->names_and_types_tag[kind] == *version + 1u) {
+    hit = RCL_RET_OK == rcl_names_and_types_arena_copy(
+      &cache->names_and_types[kind], name_suffix, type_suffix, allocator, arena);
+    if (!hit) {
+      rcutils_reset_error();
+    }
+  }
+  _release(cache);
+  return hit;
+}
+
+void
+rcl_graph_cache_put_names_and_types(
+  rcl_graph_cache_t * cache,
+  rcl_graph_cache_names_and_types_kind_t kind,
+  uint64_t version,
+  const rmw_names_and_types_t * names_and_types)
+{
+  uint64_t current_version;
+  if (!_acquire(cache, &current_version)) {
+    return;
+  }
+  // Do not bother storing an answer which is already outdated
+  if (current_version == version) {
+    _clear_names_and_types(&cache->names_and_types[kind]);
+    cache->names_and_types_tag[kind] = 0u;
+    if (_copy_names_and_types(
+        names_and_types, &cache->names_and_types[kind], &cache->allocator))
+    {
+      cache->names_and_types_tag[kind] = version + 1u;
+    }
+  }
+  _release(cache);
+}
+
+bool
+rcl_graph_cache_get_node_names(
+  rcl_graph_cache_t * cache,
+  rcl_allocator_t * allocator,
+  rcutils_string_array_t * node_names,
+  rcutils_string_array_t * node_namespaces,
+  uint64_t * version)
+{
+  if (!_acquire(cache, version)) {
+    return false;
+  }
+  bool hit = false;
+  if (cache->node_names_tag == *version + 1u &&
+    _copy_string_array(&cache->node_names, node_names, allocator))
+  {
+    hit = _copy_string_array(&cache->node_namespaces, node_namespaces, allocator);
+    if (!hit) {
+      _clear_string_array(node_names);
+    }
+  }
+  _release(cache);
+  return hit;
+}
+
+void
+rcl_graph_cache_put_node_names(
+  rcl_graph_cache_t * cache,
+  uint64_t version,
+  const rcutils_string_array_t * node_names,
+  const rcutils_string_array_t * node_namespaces)
+{
+  uint64_t current_version;
+  if (!_acquire(cache, &current_version)) {
+    return;
+  }
+  if (current_version == version) {
+    _clear_string_array(&cache->node_names);
+    _clear_string_array(&cache->node_namespaces);
+    cache->node_names_tag = 0u;
+    if (_copy_string_array(node_names, &cache->node_names, &cache->allocator) &&
+      _copy_string_array(node_namespaces, &cache->node_namespaces, &cache->allocator))
+    {
+      cache->node_names_tag = version + 1u;
+    }
+  }
+  _release(cache);
+}
+
+static
+size_t
+_count_slot_index(const char * topic_name)
+{
+  // FNV-1a
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const unsigned char * c = (const unsigned char *)topic_name; *c != '\0'; ++c) {
+    hash = (hash ^ *c) * 0x100000001b3ULL;
+  }
+  return (size_t)(hash % RCL_GRAPH_CACHE_COUNT_SLOTS);
+}
+
+bool
+rcl_graph_cache_get_count(
+  rcl_graph_cache_t * cache,
+  rcl_graph_cache_endpoint_kind_t kind,
+  const char * topic_name,
+  size_t * count,
+  uint64_t * version)
+{
+  if (!_acquire(cache, version)) {
+    return false;
+  }
+  const rcl_graph_cache_count_slot_t * slot = &cache->count_slots[_count_slot_index(topic_name)];
+  bool hit = NULL != slot->topic_name &&
+    slot->tag[kind] == *version + 1u &&
+    0 == strcmp(slot->topic_name, topic_name);
+  if (hit) {
+    *count = slot->count[kind];
+  }
+  _release(cache);
+  return hit;
+}
+
+void
+rcl_graph_cache_put_count(
+  rcl_graph_cache_t * cache,
+  rcl_graph_cache_endpoint_kind_t kind,
+  const char * topic_name,
+  uint64_t version,
+  size_t count)
+{
+  uint64_t current_version;
+  if (!_acquire(cache, &current_version)) {
+    return;
+  }
+  rcl_graph_cache_count_slot_t * slot = &cache->count_slots[_count_slot_index(topic_name)];
+  if (current_version == version) {
+    // Topics sharing a slot evict each other
+    if (NULL == slot->topic_name || 0 != strcmp(slot->topic_name, topic_name)) {
+      char * topic_name_copy = rcutils_strdup(topic_name, cache->allocator);
+      if (NULL != topic_name_copy) {
+        if (NULL != slot->topic_name) {
+          cache->allocator.deallocate(slot->topic_name, cache->allocator.state);
+        }
+        memset(slot, 0, sizeof(*slot));
+        slot->topic_name = topic_name_copy;
+      }
+    }
+    if (NULL != slot->topic_name && 0 == strcmp(slot->topic_name, topic_name)) {
+      slot->count[kind] = count;
+      slot->tag[kind] = version + 1u;
+    }
+  }
+  _release(cache);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,191 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__GRAPH_CACHE_H_
+#define RCL__GRAPH_CACHE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcutils/stdatomic_helper.h"
+#include "rcutils/types/string_array.h"
+#include "rmw/names_and_types.h"
+
+#include "rcl/allocator.h"
+#include "rcl/graph.h"
+
+/// Number of topics whose publisher and subscriber counts are cached at once.
+#define RCL_GRAPH_CACHE_COUNT_SLOTS 64
+
+/// Kinds of names and types lists kept by the graph cache.
+typedef enum rcl_graph_cache_names_and_types_kind_e
+{
+  RCL_GRAPH_CACHE_TOPICS = 0,
+  RCL_GRAPH_CACHE_TOPICS_NO_DEMANGLE,
+  RCL_GRAPH_CACHE_SERVICES,
+  RCL_GRAPH_CACHE_NAMES_AND_TYPES_KIND_COUNT
+} rcl_graph_cache_names_and_types_kind_t;
+
+/// Kinds of endpoints counted by the graph cache.
+typedef enum rcl_graph_cache_endpoint_kind_e
+{
+  RCL_GRAPH_CACHE_PUBLISHERS = 0,
+  RCL_GRAPH_CACHE_SUBSCRIBERS,
+  RCL_GRAPH_CACHE_ENDPOINT_KIND_COUNT
+} rcl_graph_cache_endpoint_kind_t;
+
+/// Cached endpoint counts of a single topic.
+typedef struct rcl_graph_cache_count_slot_s
+{
+  /// Topic name owned by the cache, NULL if the slot is unused
+  char * topic_name;
+  /// Graph version plus one at which each count was taken, 0 if not cached
+  uint64_t tag[RCL_GRAPH_CACHE_ENDPOINT_KIND_COUNT];
+  /// Cached counts
+  size_t count[RCL_GRAPH_CACHE_ENDPOINT_KIND_COUNT];
+} rcl_graph_cache_count_slot_t;
+
+/// Per context cache of graph query results.
+/**
+ * Every entry is tagged with the graph version it was taken at, and is only
+ * handed out while the version is unchanged.
+ * The version is advanced whenever a graph guard condition of a node in the
+ * context is triggered, so entries go stale as soon as rcl sees the graph change.
+ *
+ * Entries are only touched by whoever holds the `busy` flag.
+ * A caller finding the cache busy queries the middleware instead of waiting,
+ * so the cache never blocks.
+ */
+typedef struct rcl_graph_cache_s
+{
+  /// Graph version of the context
+  atomic_uint_least64_t version;
+  /// Whether or not queries are answered from the cache
+  atomic_bool enabled;
+  /// Held while entries are read or written
+  atomic_bool busy;
+  /// Allocator for the cached entries
+  rcl_allocator_t allocator;
+  /// Cached names and types lists
+  rmw_names_and_types_t names_and_types[RCL_GRAPH_CACHE_NAMES_AND_TYPES_KIND_COUNT];
+  /// Graph version plus one of each names and types list, 0 if not cached
+  uint64_t names_and_types_tag[RCL_GRAPH_CACHE_NAMES_AND_TYPES_KIND_COUNT];
+  /// Cached node names
+  rcutils_string_array_t node_names;
+  /// Cached node namespaces
+  rcutils_string_array_t node_namespaces;
+  /// Graph version plus one of the node names, 0 if not cached
+  uint64_t node_names_tag;
+  /// Cached endpoint counts, indexed by a hash of the topic name
+  rcl_graph_cache_count_slot_t count_slots[RCL_GRAPH_CACHE_COUNT_SLOTS];
+} rcl_graph_cache_t;
+
+/// Initialize a zero initialized graph cache, disabled.
+void
+rcl_graph_cache_init(rcl_graph_cache_t * cache, rcl_allocator_t allocator);
+
+/// Release every cached entry.
+void
+rcl_graph_cache_fini(rcl_graph_cache_t * cache);
+
+/// Enable or disable the cache, invalidating any cached entry.
+void
+rcl_graph_cache_set_enabled(rcl_graph_cache_t * cache, bool enabled);
+
+/// Get the graph version of the cache.
+uint64_t
+rcl_graph_cache_get_version(const rcl_graph_cache_t * cache);
+
+/// Copy a cached names and types list into `names_and_types`.
+/**
+ * \param[inout] cache the graph cache
+ * \param[in] kind which list to look up
+ * \param[in] allocator used for the copy handed to the caller
+ * \param[out] names_and_types zero initialized, filled on a hit
+ * \param[out] version graph version to tag the answer of the middleware with on a miss
+ * \return `true` on a hit, `false` on a miss, leaving `names_and_types` untouched
+ */
+bool
+rcl_graph_cache_get_names_and_types(
+  rcl_graph_cache_t * cache,
+  rcl_graph_cache_names_and_types_kind_t kind,
+  rcl_allocator_t * allocator,
+  rmw_names_and_types_t * names_and_types,
+  uint64_t * version);
+
+/// Copy a cached names and types list into a single block, \see rcl_names_and_types_arena_copy.
+bool
+rcl_graph_cache_get_names_and_types_arena(
+  rcl_graph_cache_t * cache,
+  rcl_graph_cache_names_and_types_kind_t kind,
+  const char * name_suffix,
+  const char * type_suffix,
+  rcl_allocator_t * allocator,
+  rcl_names_and_types_arena_t * arena,
+  uint64_t * version);
+
+/// Store a copy of a names and types list taken at `version`, best effort.
+void
+rcl_graph_cache_put_names_and_types(
+  rcl_graph_cache_t * cache,
+  rcl_graph_cache_names_and_types_kind_t kind,
+  uint64_t version,
+  const rmw_names_and_types_t * names_and_types);
+
+/// Copy the cached node names and namespaces, \see rcl_graph_cache_get_names_and_types.
+bool
+rcl_graph_cache_get_node_names(
+  rcl_graph_cache_t * cache,
+  rcl_allocator_t * allocator,
+  rcutils_string_array_t * node_names,
+  rcutils_string_array_t * node_namespaces,
+  uint64_t * version);
+
+/// Store a copy of the node names and namespaces taken at `version`, best effort.
+void
+rcl_graph_cache_put_node_names(
+  rcl_graph_cache_t * cache,
+  uint64_t version,
+  const rcutils_string_array_t * node_names,
+  const rcutils_string_array_t * node_namespaces);
+
+/// Get the cached endpoint count of a topic, \see rcl_graph_cache_get_names_and_types.
+bool
+rcl_graph_cache_get_count(
+  rcl_graph_cache_t * cache,
+  rcl_graph_cache_endpoint_kind_t kind,
+  const char * topic_name,
+  size_t * count,
+  uint64_t * version);
+
+/// Store the endpoint count of a topic taken at `version`, best effort.
+void
+rcl_graph_cache_put_count(
+  rcl_graph_cache_t * cache,
+  rcl_graph_cache_endpoint_kind_t kind,
+  const char * topic_name,
+  uint64_t version,
+  size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__GRAPH_CACHE_H_
@@ -0,0 +1,486 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./graph_change_log.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "rcl/error_handling.h"
+#include "rcutils/strdup.h"
+#include "rmw/error_handling.h"
+#include "rmw/get_topic_endpoint_info.h"
+#include "rmw/get_topic_names_and_types.h"
+#include "rmw/names_and_types.h"
+#include "rmw/topic_endpoint_info_array.h"
+
+#include "./common.h"
+
+// Changes found by a refresh, before they are committed to the ring buffer
+typedef struct rcl_graph_change_buffer_s
+{
+  rcl_graph_change_t * data;
+  size_t size;
+  size_t capacity;
+} rcl_graph_change_buffer_t;
+
+void
+rcl_graph_change_log_init(rcl_graph_change_log_t * log, rcl_allocator_t allocator)
+{
+  atomic_init(&log->busy, false);
+  log->allocator = allocator;
+  log->has_snapshot = false;
+  log->snapshot_graph_version = 0u;
+  log->nodes = NULL;
+  log->node_count = 0u;
+  log->endpoints = NULL;
+  log->endpoint_count = 0u;
+  log->changes = NULL;
+  log->changes_head = 0u;
+  log->changes_size = 0u;
+  log->latest_version = 0u;
+}
+
+void
+rcl_graph_change_fini(rcl_graph_change_t * change, rcl_allocator_t * allocator)
+{
+  char ** members[] = {
+    &change->node_name, &change->node_namespace, &change->topic_name, &change->topic_type};
+  for (size_t i = 0u; i < sizeof(members) / sizeof(members[0]); ++i) {
+    if (NULL != *members[i]) {
+      allocator->deallocate(*members[i], allocator->state);
+      *members[i] = NULL;
+    }
+  }
+}
+
+static
+bool
+_strdup_member(const char * src, char ** dst, rcl_allocator_t * allocator)
+{
+  if (NULL == src) {
+    *dst = NULL;
+    return true;
+  }
+  *dst = rcutils_strdup(src, *allocator);
+  return NULL != *dst;
+}
+
+static
+bool
+_copy_change(const rcl_graph_change_t * src, rcl_graph_change_t * dst, rcl_allocator_t * allocator)
+{
+  *dst = *src;
+  dst->node_name = NULL;
+  dst->node_namespace = NULL;
+  dst->topic_name = NULL;
+  dst->topic_type = NULL;
+  if (!_strdup_member(src->node_name, &dst->node_name, allocator) ||
+    !_strdup_member(src->node_namespace, &dst->node_namespace, allocator) ||
+    !_strdup_member(src->topic_name, &dst->topic_name, allocator) ||
+    !_strdup_member(src->topic_type, &dst->topic_type, allocator))
+  {
+    rcl_graph_change_fini(dst, allocator);
+    return false;
+  }
+  return true;
+}
+
+static
+void
+_free_changes(rcl_graph_change_t * changes, size_t count, rcl_allocator_t * allocator)
+{
+  if (NULL == changes) {
+    return;
+  }
+  for (size_t i = 0u; i < count; ++i) {
+    rcl_graph_change_fini(&changes[i], allocator);
+  }
+  allocator->deallocate(changes, allocator->state);
+}
+
+void
+rcl_graph_change_log_fini(rcl_graph_change_log_t * log)
+{
+  _free_changes(log->nodes, log->node_count, &log->allocator);
+  _free_changes(log->endpoints, log->endpoint_count, &log->allocator);
+  if (NULL != log->changes) {
+    for (size_t i = 0u; i < log->changes_size; ++i) {
+      rcl_graph_change_fini(
+        &log->changes[(log->changes_head + i) % RCL_GRAPH_CHANGE_LOG_CAPACITY], &log->allocator);
+    }
+    log->allocator.deallocate(log->changes, log->allocator.state);
+  }
+  rcl_graph_change_log_init(log, log->allocator);
+}
+
+bool
+rcl_graph_change_log_acquire(rcl_graph_change_log_t * log)
+{
+  return !rcutils_atomic_exchange_bool(&log->busy, true);
+}
+
+void
+rcl_graph_change_log_lock(rcl_graph_change_log_t * log)
+{
+  while (rcutils_atomic_exchange_bool(&log->busy, true)) {
+    while (rcutils_atomic_load_bool(&log->busy)) {
+      // Wait for the refresh of the holder, after which there is most likely nothing left to do
+    }
+  }
+}
+
+void
+rcl_graph_change_log_release(rcl_graph_change_log_t * log)
+{
+  rcutils_atomic_store(&log->busy, false);
+}
+
+static
+int
+_compare_nodes(const void * lhs, const void * rhs)
+{
+  const rcl_graph_change_t * a = (const rcl_graph_change_t *)lhs;
+  const rcl_graph_change_t * b = (const rcl_graph_change_t *)rhs;
+  int result = strcmp(a->node_namespace, b->node_namespace);
+  return 0 != result ? result : strcmp(a->node_name, b->node_name);
+}
+
+static
+int
+_compare_endpoints(const void * lhs, const void * rhs)
+{
+  const rcl_graph_change_t * a = (const rcl_graph_change_t *)lhs;
+  const rcl_graph_change_t * b = (const rcl_graph_change_t *)rhs;
+  int result = memcmp(a->endpoint_gid, b->endpoint_gid, RMW_GID_STORAGE_SIZE);
+  if (0 != result) {
+    return result;
+  }
+  if (a->endpoint_type != b->endpoint_type) {
+    return a->endpoint_type < b->endpoint_type ? -1 : 1;
+  }
+  return strcmp(a->topic_name, b->topic_name);
+}
+
+// Make room for one more change, growing geometrically.
+static
+rcl_graph_change_t *
+_buffer_push(rcl_graph_change_buffer_t * buffer, rcl_allocator_t * allocator)
+{
+  if (buffer->size == buffer->capacity) {
+    size_t new_capacity = 0u == buffer->capacity ? 64u : buffer->capacity * 2u;
+    rcl_graph_change_t * new_data = allocator->reallocate(
+      buffer->data, new_capacity * sizeof(rcl_graph_change_t), allocator->state);
+    if (NULL == new_data) {
+      return NULL;
+    }
+    buffer->data = new_data;
+    buffer->capacity = new_capacity;
+  }
+  rcl_graph_change_t * change = &buffer->data[buffer->size];
+  memset(change, 0, sizeof(*change));
+  return change;
+}
+
+static
+rcl_ret_t
+_append_endpoints(
+  const rmw_node_t * rmw_node,
+  rcl_allocator_t * allocator,
+  const char * topic_name,
+  bool publishers,
+  rcl_graph_change_buffer_t * endpoints)
+{
+  rmw_topic_endpoint_info_array_t info = rmw_get_zero_initialized_topic_endpoint_info_array();
+  rcutils_allocator_t rcutils_allocator = *allocator;
+  rmw_ret_t rmw_ret = publishers ?
+    rmw_get_publishers_info_by_topic(rmw_node, &rcutils_allocator, topic_name, false, &info) :
+    rmw_get_subscriptions_info_by_topic(rmw_node, &rcutils_allocator, topic_name, false, &info);
+  if (RMW_RET_OK != rmw_ret) {
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+
+  rcl_ret_t ret = RCL_RET_OK;
+  for (size_t i = 0u; i < info.size; ++i) {
+    const rmw_topic_endpoint_info_t * endpoint = &info.info_array[i];
+    rcl_graph_change_t * change = _buffer_push(endpoints, allocator);
+    if (NULL == change) {
+      ret = RCL_RET_BAD_ALLOC;
+      break;
+    }
+    change->kind = RCL_GRAPH_CHANGE_ENDPOINT_ADDED;
+    change->endpoint_type = endpoint->endpoint_type;
+    memcpy(change->endpoint_gid, endpoint->endpoint_gid, RMW_GID_STORAGE_SIZE);
+    change->qos_profile = endpoint->qos_profile;
+    // Count the entry first, so it is released along with the others on failure
+    ++endpoints->size;
+    if (!_strdup_member(endpoint->node_name, &change->node_name, allocator) ||
+      !_strdup_member(endpoint->node_namespace, &change->node_namespace, allocator) ||
+      !_strdup_member(topic_name, &change->topic_name, allocator) ||
+      !_strdup_member(endpoint->topic_type, &change->topic_type, allocator))
+    {
+      ret = RCL_RET_BAD_ALLOC;
+      break;
+    }
+  }
+  if (RMW_RET_OK != rmw_topic_endpoint_info_array_fini(&info, &rcutils_allocator)) {
+    rmw_reset_error();
+  }
+  if (RCL_RET_BAD_ALLOC == ret) {
+    RCL_SET_ERROR_MSG("allocating memory for graph snapshot failed");
+  }
+  return ret;
+}
+
+// Collect copies of the entries of `a` which are not in `b`, both sorted by `compare`.
+static
+rcl_ret_t
+_collect_difference(
+  const rcl_graph_change_t * a,
+  size_t a_count,
+  const rcl_graph_change_t * b,
+  size_t b_count,
+  int (* compare)(const void *, const void *),
+  rcl_graph_change_kind_t kind,
+  rcl_allocator_t * allocator,
+  rcl_graph_change_buffer_t * difference)
+{
+  size_t j = 0u;
+  for (size_t i = 0u; i < a_count; ++i) {
+    while (j < b_count && compare(&b[j], &a[i]) < 0) {
+      ++j;
+    }
+    if (j < b_count && 0 == compare(&a[i], &b[j])) {
+      continue;
+    }
+    rcl_graph_change_t * change = _buffer_push(difference, allocator);
+    if (NULL == change || !_copy_change(&a[i], change, allocator)) {
+      RCL_SET_ERROR_MSG("allocating memory for graph changes failed");
+      return RCL_RET_BAD_ALLOC;
+    }
+    change->kind = kind;
+    ++difference->size;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_graph_change_log_refresh(
+  rcl_graph_change_log_t * log,
+  const rmw_node_t * rmw_node,
+  uint64_t graph_version)
+{
+  rcl_allocator_t * allocator = &log->allocator;
+  rcl_ret_t ret = RCL_RET_OK;
+  rcutils_string_array_t node_names = rcutils_get_zero_initialized_string_array();
+  rcutils_string_array_t node_namespaces = rcutils_get_zero_initialized_string_array();
+  rmw_names_and_types_t topics = rmw_get_zero_initialized_names_and_types();
+  rcl_graph_change_buffer_t nodes = {NULL, 0u, 0u};
+  rcl_graph_change_buffer_t endpoints = {NULL, 0u, 0u};
+  rcl_graph_change_buffer_t pending = {NULL, 0u, 0u};
+  rcutils_allocator_t rcutils_allocator = *allocator;
+
+  if (NULL == log->changes) {
+    log->changes = allocator->zero_allocate(
+      RCL_GRAPH_CHANGE_LOG_CAPACITY, sizeof(rcl_graph_change_t), allocator->state);
+    if (NULL == log->changes) {
+      RCL_SET_ERROR_MSG("allocating memory for graph changes failed");
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+
+  rmw_ret_t rmw_ret = rmw_get_node_names(rmw_node, &node_names, &node_namespaces);
+  if (RMW_RET_OK != rmw_ret) {
+    ret = rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+    goto cleanup;
+  }
+  for (size_t i = 0u; i < node_names.size && i < node_namespaces.size; ++i) {
+    if (NULL == node_names.data[i] || NULL == node_namespaces.data[i]) {
+      continue;
+    }
+    rcl_graph_change_t * change = _buffer_push(&nodes, allocator);
+    if (NULL == change) {
+      ret = RCL_RET_BAD_ALLOC;
+      goto cleanup;
+    }
+    change->kind = RCL_GRAPH_CHANGE_NODE_ADDED;
+    change->endpoint_type = RMW_ENDPOINT_INVALID;
+    ++nodes.size;
+    if (!_strdup_member(node_names.data[i], &change->node_name, allocator) ||
+      !_strdup_member(node_namespaces.data[i], &change->node_namespace, allocator))
+    {
+      ret = RCL_RET_BAD_ALLOC;
+      goto cleanup;
+    }
+  }
+  if (nodes.size > 0u) {
+    qsort(nodes.data, nodes.size, sizeof(rcl_graph_change_t), _compare_nodes);
+  }
+
+  rmw_ret = rmw_get_topic_names_and_types(rmw_node, &rcutils_allocator, false, &topics);
+  if (RMW_RET_OK != rmw_ret) {
+    ret = rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+    goto cleanup;
+  }
+  for (size_t i = 0u; i < topics.names.size; ++i) {
+    ret = _append_endpoints(rmw_node, allocator, topics.names.data[i], true, &endpoints);
+    if (RCL_RET_OK != ret) {
+      goto cleanup;
+    }
+    ret = _append_endpoints(rmw_node, allocator, topics.names.data[i], false, &endpoints);
+    if (RCL_RET_OK != ret) {
+      goto cleanup;
+    }
+  }
+  if (endpoints.size > 0u) {
+    qsort(endpoints.data, endpoints.size, sizeof(rcl_graph_change_t), _compare_endpoints);
+  }
+
+  if (log->has_snapshot) {
+    // Endpoints go away before their nodes, and nodes come before their endpoints
+    ret = _collect_difference(
+      log->endpoints, log->endpoint_count, endpoints.data, endpoints.size,
+      _compare_endpoints, RCL_GRAPH_CHANGE_ENDPOINT_REMOVED, allocator, &pending);
+    if (RCL_RET_OK == ret) {
+      ret = _collect_difference(
+        log->nodes, log->node_count, nodes.data, nodes.size,
+        _compare_nodes, RCL_GRAPH_CHANGE_NODE_REMOVED, allocator, &pending);
+    }
+    if (RCL_RET_OK == ret) {
+      ret = _collect_difference(
+        nodes.data, nodes.size, log->nodes, log->node_count,
+        _compare_nodes, RCL_GRAPH_CHANGE_NODE_ADDED, allocator, &pending);
+    }
+    if (RCL_RET_OK == ret) {
+      ret = _collect_difference(
+        endpoints.data, endpoints.size, log->endpoints, log->endpoint_count,
+        _compare_endpoints, RCL_GRAPH_CHANGE_ENDPOINT_ADDED, allocator, &pending);
+    }
+    if (RCL_RET_OK != ret) {
+      goto cleanup;
+    }
+  } else {
+    // The first snapshot is a version of its own, so `0` always asks for a snapshot
+    log->latest_version = 1u;
+  }
+
+  // Nothing can fail from here on, commit the changes and the new snapshot.
+  for (size_t i = 0u; i < pending.size; ++i) {
+    if (RCL_GRAPH_CHANGE_LOG_CAPACITY == log->changes_size) {
+      rcl_graph_change_fini(&log->changes[log->changes_head], allocator);
+      log->changes_head = (log->changes_head + 1u) % RCL_GRAPH_CHANGE_LOG_CAPACITY;
+      --log->changes_size;
+    }
+    pending.data[i].version = ++log->latest_version;
+    log->changes[(log->changes_head + log->changes_size) % RCL_GRAPH_CHANGE_LOG_CAPACITY] =
+      pending.data[i];
+    ++log->changes_size;
+  }
+  pending.size = 0u;
+
+  _free_changes(log->nodes, log->node_count, allocator);
+  _free_changes(log->endpoints, log->endpoint_count, allocator);
+  log->nodes = nodes.data;
+  log->node_count = nodes.size;
+  log->endpoints = endpoints.data;
+  log->endpoint_count = endpoints.size;
+  nodes.data = NULL;
+  nodes.size = 0u;
+  endpoints.data = NULL;
+  endpoints.size = 0u;
+  log->has_snapshot = true;
+  log->snapshot_graph_version = graph_version;
+
+cleanup:
+  if (RCL_RET_BAD_ALLOC == ret && !rcl_error_is_set()) {
+    RCL_SET_ERROR_MSG("allocating memory for graph snapshot failed");
+  }
+  _free_changes(pending.data, pending.size, allocator);
+  _free_changes(nodes.data, nodes.size, allocator);
+  _free_changes(endpoints.data, endpoints.size, allocator);
+  if (NULL != topics.names.data && RMW_RET_OK != rmw_names_and_types_fini(&topics)) {
+    rmw_reset_error();
+  }
+  if (RCUTILS_RET_OK != rcutils_string_array_fini(&node_names)) {
+    rcutils_reset_error();
+  }
+  if (RCUTILS_RET_OK != rcutils_string_array_fini(&node_namespaces)) {
+    rcutils_reset_error();
+  }
+  return ret;
+}
+
+rcl_ret_t
+rcl_graph_change_log_get_changes(
+  const rcl_graph_change_log_t * log,
+  uint64_t since_version,
+  rcl_allocator_t * allocator,
+  rcl_graph_change_array_t * changes,
+  uint64_t * latest_version)
+{
+  if (since_version > log->latest_version) {
+    RCL_SET_ERROR_MSG("graph change version is newer than the latest change");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  // Changes older than the ring buffer are lost, fall back to the snapshot
+  bool full_snapshot = 0u == since_version ||
+    since_version < log->latest_version - log->changes_size;
+  size_t count = full_snapshot ?
+    log->node_count + log->endpoint_count :
+    (size_t)(log->latest_version - since_version);
+
+  changes->is_full_snapshot = full_snapshot;
+  changes->allocator = *allocator;
+  *latest_version = log->latest_version;
+  if (0u == count) {
+    return RCL_RET_OK;
+  }
+  changes->data = allocator->zero_allocate(count, sizeof(rcl_graph_change_t), allocator->state);
+  if (NULL == changes->data) {
+    RCL_SET_ERROR_MSG("allocating memory for graph changes failed");
+    return RCL_RET_BAD_ALLOC;
+  }
+  for (size_t i = 0u; i < count; ++i) {
+    const rcl_graph_change_t * src;
+    if (!full_snapshot) {
+      size_t offset = log->changes_size - count + i;
+      src = &log->changes[(log->changes_head + offset) % RCL_GRAPH_CHANGE_LOG_CAPACITY];
+    } else if (i < log->node_count) {
+      src = &log->nodes[i];
+    } else {
+      src = &log->endpoints[i - log->node_count];
+    }
+    if (!_copy_change(src, &changes->data[i], allocator)) {
+      _free_changes(changes->data, i, allocator);
+      changes->data = NULL;
+      changes->size = 0u;
+      RCL_SET_ERROR_MSG("allocating memory for graph changes failed");
+      return RCL_RET_BAD_ALLOC;
+    }
+    if (full_snapshot) {
+      changes->data[i].version = log->latest_version;
+    }
+    ++changes->size;
+  }
+  return RCL_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
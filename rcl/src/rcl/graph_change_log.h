@@ -0,0 +1,138 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__GRAPH_CHANGE_LOG_H_
+#define RCL__GRAPH_CHANGE_LOG_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcutils/stdatomic_helper.h"
+#include "rmw/rmw.h"
+
+#include "rcl/allocator.h"
+#include "rcl/graph.h"
+#include "rcl/types.h"
+
+/// Number of changes remembered by a context, older ones are only available as a snapshot.
+#define RCL_GRAPH_CHANGE_LOG_CAPACITY 4096
+
+/// Snapshot of the graph plus the most recent changes between snapshots.
+/**
+ * Snapshot entries are kept sorted, nodes by namespace and name and endpoints
+ * by GID, so two snapshots are compared with a single merge pass.
+ * The `kind` and `version` members of snapshot entries are unused.
+ */
+typedef struct rcl_graph_change_log_s
+{
+  /// Held while the log is read or refreshed
+  atomic_bool busy;
+  /// Allocator for everything owned by the log
+  rcl_allocator_t allocator;
+  /// Whether or not a snapshot was taken yet
+  bool has_snapshot;
+  /// Graph version of the context at which the snapshot was taken
+  uint64_t snapshot_graph_version;
+  /// Nodes of the snapshot
+  rcl_graph_change_t * nodes;
+  /// Number of nodes of the snapshot
+  size_t node_count;
+  /// Endpoints of the snapshot
+  rcl_graph_change_t * endpoints;
+  /// Number of endpoints of the snapshot
+  size_t endpoint_count;
+  /// Ring buffer of the most recent changes, RCL_GRAPH_CHANGE_LOG_CAPACITY long
+  rcl_graph_change_t * changes;
+  /// Index of the oldest change in the ring buffer
+  size_t changes_head;
+  /// Number of changes in the ring buffer
+  size_t changes_size;
+  /// Version of the most recent change, the first snapshot being version 1, 0 before it
+  uint64_t latest_version;
+} rcl_graph_change_log_t;
+
+/// Initialize a zero initialized change log.
+void
+rcl_graph_change_log_init(rcl_graph_change_log_t * log, rcl_allocator_t allocator);
+
+/// Release the strings of a graph change.
+void
+rcl_graph_change_fini(rcl_graph_change_t * change, rcl_allocator_t * allocator);
+
+/// Release everything owned by the change log.
+void
+rcl_graph_change_log_fini(rcl_graph_change_log_t * log);
+
+/// Try to get exclusive access to the change log, without blocking.
+bool
+rcl_graph_change_log_acquire(rcl_graph_change_log_t * log);
+
+/// Get exclusive access to the change log, waiting for a concurrent holder to give it up.
+/**
+ * The log is held while the graph is queried, so this may spin for as long as a refresh takes.
+ */
+void
+rcl_graph_change_log_lock(rcl_graph_change_log_t * log);
+
+/// Give up exclusive access to the change log.
+void
+rcl_graph_change_log_release(rcl_graph_change_log_t * log);
+
+/// Take a new snapshot of the graph and record how it differs from the previous one.
+/**
+ * On failure the previous snapshot and changes are kept.
+ *
+ * \param[inout] log acquired change log
+ * \param[in] rmw_node node used to query the graph
+ * \param[in] graph_version graph version of the context, read before calling
+ * \return #RCL_RET_OK if the snapshot was taken, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_ERROR if querying the graph failed.
+ */
+rcl_ret_t
+rcl_graph_change_log_refresh(
+  rcl_graph_change_log_t * log,
+  const rmw_node_t * rmw_node,
+  uint64_t graph_version);
+
+/// Copy the changes since `since_version`, or the whole snapshot, into `changes`.
+/**
+ * \param[in] log acquired change log
+ * \param[in] since_version version held by the caller
+ * \param[in] allocator allocator for the copies
+ * \param[out] changes zero initialized array
+ * \param[out] latest_version version of the most recent change
+ * \return #RCL_RET_OK if the changes were copied, or
+ * \return #RCL_RET_INVALID_ARGUMENT if `since_version` is in the future, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed.
+ */
+rcl_ret_t
+rcl_graph_change_log_get_changes(
+  const rcl_graph_change_log_t * log,
+  uint64_t since_version,
+  rcl_allocator_t * allocator,
+  rcl_graph_change_array_t * changes,
+  uint64_t * latest_version);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__GRAPH_CHANGE_LOG_H_
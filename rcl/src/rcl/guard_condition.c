@@ -25,13 +25,7 @@ extern "C"
 #include "rmw/rmw.h"
 
 #include "./context_impl.h"
-
-struct rcl_guard_condition_impl_s
-{
-  rmw_guard_condition_t * rmw_handle;
-  bool allocated_rmw_guard_condition;
-  rcl_guard_condition_options_t options;
-};
+#include "./guard_condition_impl.h"
 
 rcl_guard_condition_t
 rcl_get_zero_initialized_guard_condition()
@@ -95,6 +89,8 @@ __rcl_guard_condition_init_from_rmw_impl(
   }
   // Copy options into impl.
   guard_condition->impl->options = options;
+  atomic_init(&guard_condition->impl->trigger_count, 0);
+  guard_condition->impl->shared_trigger_count = NULL;
   return RCL_RET_OK;
 }
 
@@ -161,6 +157,7 @@ rcl_trigger_guard_condition(rcl_guard_condition_t * guard_condition)
     RCL_SET_ERROR_MSG(rmw_get_error_string().str);
     return RCL_RET_ERROR;
   }
+  rcl_guard_condition_count_trigger(guard_condition);
   return RCL_RET_OK;
 }
 
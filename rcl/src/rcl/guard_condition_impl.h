@@ -0,0 +1,47 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__GUARD_CONDITION_IMPL_H_
+#define RCL__GUARD_CONDITION_IMPL_H_
+
+#include "rcutils/stdatomic_helper.h"
+#include "rmw/rmw.h"
+
+#include "rcl/guard_condition.h"
+
+struct rcl_guard_condition_impl_s
+{
+  rmw_guard_condition_t * rmw_handle;
+  bool allocated_rmw_guard_condition;
+  rcl_guard_condition_options_t options;
+  // Number of times the guard condition was triggered through rcl, or seen
+  // triggered by rcl_wait(), used to tell when state derived from it is stale.
+  atomic_uint_least64_t trigger_count;
+  // Counter advanced along with trigger_count, e.g. the graph version of the
+  // context for node graph guard conditions, may be NULL.
+  atomic_uint_least64_t * shared_trigger_count;
+};
+
+// Count a trigger of the guard condition, see trigger_count.
+static inline
+void
+rcl_guard_condition_count_trigger(const rcl_guard_condition_t * guard_condition)
+{
+  rcutils_atomic_fetch_add_uint64_t(&guard_condition->impl->trigger_count, 1u);
+  if (NULL != guard_condition->impl->shared_trigger_count) {
+    rcutils_atomic_fetch_add_uint64_t(guard_condition->impl->shared_trigger_count, 1u);
+  }
+}
+
+#endif  // RCL__GUARD_CONDITION_IMPL_H_
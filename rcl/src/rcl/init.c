@@ -95,6 +95,11 @@ rcl_init(
   // Store the allocator.
   context->impl->allocator = allocator;
 
+  // The graph cache starts disabled and empty.
+  rcl_graph_cache_init(&context->impl->graph_cache, allocator);
+  rcl_graph_change_log_init(&context->impl->graph_change_log, allocator);
+  rcl_name_table_init(&context->impl->name_table, allocator);
+
   // Copy the options into the context for future reference.
   rcl_ret_t ret = rcl_init_options_copy(options, &(context->impl->init_options));
   if (RCL_RET_OK != ret) {
@@ -31,6 +31,11 @@
  * The movement M is written as M = 1 + N so it can be stored in an unsigned integer.
  * For example, an `<else>` transition with M = 0 moves the lexer forwards 1 character, M = 1 keeps
  * the lexer at the current character, and M = 2 moves the lexer backwards one character.
+ *
+ * The diagram is compiled by hand into the tables below.
+ * Characters which every state treats the same way share a character class, so each state only
+ * needs one row of CHAR_CLASS_COUNT next states, looked up without comparing any range.
+ * Runs of characters staying in S9, the body of a token, are scanned in a tight loop.
 
 digraph remapping_lexer {
   rankdir=LR;
@@ -138,30 +143,6 @@ digraph remapping_lexer {
 }
 */
 
-/// Represents a transition from one state to another
-/// \internal
-typedef struct rcl_lexer_transition_s
-{
-  /// Index of a state to transition to
-  const unsigned char to_state;
-  /// Start of a range of chars (inclusive) which activates this transition
-  const char range_start;
-  /// End of a range of chars (inclusive) which activates this transition
-  const char range_end;
-} rcl_lexer_transition_t;
-
-/// Represents a non-terminal state
-/// \internal
-typedef struct rcl_lexer_state_s
-{
-  /// Transition to this state if no other transition matches
-  const unsigned char else_state;
-  /// Movement associated with taking else state
-  const unsigned char else_movement;
-  /// Transitions in the state machine (NULL value at end of array)
-  const rcl_lexer_transition_t transitions[12];
-} rcl_lexer_state_t;
-
 #define S0 0u
 #define S1 1u
 #define S2 2u
@@ -224,325 +205,325 @@ typedef struct rcl_lexer_state_s
 #define FIRST_TERMINAL T_TILDE_SLASH
 #define LAST_TERMINAL T_NONE
 
-// Used to mark where the last transition is in a state
-#define END_TRANSITIONS {0, '\0', '\0'}
+// Number of character classes, see g_char_classes
+#define CHAR_CLASS_COUNT 33u
+
+// Marks the next state of an '<else,M>' transition, M being given by g_else_movements
+#define ELSE_TRANSITION 0x80u
+#define ELSE_TO(state) ((state) | ELSE_TRANSITION)
 
-static const rcl_lexer_state_t g_states[LAST_STATE + 1] =
+/// Character class of every character
+/**
+ * Classes are: 0 anything else, 1 '*', 2 '.', 3 '/', 4 to 13 '0' to '9', 14 ':', 15 '=',
+ * 16 letters never checked on their own ('A'-'Z' 'b' 'f'-'h' 'j'-'l' 'q' 'u' 'w'-'z'),
+ * 17 '\\', 18 '_', 19 'a', 20 'c', 21 'd', 22 'e', 23 'i', 24 'm', 25 'n', 26 'o', 27 'p', 28 'r',
+ * 29 's', 30 't', 31 'v', 32 '~'.
+ * \internal
+ */
+static const unsigned char g_char_classes[256] =
+{
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  1,  0,  0,  0,  2,  3,
+   4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,  0,  0, 15,  0,  0,
+   0, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+  16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,  0, 17,  0,  0, 18,
+   0, 19, 16, 20, 21, 22, 16, 16, 16, 23, 16, 16, 16, 24, 25, 26,
+  27, 16, 28, 29, 30, 16, 31, 16, 16, 16, 16,  0,  0,  0, 32,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+};
+
+/// Next state of every non-terminal state for every character class
+/// \internal
+static const unsigned char g_transitions[LAST_STATE + 1][CHAR_CLASS_COUNT] =
 {
   // S0
   {
-    T_NONE,
-    0u,
-    {
-      {T_FORWARD_SLASH, '/', '/'},
-      {T_DOT, '.', '.'},
-      {S1, '\\', '\\'},
-      {S2, '~', '~'},
-      {S3, '_', '_'},
-      {S9, 'a', 'q'},
-      {S9, 's', 'z'},
-      {S9, 'A', 'Z'},
-      {S11, 'r', 'r'},
-      {S30, '*', '*'},
-      {S31, ':', ':'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(T_NONE), S30, T_DOT, T_FORWARD_SLASH, ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), S31, ELSE_TO(T_NONE), S9, S1, S3, S9, S9,
+    S9, S9, S9, S9, S9, S9, S9, S11, S9, S9, S9, S2
   },
   // S1
   {
-    T_NONE,
-    0u,
-    {
-      {T_BR1, '1', '1'},
-      {T_BR2, '2', '2'},
-      {T_BR3, '3', '3'},
-      {T_BR4, '4', '4'},
-      {T_BR5, '5', '5'},
-      {T_BR6, '6', '6'},
-      {T_BR7, '7', '7'},
-      {T_BR8, '8', '8'},
-      {T_BR9, '9', '9'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), T_BR1,
+    T_BR2, T_BR3, T_BR4, T_BR5, T_BR6, T_BR7, T_BR8, T_BR9, ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE)
   },
   // S2
   {
-    T_NONE,
-    0u,
-    {
-      {T_TILDE_SLASH, '/', '/'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), T_TILDE_SLASH, ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE)
   },
   // S3
   {
-    S10,
-    1u,
-    {
-      {S4, '_', '_'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10),
+    ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10),
+    ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10), S4,
+    ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10),
+    ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10), ELSE_TO(S10),
+    ELSE_TO(S10), ELSE_TO(S10)
   },
   // S4
   {
-    T_NONE,
-    0u,
-    {
-      {S5, 'n', 'n'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), S5,
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE)
   },
   // S5
   {
-    T_NONE,
-    0u,
-    {
-      {T_NS, 's', 's'},
-      {S6, 'o', 'o'},
-      {S7, 'a', 'a'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), S7, ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), S6,
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), T_NS, ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE)
   },
   // S6
   {
-    T_NONE,
-    0u,
-    {
-      {S8, 'd', 'd'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), S8, ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE)
   },
   // S7
   {
-    T_NONE,
-    0u,
-    {
-      {S8, 'm', 'm'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), S8, ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE)
   },
   // S8
   {
-    T_NONE,
-    0u,
-    {
-      {T_NODE, 'e', 'e'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), T_NODE, ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE), ELSE_TO(T_NONE),
+    ELSE_TO(T_NONE), ELSE_TO(T_NONE)
   },
   // S9
   {
-    T_TOKEN,
-    1u,
-    {
-      {S9, 'a', 'z'},
-      {S9, 'A', 'Z'},
-      {S9, '0', '9'},
-      {S10, '_', '_'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(T_TOKEN), ELSE_TO(T_TOKEN), ELSE_TO(T_TOKEN), ELSE_TO(T_TOKEN), S9, S9, S9, S9, S9, S9,
+    S9, S9, S9, S9, ELSE_TO(T_TOKEN), ELSE_TO(T_TOKEN), S9, ELSE_TO(T_TOKEN), S10, S9, S9, S9, S9,
+    S9, S9, S9, S9, S9, S9, S9, S9, S9, ELSE_TO(T_TOKEN)
   },
   // S10
   {
-    T_TOKEN,
-    1u,
-    {
-      {S9, 'a', 'z'},
-      {S9, 'A', 'Z'},
-      {S9, '0', '9'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(T_TOKEN), ELSE_TO(T_TOKEN), ELSE_TO(T_TOKEN), ELSE_TO(T_TOKEN), S9, S9, S9, S9, S9, S9,
+    S9, S9, S9, S9, ELSE_TO(T_TOKEN), ELSE_TO(T_TOKEN), S9, ELSE_TO(T_TOKEN), ELSE_TO(T_TOKEN), S9,
+    S9, S9, S9, S9, S9, S9, S9, S9, S9, S9, S9, S9, ELSE_TO(T_TOKEN)
   },
   // S11
   {
-    S9,
-    1u,
-    {
-      {S12, 'o', 'o'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), S12, ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9)
   },
   // S12
   {
-    S9,
-    1u,
-    {
-      {S13, 's', 's'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), S13, ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9)
   },
   // S13
   {
-    S9,
-    1u,
-    {
-      {S14, 't', 't'},
-      {S21, 's', 's'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), S21, S14, ELSE_TO(S9), ELSE_TO(S9)
   },
   // S14
   {
-    S9,
-    1u,
-    {
-      {S15, 'o', 'o'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), S15, ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9)
   },
   // S15
   {
-    S9,
-    1u,
-    {
-      {S16, 'p', 'p'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), S16, ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9)
   },
   // S16
   {
-    S9,
-    1u,
-    {
-      {S17, 'i', 'i'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), S17, ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9)
   },
   // S17
   {
-    S9,
-    1u,
-    {
-      {S18, 'c', 'c'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), S18, ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9)
   },
   // S18
   {
-    S9,
-    1u,
-    {
-      {S19, ':', ':'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), S19,
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9)
   },
   // S19
   {
-    S9,
-    2u,
-    {
-      {S20, '/', '/'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), S20, ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9)
   },
   // S20
   {
-    S9,
-    3u,
-    {
-      {T_URL_TOPIC, '/', '/'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), T_URL_TOPIC, ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9)
   },
   // S21
   {
-    S9,
-    1u,
-    {
-      {S22, 'e', 'e'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), S22, ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9)
   },
-  // S21
+  // S22
   {
-    S9,
-    1u,
-    {
-      {S23, 'r', 'r'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), S23,
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9)
   },
   // S23
   {
-    S9,
-    1u,
-    {
-      {S24, 'v', 'v'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), S24, ELSE_TO(S9)
   },
   // S24
   {
-    S9,
-    1u,
-    {
-      {S25, 'i', 'i'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), S25, ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9)
   },
   // S25
   {
-    S9,
-    1u,
-    {
-      {S26, 'c', 'c'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), S26, ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9)
   },
   // S26
   {
-    S9,
-    1u,
-    {
-      {S27, 'e', 'e'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), S27, ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9)
   },
   // S27
   {
-    S9,
-    1u,
-    {
-      {S28, ':', ':'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), S28,
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9)
   },
   // S28
   {
-    S9,
-    2u,
-    {
-      {S29, '/', '/'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), S29, ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9)
   },
   // S29
   {
-    S9,
-    3u,
-    {
-      {T_URL_SERVICE, '/', '/'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), T_URL_SERVICE, ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9),
+    ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9), ELSE_TO(S9)
   },
   // S30
   {
-    T_WILD_ONE,
-    1u,
-    {
-      {T_WILD_MULTI, '*', '*'},
-      END_TRANSITIONS
-    }
+    ELSE_TO(T_WILD_ONE), T_WILD_MULTI, ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE),
+    ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE),
+    ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE),
+    ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE),
+    ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE),
+    ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE),
+    ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE),
+    ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE), ELSE_TO(T_WILD_ONE),
+    ELSE_TO(T_WILD_ONE)
   },
   // S31
   {
-    T_COLON,
-    1u,
-    {
-      {T_SEPARATOR, '=', '='},
-      END_TRANSITIONS
-    }
-  }
+    ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON),
+    ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON),
+    ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON),
+    T_SEPARATOR, ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON),
+    ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON),
+    ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON),
+    ELSE_TO(T_COLON), ELSE_TO(T_COLON), ELSE_TO(T_COLON)
+  },
+};
+
+/// Movement associated with taking the else transition of every non-terminal state
+/// \internal
+static const unsigned char g_else_movements[LAST_STATE + 1] =
+{
+  // S0 to S15
+  0u, 0u, 0u, 1u, 0u, 0u, 0u, 0u, 0u, 1u, 1u, 1u, 1u, 1u, 1u, 1u,
+  // S16 to S31
+  1u, 1u, 1u, 2u, 3u, 1u, 1u, 1u, 1u, 1u, 1u, 1u, 2u, 3u, 1u, 1u,
 };
 
 static const rcl_lexeme_t g_terminals[LAST_TERMINAL + 1] = {
@@ -615,39 +596,21 @@ rcl_lexer_analyze(
     return RCL_RET_OK;
   }
 
-  const rcl_lexer_state_t * state;
-  char current_char;
-  size_t next_state = S0;
+  const unsigned char * current = (const unsigned char *)text;
+  size_t state = S0;
+  size_t next_state;
   size_t movement;
 
   // Analyze one character at a time until lexeme is found
   do {
-    if (next_state > LAST_STATE) {
-      // Should never happen
-      RCL_SET_ERROR_MSG("Internal lexer bug: next state does not exist");
-      return RCL_RET_ERROR;
-    }
-    state = &(g_states[next_state]);
-    current_char = text[*length];
-    next_state = 0u;
+    unsigned char current_char = current[*length];
+    next_state = g_transitions[state][g_char_classes[current_char]];
     movement = 0u;
 
-    // Look for a transition that contains this character in its range
-    size_t transition_idx = 0u;
-    const rcl_lexer_transition_t * transition;
-    do {
-      transition = &(state->transitions[transition_idx]);
-      if (transition->range_start <= current_char && transition->range_end >= current_char) {
-        next_state = transition->to_state;
-        break;
-      }
-      ++transition_idx;
-    } while (0u != transition->to_state);
-
-    // if no transition was found, take the else transition
-    if (0u == next_state) {
-      next_state = state->else_state;
-      movement = state->else_movement;
+    // take the else transition if no other transition matched
+    if (0u != (next_state & ELSE_TRANSITION)) {
+      movement = g_else_movements[state];
+      next_state &= ~ELSE_TRANSITION;
     }
 
     if (0u == movement) {
@@ -664,13 +627,21 @@ rcl_lexer_analyze(
       }
       *length -= movement - 1u;
     }
-  } while (next_state < FIRST_TERMINAL);
 
-  if (FIRST_TERMINAL > next_state || next_state - FIRST_TERMINAL > LAST_TERMINAL) {
+    if (S9 == next_state) {
+      // Fast path: consume the whole run of token characters at once
+      while (S9 == g_transitions[S9][g_char_classes[current[*length]]]) {
+        ++(*length);
+      }
+    }
+    state = next_state;
+  } while (state < FIRST_TERMINAL);
+
+  if (state - FIRST_TERMINAL > LAST_TERMINAL) {
     // Should never happen
     RCL_SET_ERROR_MSG("Internal lexer bug: terminal state does not exist");
     return RCL_RET_ERROR;
   }
-  *lexeme = g_terminals[next_state - FIRST_TERMINAL];
+  *lexeme = g_terminals[state - FIRST_TERMINAL];
   return RCL_RET_OK;
 }
@@ -0,0 +1,252 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./name_table.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rcutils/stdatomic_helper.h"
+
+#include "rcl/error_handling.h"
+
+#define RCL_NAME_TABLE_INITIAL_BUCKET_COUNT 64u
+
+/// Held while the buckets of any table or the entries are read or modified
+static atomic_bool __rcl_name_tables_busy = ATOMIC_VAR_INIT(false);
+
+struct rcl_name_table_entry_s
+{
+  /// Next entry of the same bucket
+  rcl_name_table_entry_t * next;
+  /// Table holding the entry, `NULL` once the table was finalized
+  rcl_name_table_t * table;
+  /// Allocator the entry was allocated with
+  rcl_allocator_t allocator;
+  /// Number of references
+  size_t reference_count;
+  /// Hash of the name
+  size_t hash;
+  /// Length of the name
+  size_t length;
+  /// The name itself, null terminated
+  char name[];
+};
+
+static
+void
+_lock(void)
+{
+  // Only ever held for a lookup, an insertion or a removal, never across an allocation
+  while (rcutils_atomic_exchange_bool(&__rcl_name_tables_busy, true)) {
+    while (rcutils_atomic_load_bool(&__rcl_name_tables_busy)) {
+      // Wait for the lock to be released before trying to take it again
+    }
+  }
+}
+
+static
+void
+_unlock(void)
+{
+  rcutils_atomic_store(&__rcl_name_tables_busy, false);
+}
+
+static
+rcl_name_table_entry_t *
+_entry_of(const char * interned_name)
+{
+  return (rcl_name_table_entry_t *)(interned_name - offsetof(rcl_name_table_entry_t, name));
+}
+
+static
+size_t
+_hash(const char * name, size_t * length)
+{
+  // FNV-1a
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  const unsigned char * c = (const unsigned char *)name;
+  for (; *c != '\0'; ++c) {
+    hash = (hash ^ *c) * 0x100000001b3ULL;
+  }
+  *length = (size_t)(c - (const unsigned char *)name);
+  return (size_t)hash;
+}
+
+void
+rcl_name_table_init(rcl_name_table_t * table, rcl_allocator_t allocator)
+{
+  table->allocator = allocator;
+  table->buckets = NULL;
+  table->bucket_count = 0u;
+  table->entry_count = 0u;
+}
+
+void
+rcl_name_table_fini(rcl_name_table_t * table)
+{
+  _lock();
+  rcl_name_table_entry_t ** buckets = table->buckets;
+  for (size_t i = 0u; i < table->bucket_count; ++i) {
+    rcl_name_table_entry_t * entry = buckets[i];
+    while (NULL != entry) {
+      rcl_name_table_entry_t * next = entry->next;
+      // Still referenced, the last release frees it
+      entry->table = NULL;
+      entry->next = NULL;
+      entry = next;
+    }
+  }
+  table->buckets = NULL;
+  table->bucket_count = 0u;
+  table->entry_count = 0u;
+  _unlock();
+  if (NULL != buckets) {
+    table->allocator.deallocate(buckets, table->allocator.state);
+  }
+}
+
+// Move the entries to `buckets`, `bucket_count` long, with the table lock held.
+// Returns the buckets replaced, to be deallocated once the lock is released.
+static
+rcl_name_table_entry_t **
+_rehash(rcl_name_table_t * table, rcl_name_table_entry_t ** buckets, size_t bucket_count)
+{
+  for (size_t i = 0u; i < table->bucket_count; ++i) {
+    rcl_name_table_entry_t * entry = table->buckets[i];
+    while (NULL != entry) {
+      rcl_name_table_entry_t * next = entry->next;
+      size_t index = entry->hash & (bucket_count - 1u);
+      entry->next = buckets[index];
+      buckets[index] = entry;
+      entry = next;
+    }
+  }
+  rcl_name_table_entry_t ** old_buckets = table->buckets;
+  table->buckets = buckets;
+  table->bucket_count = bucket_count;
+  return old_buckets;
+}
+
+const char *
+rcl_name_table_intern(rcl_name_table_t * table, const char * name)
+{
+  size_t length;
+  size_t hash = _hash(name, &length);
+  rcl_allocator_t allocator = table->allocator;
+
+  // Allocate up front, the lock is never held across a call to the allocator
+  rcl_name_table_entry_t * new_entry = allocator.allocate(
+    sizeof(rcl_name_table_entry_t) + length + 1u, allocator.state);
+  if (NULL == new_entry) {
+    RCL_SET_ERROR_MSG("allocating memory for an interned name failed");
+    return NULL;
+  }
+  new_entry->table = table;
+  new_entry->allocator = allocator;
+  new_entry->reference_count = 1u;
+  new_entry->hash = hash;
+  new_entry->length = length;
+  memcpy(new_entry->name, name, length + 1u);
+
+  rcl_name_table_entry_t ** new_buckets = NULL;
+  size_t new_bucket_count = 0u;
+  const char * interned_name = NULL;
+  _lock();
+  while (table->entry_count >= table->bucket_count) {
+    if (NULL != new_buckets && new_bucket_count > table->bucket_count) {
+      new_buckets = _rehash(table, new_buckets, new_bucket_count);
+      break;
+    }
+    // Grow outside of the lock, then check again as another thread may have grown it
+    new_bucket_count = 0u == table->bucket_count ?
+      RCL_NAME_TABLE_INITIAL_BUCKET_COUNT : table->bucket_count * 2u;
+    _unlock();
+    if (NULL != new_buckets) {
+      allocator.deallocate(new_buckets, allocator.state);
+    }
+    new_buckets = allocator.zero_allocate(
+      new_bucket_count, sizeof(rcl_name_table_entry_t *), allocator.state);
+    _lock();
+    if (NULL == new_buckets) {
+      // Best effort once there are buckets: a failure only makes chains longer
+      break;
+    }
+  }
+  if (0u == table->bucket_count) {
+    _unlock();
+    allocator.deallocate(new_entry, allocator.state);
+    RCL_SET_ERROR_MSG("allocating memory for the name table failed");
+    return NULL;
+  }
+  size_t index = hash & (table->bucket_count - 1u);
+  for (rcl_name_table_entry_t * entry = table->buckets[index]; NULL != entry;
+    entry = entry->next)
+  {
+    if (entry->hash == hash && entry->length == length && 0 == memcmp(entry->name, name, length)) {
+      ++entry->reference_count;
+      interned_name = entry->name;
+      break;
+    }
+  }
+  if (NULL == interned_name) {
+    new_entry->next = table->buckets[index];
+    table->buckets[index] = new_entry;
+    ++table->entry_count;
+    interned_name = new_entry->name;
+    new_entry = NULL;
+  }
+  _unlock();
+  // Unused, or replaced by the grown buckets
+  if (NULL != new_buckets) {
+    allocator.deallocate(new_buckets, allocator.state);
+  }
+  if (NULL != new_entry) {
+    allocator.deallocate(new_entry, allocator.state);
+  }
+  return interned_name;
+}
+
+void
+rcl_name_table_release(const char * interned_name)
+{
+  rcl_name_table_entry_t * entry = _entry_of(interned_name);
+  // The count is dropped with the lock held, so a concurrent intern cannot revive the entry
+  _lock();
+  bool unused = 0u == --entry->reference_count;
+  rcl_name_table_t * table = entry->table;
+  // Unless detached by rcl_name_table_fini(), which is serialized by the same lock
+  if (unused && NULL != table) {
+    rcl_name_table_entry_t ** link = &table->buckets[entry->hash & (table->bucket_count - 1u)];
+    while (*link != entry) {
+      link = &(*link)->next;
+    }
+    *link = entry->next;
+    --table->entry_count;
+  }
+  _unlock();
+  if (unused) {
+    entry->allocator.deallocate(entry, entry->allocator.state);
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
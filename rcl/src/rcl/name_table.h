@@ -0,0 +1,83 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__NAME_TABLE_H_
+#define RCL__NAME_TABLE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "rcl/allocator.h"
+
+typedef struct rcl_name_table_entry_s rcl_name_table_entry_t;
+
+/// Table of interned names, shared by everything created in a context.
+/**
+ * Equal names share one immutable, reference counted entry, so a name used
+ * by many handles is only stored once.
+ *
+ * Entries are chained in buckets indexed by the hash of the name.
+ * Names are only interned to share their memory, they are still compared by content.
+ *
+ * All tables are guarded by a single process wide spin lock, which outlives them,
+ * so a name may be released while the context holding its table is finalized.
+ * It is only held to look a name up, insert or remove it, which only happens
+ * when entities are created or destroyed.
+ * The allocator is never called with the lock held.
+ */
+typedef struct rcl_name_table_s
+{
+  /// Allocator for the buckets and the entries
+  rcl_allocator_t allocator;
+  /// Buckets, `bucket_count` long, `NULL` until the first name is interned
+  rcl_name_table_entry_t ** buckets;
+  /// Number of buckets, a power of two
+  size_t bucket_count;
+  /// Number of entries in the table
+  size_t entry_count;
+} rcl_name_table_t;
+
+/// Initialize a zero initialized name table.
+void
+rcl_name_table_init(rcl_name_table_t * table, rcl_allocator_t allocator);
+
+/// Release the table.
+/**
+ * Names still in use are detached from the table and released by their last
+ * call to rcl_name_table_release().
+ */
+void
+rcl_name_table_fini(rcl_name_table_t * table);
+
+/// Get the interned copy of `name`, taking a reference on it.
+/**
+ * \return the interned name, equal to `name`, or
+ * \return `NULL` if allocating memory failed, with the error set.
+ */
+const char *
+rcl_name_table_intern(rcl_name_table_t * table, const char * name);
+
+/// Drop a reference on an interned name, removing it once unused.
+void
+rcl_name_table_release(const char * interned_name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__NAME_TABLE_H_
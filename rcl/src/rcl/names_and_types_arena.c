@@ -0,0 +1,198 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/graph.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "rcl/error_handling.h"
+#include "rcutils/macros.h"
+
+rcl_names_and_types_arena_t
+rcl_get_zero_initialized_names_and_types_arena(void)
+{
+  rcl_names_and_types_arena_t zero_arena = {
+    .names_and_types = rcl_get_zero_initialized_names_and_types(),
+    .block = NULL,
+    .allocator = rcutils_get_zero_initialized_allocator(),
+  };
+  return zero_arena;
+}
+
+// Whether `name` ends with `suffix`, if so `length` is set to the length of `name` without it.
+static
+bool
+_length_without_suffix(
+  const char * name,
+  size_t name_length,
+  const char * suffix,
+  size_t suffix_length,
+  size_t * length)
+{
+  if (name_length < suffix_length ||
+    0 != memcmp(name + name_length - suffix_length, suffix, suffix_length))
+  {
+    return false;
+  }
+  *length = name_length - suffix_length;
+  return true;
+}
+
+// Length of `type` once `suffix` is trimmed from it, if it ends with it.
+static
+size_t
+_trimmed_type_length(const char * type, const char * suffix, size_t suffix_length)
+{
+  size_t type_length = strlen(type);
+  if (NULL == suffix) {
+    return type_length;
+  }
+  size_t trimmed_length;
+  if (!_length_without_suffix(type, type_length, suffix, suffix_length, &trimmed_length)) {
+    return type_length;
+  }
+  return trimmed_length;
+}
+
+rcl_ret_t
+rcl_names_and_types_arena_copy(
+  const rcl_names_and_types_t * names_and_types,
+  const char * name_suffix,
+  const char * type_suffix,
+  rcl_allocator_t * allocator,
+  rcl_names_and_types_arena_t * arena)
+{
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCL_RET_INVALID_ARGUMENT);
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCL_RET_BAD_ALLOC);
+
+  RCL_CHECK_ARGUMENT_FOR_NULL(names_and_types, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(arena, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != arena->block || 0u != arena->names_and_types.names.size) {
+    RCL_SET_ERROR_MSG("arena is not zero initialized");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  const size_t name_suffix_length = NULL != name_suffix ? strlen(name_suffix) : 0u;
+  const size_t type_suffix_length = NULL != type_suffix ? strlen(type_suffix) : 0u;
+
+  // First pass, measure what is kept so that everything fits in one block
+  size_t name_count = 0u;
+  size_t type_count = 0u;
+  size_t string_bytes = 0u;
+  for (size_t i = 0u; i < names_and_types->names.size; ++i) {
+    const char * name = names_and_types->names.data[i];
+    size_t name_length = strlen(name);
+    if (NULL != name_suffix &&
+      !_length_without_suffix(name, name_length, name_suffix, name_suffix_length, &name_length))
+    {
+      continue;
+    }
+    ++name_count;
+    string_bytes += name_length + 1u;
+    const rcutils_string_array_t * types = &names_and_types->types[i];
+    type_count += types->size;
+    for (size_t k = 0u; k < types->size; ++k) {
+      if (NULL != types->data[k]) {
+        string_bytes += _trimmed_type_length(types->data[k], type_suffix, type_suffix_length) + 1u;
+      }
+    }
+  }
+
+  *arena = rcl_get_zero_initialized_names_and_types_arena();
+  arena->allocator = *allocator;
+  if (0u == name_count) {
+    return RCL_RET_OK;
+  }
+
+  // The type arrays come first, as they have the strictest alignment
+  const size_t types_bytes = name_count * sizeof(rcutils_string_array_t);
+  const size_t name_pointers_bytes = name_count * sizeof(char *);
+  const size_t type_pointers_bytes = type_count * sizeof(char *);
+  char * block = allocator->allocate(
+    types_bytes + name_pointers_bytes + type_pointers_bytes + string_bytes, allocator->state);
+  if (NULL == block) {
+    RCL_SET_ERROR_MSG("allocating memory for names and types failed");
+    return RCL_RET_BAD_ALLOC;
+  }
+  rcutils_string_array_t * types_out = (rcutils_string_array_t *)block;
+  char ** names_out = (char **)(block + types_bytes);
+  char ** type_pointers = (char **)(block + types_bytes + name_pointers_bytes);
+  char * strings = block + types_bytes + name_pointers_bytes + type_pointers_bytes;
+
+  // Second pass, fill the block
+  size_t j = 0u;
+  for (size_t i = 0u; i < names_and_types->names.size; ++i) {
+    const char * name = names_and_types->names.data[i];
+    size_t name_length = strlen(name);
+    if (NULL != name_suffix &&
+      !_length_without_suffix(name, name_length, name_suffix, name_suffix_length, &name_length))
+    {
+      continue;
+    }
+    memcpy(strings, name, name_length);
+    strings[name_length] = '\0';
+    names_out[j] = strings;
+    strings += name_length + 1u;
+
+    const rcutils_string_array_t * types = &names_and_types->types[i];
+    // A zero allocator makes rcutils_string_array_fini() refuse these arrays
+    types_out[j] = rcutils_get_zero_initialized_string_array();
+    types_out[j].size = types->size;
+    types_out[j].data = types->size > 0u ? type_pointers : NULL;
+    for (size_t k = 0u; k < types->size; ++k) {
+      const char * type = types->data[k];
+      if (NULL == type) {
+        *type_pointers++ = NULL;
+        continue;
+      }
+      size_t type_length = _trimmed_type_length(type, type_suffix, type_suffix_length);
+      memcpy(strings, type, type_length);
+      strings[type_length] = '\0';
+      *type_pointers++ = strings;
+      strings += type_length + 1u;
+    }
+    ++j;
+  }
+
+  arena->block = block;
+  arena->names_and_types.names.size = name_count;
+  arena->names_and_types.names.data = names_out;
+  arena->names_and_types.types = types_out;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_names_and_types_arena_fini(rcl_names_and_types_arena_t * arena)
+{
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCL_RET_INVALID_ARGUMENT);
+
+  RCL_CHECK_ARGUMENT_FOR_NULL(arena, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != arena->block) {
+    RCL_CHECK_ALLOCATOR_WITH_MSG(
+      &arena->allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+    arena->allocator.deallocate(arena->block, arena->allocator.state);
+  }
+  *arena = rcl_get_zero_initialized_names_and_types_arena();
+  return RCL_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -52,6 +52,7 @@ extern "C"
 #include "tracetools/tracetools.h"
 
 #include "./context_impl.h"
+#include "./guard_condition_impl.h"
 
 const char * const RCL_DISABLE_LOANED_MESSAGES_ENV_VAR = "ROS_DISABLE_LOANED_MESSAGES";
 
@@ -127,6 +128,7 @@ rcl_node_init(
   rcl_ret_t ret;
   rcl_ret_t fail_ret = RCL_RET_ERROR;
   char * remapped_node_name = NULL;
+  const char * logger_name = NULL;
 
   // Check options and allocator first, so allocator can be used for errors.
   RCL_CHECK_ARGUMENT_FOR_NULL(options, RCL_RET_INVALID_ARGUMENT);
@@ -248,10 +250,13 @@ rcl_node_init(
     node->impl->fq_name = rcutils_format_string(*allocator, "%s/%s", local_namespace_, name);
   }
 
-  // node logger name
-  node->impl->logger_name = rcl_create_node_logger_name(name, local_namespace_, allocator);
+  // node logger name, interned so nodes sharing it share its storage
+  logger_name = rcl_create_node_logger_name(name, local_namespace_, allocator);
+  RCL_CHECK_FOR_NULL_WITH_MSG(logger_name, "creating logger name failed", goto fail);
+  node->impl->logger_name = rcl_name_table_intern(&context->impl->name_table, logger_name);
+  allocator->deallocate((char *)logger_name, allocator->state);
   RCL_CHECK_FOR_NULL_WITH_MSG(
-    node->impl->logger_name, "creating logger name failed", goto fail);
+    node->impl->logger_name, "interning logger name failed", goto fail);
 
   RCUTILS_LOG_DEBUG_NAMED(
     ROS_PACKAGE_NAME, "Using domain ID of '%zu'", context->impl->rmw_context.actual_domain_id);
@@ -284,6 +289,9 @@ rcl_node_init(
     // error message already set
     goto fail;
   }
+  // Graph changes seen through this node also move the graph version of the context.
+  node->impl->graph_guard_condition->impl->shared_trigger_count =
+    &context->impl->graph_cache.version;
   // The initialization for the rosout publisher requires the node to be in initialized to a point
   // that it can create new topic publishers
   if (rcl_logging_rosout_enabled() && node->impl->options.enable_rosout) {
@@ -312,7 +320,9 @@ fail:
       RCUTILS_LOG_ERROR_EXPRESSION_NAMED(
         (ret != RCL_RET_OK && ret != RCL_RET_NOT_INIT),
         ROS_PACKAGE_NAME, "Failed to fini publisher for node: %i", ret);
-      allocator->deallocate((char *)node->impl->logger_name, allocator->state);
+    }
+    if (node->impl->logger_name) {
+      rcl_name_table_release(node->impl->logger_name);
     }
     if (node->impl->fq_name) {
       allocator->deallocate((char *)node->impl->fq_name, allocator->state);
@@ -393,7 +403,7 @@ rcl_node_fini(rcl_node_t * node)
   }
   allocator.deallocate(node->impl->graph_guard_condition, allocator.state);
   // assuming that allocate and deallocate are ok since they are checked in init
-  allocator.deallocate((char *)node->impl->logger_name, allocator.state);
+  rcl_name_table_release(node->impl->logger_name);
   allocator.deallocate((char *)node->impl->fq_name, allocator.state);
   if (NULL != node->impl->options.arguments.impl) {
     rcl_ret_t ret = rcl_arguments_fini(&(node->impl->options.arguments));
@@ -508,6 +518,17 @@ rcl_node_get_graph_guard_condition(const rcl_node_t * node)
   return node->impl->graph_guard_condition;
 }
 
+rcl_ret_t
+rcl_node_get_graph_version(const rcl_node_t * node, uint64_t * version)
+{
+  if (!rcl_node_is_valid_except_context(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(version, RCL_RET_INVALID_ARGUMENT);
+  *version = rcutils_atomic_load_uint64_t(&node->impl->graph_guard_condition->impl->trigger_count);
+  return RCL_RET_OK;
+}
+
 const char *
 rcl_node_get_logger_name(const rcl_node_t * node)
 {
@@ -15,13 +15,18 @@
 #include "rcl/remap.h"
 
 #include "./arguments_impl.h"
+#include "./common.h"
 #include "./remap_impl.h"
+#include "./remap_trie.h"
 #include "rcl/error_handling.h"
 #include "rcl/expand_topic_name.h"
 #include "rcutils/allocator.h"
 #include "rcutils/macros.h"
 #include "rcutils/strdup.h"
 #include "rcutils/types/string_map.h"
+#include "rmw/error_handling.h"
+#include "rmw/validate_namespace.h"
+#include "rmw/validate_node_name.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -97,6 +102,45 @@ fail:
   return RCL_RET_BAD_ALLOC;
 }
 
+/// Get the first matching topic or service rule from the trie of a chain.
+/// \return RCL_RET_OK if no errors occurred while searching for a rule
+static
+rcl_ret_t
+rcl_remap_first_trie_match(
+  rcl_remap_t * remap_rules,
+  const rcl_remap_trie_t * remap_trie,
+  rcl_remap_type_t type_bitmask,
+  const char * name,
+  const char * node_name,
+  const char * node_namespace,
+  rcl_remap_t ** output_rule)
+{
+  // the names the matches are expanded with are validated as rcl_expand_topic_name() does
+  int validation_result;
+  rmw_ret_t rmw_ret = rmw_validate_node_name(node_name, &validation_result, NULL);
+  if (RMW_RET_OK != rmw_ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  if (RMW_NODE_NAME_VALID != validation_result) {
+    RCL_SET_ERROR_MSG("node name is invalid");
+    return RCL_RET_NODE_INVALID_NAME;
+  }
+  rmw_ret = rmw_validate_namespace(node_namespace, &validation_result, NULL);
+  if (RMW_RET_OK != rmw_ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  if (RMW_NAMESPACE_VALID != validation_result) {
+    RCL_SET_ERROR_MSG("node namespace is invalid");
+    return RCL_RET_NODE_INVALID_NAMESPACE;
+  }
+  int index = rcl_remap_trie_first_match(
+    remap_trie, remap_rules, type_bitmask, name, node_name, node_namespace);
+  *output_rule = index < 0 ? NULL : &remap_rules[index];
+  return RCL_RET_OK;
+}
+
 /// Get the first matching rule in a chain.
 /// \return RCL_RET_OK if no errors occurred while searching for a rule
 static
@@ -104,6 +148,7 @@ rcl_ret_t
 rcl_remap_first_match(
   rcl_remap_t * remap_rules,
   int num_rules,
+  const rcl_remap_trie_t * remap_trie,
   rcl_remap_type_t type_bitmask,
   const char * name,
   const char * node_name,
@@ -113,6 +158,13 @@ rcl_remap_first_match(
   rcl_remap_t ** output_rule)
 {
   *output_rule = NULL;
+  if (
+    NULL != remap_trie && NULL != name &&
+    (type_bitmask & (RCL_TOPIC_REMAP | RCL_SERVICE_REMAP)))
+  {
+    return rcl_remap_first_trie_match(
+      remap_rules, remap_trie, type_bitmask, name, node_name, node_namespace, output_rule);
+  }
   for (int i = 0; i < num_rules; ++i) {
     rcl_remap_t * rule = &(remap_rules[i]);
     if (!(rule->impl->type & type_bitmask)) {
@@ -126,10 +178,29 @@ rcl_remap_first_match(
     bool matched = false;
     if (rule->impl->type & (RCL_TOPIC_REMAP | RCL_SERVICE_REMAP)) {
       // topic and service rules need the match side to be expanded to a FQN
-      char * expanded_match = NULL;
-      rcl_ret_t ret = rcl_expand_topic_name(
-        rule->impl->match, node_name, node_namespace,
-        substitutions, allocator, &expanded_match);
+      // it is expanded on the stack, as this is done for every rule
+      char expanded_match[RCL_EXPANDED_TOPIC_NAME_BUFFER_SIZE];
+      size_t expanded_length = 0u;
+      rcl_ret_t ret = rcl_expand_topic_name_to_buffer(
+        rule->impl->match, node_name, node_namespace, substitutions,
+        expanded_match, sizeof(expanded_match), &expanded_length);
+      if (RCL_RET_INVALID_ARGUMENT == ret) {
+        // longer than any name rmw accepts, but it may still match a name to be remapped
+        rcl_reset_error();
+        char * long_expanded_match = NULL;
+        ret = rcl_expand_topic_name(
+          rule->impl->match, node_name, node_namespace,
+          substitutions, allocator, &long_expanded_match);
+        if (RCL_RET_OK == ret) {
+          matched = NULL != name && 0 == strcmp(long_expanded_match, name);
+          allocator.deallocate(long_expanded_match, allocator.state);
+          if (matched) {
+            *output_rule = rule;
+            break;
+          }
+          continue;
+        }
+      }
       if (RCL_RET_OK != ret) {
         rcl_reset_error();
         if (
@@ -148,7 +219,6 @@ rcl_remap_first_match(
         // and rcl_remap_name are not public.
         matched = (0 == strcmp(expanded_match, name));
       }
-      allocator.deallocate(expanded_match, allocator.state);
     } else {
       // nodename and namespace replacement apply if the type and node name prefix checks passed
       matched = true;
@@ -194,8 +264,9 @@ rcl_remap_name(
   // Look at local rules first
   if (NULL != local_arguments) {
     rcl_ret_t ret = rcl_remap_first_match(
-      local_arguments->impl->remap_rules, local_arguments->impl->num_remap_rules, type_bitmask,
-      name, node_name, node_namespace, substitutions, allocator, &rule);
+      local_arguments->impl->remap_rules, local_arguments->impl->num_remap_rules,
+      local_arguments->impl->remap_trie, type_bitmask, name, node_name, node_namespace,
+      substitutions, allocator, &rule);
     if (ret != RCL_RET_OK) {
       return ret;
     }
@@ -203,8 +274,9 @@ rcl_remap_name(
   // Check global rules if no local rule matched
   if (NULL == rule && NULL != global_arguments) {
     rcl_ret_t ret = rcl_remap_first_match(
-      global_arguments->impl->remap_rules, global_arguments->impl->num_remap_rules, type_bitmask,
-      name, node_name, node_namespace, substitutions, allocator, &rule);
+      global_arguments->impl->remap_rules, global_arguments->impl->num_remap_rules,
+      global_arguments->impl->remap_trie, type_bitmask, name, node_name, node_namespace,
+      substitutions, allocator, &rule);
     if (ret != RCL_RET_OK) {
       return ret;
     }
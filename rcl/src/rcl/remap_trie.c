@@ -0,0 +1,361 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./remap_trie.h"
+
+#include <limits.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "rcl/error_handling.h"
+
+static
+void
+_node_fini(rcl_remap_trie_node_t * node, rcl_allocator_t * allocator)
+{
+  for (size_t i = 0u; i < node->child_count; ++i) {
+    _node_fini(&node->children[i], allocator);
+  }
+  if (NULL != node->wild_one) {
+    _node_fini(node->wild_one, allocator);
+    allocator->deallocate(node->wild_one, allocator->state);
+  }
+  if (NULL != node->wild_multi) {
+    _node_fini(node->wild_multi, allocator);
+    allocator->deallocate(node->wild_multi, allocator->state);
+  }
+  allocator->deallocate(node->children, allocator->state);
+  allocator->deallocate(node->rules, allocator->state);
+  allocator->deallocate(node->token, allocator->state);
+  memset(node, 0, sizeof(*node));
+}
+
+// Compare a token with the token of a node, shorter tokens first.
+static
+int
+_compare_token(const rcl_remap_trie_node_t * node, const char * token, size_t token_length)
+{
+  if (node->token_length != token_length) {
+    return node->token_length < token_length ? -1 : 1;
+  }
+  return memcmp(node->token, token, token_length);
+}
+
+// Index of the child with the given token, or of where it would be inserted.
+static
+size_t
+_lower_bound(const rcl_remap_trie_node_t * node, const char * token, size_t token_length)
+{
+  size_t low = 0u;
+  size_t high = node->child_count;
+  while (low < high) {
+    size_t middle = low + (high - low) / 2u;
+    if (_compare_token(&node->children[middle], token, token_length) < 0) {
+      low = middle + 1u;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+static
+const rcl_remap_trie_node_t *
+_find_child(const rcl_remap_trie_node_t * node, const char * token, size_t token_length)
+{
+  size_t i = _lower_bound(node, token, token_length);
+  if (i < node->child_count && 0 == _compare_token(&node->children[i], token, token_length)) {
+    return &node->children[i];
+  }
+  return NULL;
+}
+
+static
+rcl_remap_trie_node_t *
+_get_or_add_wildcard(rcl_remap_trie_node_t ** wildcard, rcl_allocator_t * allocator)
+{
+  if (NULL == *wildcard) {
+    *wildcard = allocator->zero_allocate(1u, sizeof(rcl_remap_trie_node_t), allocator->state);
+  }
+  return *wildcard;
+}
+
+static
+rcl_remap_trie_node_t *
+_get_or_add_child(
+  rcl_remap_trie_node_t * node,
+  const char * token,
+  size_t token_length,
+  rcl_allocator_t * allocator)
+{
+  if (2u == token_length && 0 == memcmp(token, "**", 2u)) {
+    return _get_or_add_wildcard(&node->wild_multi, allocator);
+  }
+  if (1u == token_length && '*' == token[0]) {
+    return _get_or_add_wildcard(&node->wild_one, allocator);
+  }
+  size_t i = _lower_bound(node, token, token_length);
+  if (i < node->child_count && 0 == _compare_token(&node->children[i], token, token_length)) {
+    return &node->children[i];
+  }
+  if (node->child_count == node->child_capacity) {
+    size_t capacity = 0u == node->child_capacity ? 4u : node->child_capacity * 2u;
+    rcl_remap_trie_node_t * children = allocator->reallocate(
+      node->children, capacity * sizeof(rcl_remap_trie_node_t), allocator->state);
+    if (NULL == children) {
+      return NULL;
+    }
+    node->children = children;
+    node->child_capacity = capacity;
+  }
+  char * token_copy = allocator->allocate(token_length, allocator->state);
+  if (NULL == token_copy) {
+    return NULL;
+  }
+  memcpy(token_copy, token, token_length);
+  memmove(
+    &node->children[i + 1u], &node->children[i],
+    (node->child_count - i) * sizeof(rcl_remap_trie_node_t));
+  ++node->child_count;
+  rcl_remap_trie_node_t * child = &node->children[i];
+  memset(child, 0, sizeof(*child));
+  child->token = token_copy;
+  child->token_length = token_length;
+  return child;
+}
+
+static
+rcl_ret_t
+_insert(rcl_remap_trie_t * trie, const char * match, int rule_index)
+{
+  rcl_remap_trie_node_t * node = &trie->relative;
+  if (0 == strncmp(match, "~/", 2u)) {
+    node = &trie->private_names;
+    match += 2;
+  } else if ('/' == match[0]) {
+    node = &trie->fully_qualified;
+    match += 1;
+  }
+  // the lexer guarantees tokens are separated by exactly one '/'
+  while (NULL != node && '\0' != *match) {
+    const char * end = strchr(match, '/');
+    size_t token_length = NULL != end ? (size_t)(end - match) : strlen(match);
+    node = _get_or_add_child(node, match, token_length, &trie->allocator);
+    match += token_length + (NULL != end ? 1u : 0u);
+  }
+  if (NULL == node) {
+    RCL_SET_ERROR_MSG("allocating memory for the remap trie failed");
+    return RCL_RET_BAD_ALLOC;
+  }
+  if (node->rule_count == node->rule_capacity) {
+    size_t capacity = 0u == node->rule_capacity ? 1u : node->rule_capacity * 2u;
+    int * rules = trie->allocator.reallocate(
+      node->rules, capacity * sizeof(int), trie->allocator.state);
+    if (NULL == rules) {
+      RCL_SET_ERROR_MSG("allocating memory for the remap trie failed");
+      return RCL_RET_BAD_ALLOC;
+    }
+    node->rules = rules;
+    node->rule_capacity = capacity;
+  }
+  // rules are inserted in order, so this keeps them sorted
+  node->rules[node->rule_count++] = rule_index;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_remap_trie_init(
+  const rcl_remap_t * rules,
+  int num_rules,
+  rcl_allocator_t allocator,
+  rcl_remap_trie_t ** trie)
+{
+  *trie = NULL;
+  bool has_name_rule = false;
+  for (int i = 0; i < num_rules && !has_name_rule; ++i) {
+    has_name_rule = NULL != rules[i].impl->match;
+  }
+  if (!has_name_rule) {
+    return RCL_RET_OK;
+  }
+  rcl_remap_trie_t * new_trie = allocator.zero_allocate(
+    1u, sizeof(rcl_remap_trie_t), allocator.state);
+  if (NULL == new_trie) {
+    RCL_SET_ERROR_MSG("allocating memory for the remap trie failed");
+    return RCL_RET_BAD_ALLOC;
+  }
+  new_trie->allocator = allocator;
+  for (int i = 0; i < num_rules; ++i) {
+    if (NULL == rules[i].impl->match) {
+      // node name and namespace rules have no match side
+      continue;
+    }
+    rcl_ret_t ret = _insert(new_trie, rules[i].impl->match, i);
+    if (RCL_RET_OK != ret) {
+      rcl_remap_trie_fini(new_trie);
+      return ret;
+    }
+  }
+  *trie = new_trie;
+  return RCL_RET_OK;
+}
+
+void
+rcl_remap_trie_fini(rcl_remap_trie_t * trie)
+{
+  if (NULL == trie) {
+    return;
+  }
+  rcl_allocator_t allocator = trie->allocator;
+  _node_fini(&trie->fully_qualified, &allocator);
+  _node_fini(&trie->relative, &allocator);
+  _node_fini(&trie->private_names, &allocator);
+  allocator.deallocate(trie, allocator.state);
+}
+
+typedef struct _match_context_s
+{
+  const rcl_remap_t * rules;
+  rcl_remap_type_t type_bitmask;
+  const char * node_name;
+  /// Index of the best rule found so far, INT_MAX if none
+  int best;
+} _match_context_t;
+
+// Keep the first rule ending at this node that applies, if it comes before the best one.
+static
+void
+_check_rules(const rcl_remap_trie_node_t * node, _match_context_t * context)
+{
+  for (size_t i = 0u; i < node->rule_count && node->rules[i] < context->best; ++i) {
+    const rcl_remap_impl_t * rule = context->rules[node->rules[i]].impl;
+    if (!(rule->type & context->type_bitmask)) {
+      continue;
+    }
+    if (NULL != rule->node_name && 0 != strcmp(rule->node_name, context->node_name)) {
+      continue;
+    }
+    context->best = node->rules[i];
+    return;
+  }
+}
+
+// Get the next token of a name, `*name` being `NULL` once every token was consumed.
+static
+bool
+_next_token(const char ** name, const char ** token, size_t * token_length)
+{
+  const char * end = strchr(*name, '/');
+  *token = *name;
+  *token_length = NULL != end ? (size_t)(end - *name) : strlen(*name);
+  *name = NULL != end ? end + 1 : NULL;
+  // empty tokens, as in `//`, cannot be matched by any rule
+  return *token_length > 0u;
+}
+
+// Match the remaining tokens of a name, `NULL` if there are none, from a node.
+static
+void
+_match(const rcl_remap_trie_node_t * node, const char * name, _match_context_t * context)
+{
+  if (NULL == name) {
+    _check_rules(node, context);
+    if (NULL != node->wild_multi) {
+      _match(node->wild_multi, NULL, context);
+    }
+    return;
+  }
+  const char * rest = name;
+  const char * token;
+  size_t token_length;
+  if (!_next_token(&rest, &token, &token_length)) {
+    return;
+  }
+  const rcl_remap_trie_node_t * child = _find_child(node, token, token_length);
+  if (NULL != child) {
+    _match(child, rest, context);
+  }
+  if (NULL != node->wild_one) {
+    _match(node->wild_one, rest, context);
+  }
+  if (NULL != node->wild_multi) {
+    // `**` consumes zero or more tokens
+    _match(node->wild_multi, name, context);
+    _match(node->wild_multi, rest, context);
+    while (NULL != rest && _next_token(&rest, &token, &token_length)) {
+      _match(node->wild_multi, rest, context);
+    }
+  }
+}
+
+// Skip `prefix` and the '/' following it at the start of a name.
+static
+bool
+_skip_prefix(const char ** name, const char * prefix, size_t prefix_length)
+{
+  if (NULL == *name || 0 != strncmp(*name, prefix, prefix_length)) {
+    return false;
+  }
+  if ('\0' == (*name)[prefix_length]) {
+    *name = NULL;
+    return true;
+  }
+  if ('/' == (*name)[prefix_length]) {
+    *name += prefix_length + 1u;
+    return true;
+  }
+  return false;
+}
+
+int
+rcl_remap_trie_first_match(
+  const rcl_remap_trie_t * trie,
+  const rcl_remap_t * rules,
+  rcl_remap_type_t type_bitmask,
+  const char * name,
+  const char * node_name,
+  const char * node_namespace)
+{
+  _match_context_t context = {rules, type_bitmask, node_name, INT_MAX};
+  if ('/' != name[0]) {
+    // only fully qualified names can be matched
+    return -1;
+  }
+
+  const char * rest = '\0' == name[1] ? NULL : name + 1;
+  _match(&trie->fully_qualified, rest, &context);
+
+  // the namespace '/' needs no separator
+  bool in_namespace = true;
+  if ('\0' != node_namespace[1]) {
+    rest = name;
+    in_namespace = _skip_prefix(&rest, node_namespace, strlen(node_namespace));
+  }
+  if (in_namespace) {
+    _match(&trie->relative, rest, &context);
+    if (_skip_prefix(&rest, node_name, strlen(node_name))) {
+      _match(&trie->private_names, rest, &context);
+    }
+  }
+  return INT_MAX == context.best ? -1 : context.best;
+}
+
+#ifdef __cplusplus
+}
+#endif
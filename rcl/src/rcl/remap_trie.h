@@ -0,0 +1,125 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__REMAP_TRIE_H_
+#define RCL__REMAP_TRIE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "rcl/allocator.h"
+#include "rcl/remap.h"
+#include "rcl/types.h"
+
+#include "./remap_impl.h"
+
+typedef struct rcl_remap_trie_node_s rcl_remap_trie_node_t;
+
+/// Node of a remap trie, reached from its parent by one token of the match side of rules.
+struct rcl_remap_trie_node_s
+{
+  /// Token leading to this node, not null terminated, `NULL` for roots and wildcards
+  char * token;
+  /// Length of the token
+  size_t token_length;
+  /// Children reached by a token, sorted by token
+  rcl_remap_trie_node_t * children;
+  /// Number of children
+  size_t child_count;
+  /// Capacity of the children array
+  size_t child_capacity;
+  /// Child reached by `*`, matching exactly one token
+  rcl_remap_trie_node_t * wild_one;
+  /// Child reached by `**`, matching zero or more tokens
+  rcl_remap_trie_node_t * wild_multi;
+  /// Indices of the rules whose match ends at this node, in increasing order
+  int * rules;
+  /// Number of rules
+  size_t rule_count;
+  /// Capacity of the rules array
+  size_t rule_capacity;
+};
+
+/// Topic and service remap rules of a set of arguments, indexed by the tokens of their match.
+/**
+ * Matches are split in three tries depending on how they are expanded:
+ * fully qualified ones (`/foo`), relative ones (`foo`) which are prefixed by
+ * the namespace of the node, and private ones (`~/foo`) which are prefixed by
+ * the namespace and the name of the node.
+ * A name is looked up by walking its tokens down each trie once, so the cost
+ * depends on the number of tokens of the name rather than on the number of rules.
+ */
+typedef struct rcl_remap_trie_s
+{
+  /// Allocator used for the nodes
+  rcl_allocator_t allocator;
+  /// Root of the fully qualified matches
+  rcl_remap_trie_node_t fully_qualified;
+  /// Root of the matches relative to the node namespace
+  rcl_remap_trie_node_t relative;
+  /// Root of the private matches
+  rcl_remap_trie_node_t private_names;
+} rcl_remap_trie_t;
+
+/// Compile the topic and service rules of an array of remap rules into a trie.
+/**
+ * \param[in] rules remap rules, which must outlive the trie
+ * \param[in] num_rules number of rules
+ * \param[in] allocator allocator for the trie
+ * \param[out] trie the new trie, or `NULL` if there is no topic or service rule
+ * \return #RCL_RET_OK if the trie was built, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed.
+ */
+rcl_ret_t
+rcl_remap_trie_init(
+  const rcl_remap_t * rules,
+  int num_rules,
+  rcl_allocator_t allocator,
+  rcl_remap_trie_t ** trie);
+
+/// Release a trie built by rcl_remap_trie_init(), `NULL` is ignored.
+void
+rcl_remap_trie_fini(rcl_remap_trie_t * trie);
+
+/// Find the first rule matching a fully qualified name.
+/**
+ * Does not allocate memory.
+ *
+ * \param[in] trie trie built from `rules`
+ * \param[in] rules the rules the trie was built from
+ * \param[in] type_bitmask types of rules to consider
+ * \param[in] name fully qualified name to match
+ * \param[in] node_name name of the node the name belongs to
+ * \param[in] node_namespace namespace of the node the name belongs to
+ * \return the index of the first matching rule, or
+ * \return -1 if no rule matches.
+ */
+int
+rcl_remap_trie_first_match(
+  const rcl_remap_trie_t * trie,
+  const rcl_remap_t * rules,
+  rcl_remap_type_t type_bitmask,
+  const char * name,
+  const char * node_name,
+  const char * node_namespace);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__REMAP_TRIE_H_
@@ -19,6 +19,7 @@ extern "C"
 
 #include "rcl/service.h"
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -29,6 +30,8 @@ extern "C"
 #include "rcl/types.h"
 #include "rcutils/logging_macros.h"
 #include "rcutils/macros.h"
+#include "rcutils/stdatomic_helper.h"
+#include "rcutils/time.h"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
 #include "service_msgs/msg/service_event_info.h"
@@ -37,6 +40,7 @@ extern "C"
 #include "rosidl_runtime_c/service_type_support_struct.h"
 
 #include "./common.h"
+#include "./context_impl.h"
 #include "./service_event_publisher.h"
 
 struct rcl_service_impl_s
@@ -46,7 +50,17 @@ struct rcl_service_impl_s
   rmw_qos_profile_t actual_response_publisher_qos;
   rmw_service_t * rmw_handle;
   rcl_service_event_publisher_t * service_event_publisher;
-  char * remapped_service_name;
+  rcl_service_introspection_sampling_options_t introspection_sampling_options;
+  const char * remapped_service_name;
+  rcl_service_backpressure_options_t backpressure_options;
+  // Requests notified by the middleware and taken since pending requests are tracked
+  atomic_uint_least64_t notified_request_count;
+  atomic_uint_least64_t taken_request_count;
+  atomic_uint_least64_t shed_request_count;
+  atomic_int_least64_t last_taken_request_age;
+  // User callback, forwarded to when pending requests are tracked
+  rcl_event_callback_t on_new_request_callback;
+  const void * on_new_request_user_data;
 };
 
 rcl_service_t
@@ -120,13 +134,14 @@ rcl_service_init(
     return RCL_RET_BAD_ALLOC;);
 
   // Expand and remap the given service name.
+  char * resolved_service_name = NULL;
   rcl_ret_t ret = rcl_node_resolve_name(
     node,
     service_name,
     *allocator,
     true,
     false,
-    &service->impl->remapped_service_name);
+    &resolved_service_name);
   if (ret != RCL_RET_OK) {
     if (ret == RCL_RET_SERVICE_NAME_INVALID || ret == RCL_RET_UNKNOWN_SUBSTITUTION) {
       ret = RCL_RET_SERVICE_NAME_INVALID;
@@ -136,8 +151,15 @@ rcl_service_init(
     goto free_service_impl;
   }
   RCUTILS_LOG_DEBUG_NAMED(
-    ROS_PACKAGE_NAME, "Expanded and remapped service name '%s'",
-    service->impl->remapped_service_name);
+    ROS_PACKAGE_NAME, "Expanded and remapped service name '%s'", resolved_service_name);
+  // Clients and services of the same name share one interned copy of it
+  service->impl->remapped_service_name =
+    rcl_name_table_intern(&node->context->impl->name_table, resolved_service_name);
+  allocator->deallocate(resolved_service_name, allocator->state);
+  if (NULL == service->impl->remapped_service_name) {
+    ret = RCL_RET_BAD_ALLOC;  // error already set
+    goto free_service_impl;
+  }
 
   if (RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL == options->qos.durability) {
     RCUTILS_LOG_WARN_NAMED(
@@ -186,6 +208,13 @@ rcl_service_init(
 
   // options
   service->impl->options = *options;
+  service->impl->introspection_sampling_options =
+    rcl_service_introspection_get_default_sampling_options();
+  service->impl->backpressure_options = rcl_service_get_default_backpressure_options();
+  atomic_init(&service->impl->notified_request_count, 0);
+  atomic_init(&service->impl->taken_request_count, 0);
+  atomic_init(&service->impl->shed_request_count, 0);
+  atomic_init(&service->impl->last_taken_request_age, 0);
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Service initialized");
   TRACEPOINT(
     rcl_service_init,
@@ -204,7 +233,7 @@ destroy_service:
   }
 
 free_remapped_service_name:
-  allocator->deallocate(service->impl->remapped_service_name, allocator->state);
+  rcl_name_table_release(service->impl->remapped_service_name);
   service->impl->remapped_service_name = NULL;
 
 free_service_impl:
@@ -248,7 +277,7 @@ rcl_service_fini(rcl_service_t * service, rcl_node_t * node)
       result = RCL_RET_ERROR;
     }
 
-    allocator.deallocate(service->impl->remapped_service_name, allocator.state);
+    rcl_name_table_release(service->impl->remapped_service_name);
     service->impl->remapped_service_name = NULL;
 
     allocator.deallocate(service->impl, allocator.state);
@@ -300,6 +329,83 @@ rcl_service_get_rmw_handle(const rcl_service_t * service)
   return service->impl->rmw_handle;
 }
 
+// Account for the requests notified before an empty take as taken.
+// The middleware may have dropped some of them, e.g. on KEEP_LAST overflow,
+// and without this the pending count would stay above zero for good.
+static
+void
+_resynchronize_pending_request_count(rcl_service_impl_t * impl, uint64_t notified)
+{
+  uint64_t taken = rcutils_atomic_load_uint64_t(&impl->taken_request_count);
+  while (taken < notified &&
+    !rcutils_atomic_compare_exchange_strong_uint_least64_t(
+      &impl->taken_request_count, &taken, notified))
+  {
+    // taken was updated by the failed exchange, try again
+  }
+}
+
+// Take the next request, discarding those which waited longer than allowed.
+static
+rcl_ret_t
+_take_request_with_shedding(
+  const rcl_service_t * service,
+  rmw_service_info_t * request_header,
+  void * ros_request,
+  bool * taken)
+{
+  rcl_service_impl_t * impl = service->impl;
+  const rcl_duration_value_t max_request_age = impl->backpressure_options.max_request_age;
+  const bool track_pending_requests = impl->backpressure_options.track_pending_requests;
+  for (;;) {
+    // Requests notified before an empty take are not pending anymore
+    uint64_t notified = rcutils_atomic_load_uint64_t(&impl->notified_request_count);
+    request_header->source_timestamp = 0;
+    request_header->received_timestamp = 0;
+    rmw_ret_t ret = rmw_take_request(impl->rmw_handle, request_header, ros_request, taken);
+    if (RMW_RET_OK != ret) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      if (RMW_RET_BAD_ALLOC == ret) {
+        return RCL_RET_BAD_ALLOC;
+      }
+      return RCL_RET_ERROR;
+    }
+    if (!*taken) {
+      if (track_pending_requests) {
+        _resynchronize_pending_request_count(impl, notified);
+      }
+      return RCL_RET_OK;
+    }
+    if (track_pending_requests) {
+      rcutils_atomic_fetch_add_uint64_t(&impl->taken_request_count, 1u);
+    }
+
+    // Requests are only aged when backpressure is configured, to keep the clock off the take path.
+    // Not every middleware provides source timestamps, those requests are never shed.
+    if (
+      (max_request_age <= 0 && !track_pending_requests) ||
+      0 == request_header->source_timestamp)
+    {
+      return RCL_RET_OK;
+    }
+    rcutils_time_point_value_t now;
+    if (RCUTILS_RET_OK != rcutils_system_time_now(&now)) {
+      rcutils_reset_error();
+      return RCL_RET_OK;
+    }
+    // Comparing clocks of different hosts, so skew between them adds to the age
+    const rcl_duration_value_t request_age = now - request_header->source_timestamp;
+    rcutils_atomic_store(&impl->last_taken_request_age, request_age);
+    if (max_request_age <= 0 || request_age <= max_request_age) {
+      return RCL_RET_OK;
+    }
+    rcutils_atomic_fetch_add_uint64_t(&impl->shed_request_count, 1u);
+    RCUTILS_LOG_DEBUG_NAMED(
+      ROS_PACKAGE_NAME, "Service shed request %" PRId64 " after waiting %" PRId64 " ns",
+      request_header->request_id.sequence_number, request_age);
+  }
+}
+
 rcl_ret_t
 rcl_take_request_with_info(
   const rcl_service_t * service,
@@ -316,14 +422,9 @@ rcl_take_request_with_info(
   RCL_CHECK_FOR_NULL_WITH_MSG(options, "Failed to get service options", return RCL_RET_ERROR);
 
   bool taken = false;
-  rmw_ret_t ret = rmw_take_request(
-    service->impl->rmw_handle, request_header, ros_request, &taken);
-  if (RMW_RET_OK != ret) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    if (RMW_RET_BAD_ALLOC == ret) {
-      return RCL_RET_BAD_ALLOC;
-    }
-    return RCL_RET_ERROR;
+  rcl_ret_t ret = _take_request_with_shedding(service, request_header, ros_request, &taken);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
   }
   RCUTILS_LOG_DEBUG_NAMED(
     ROS_PACKAGE_NAME, "Service take request succeeded: %s", taken ? "true" : "false");
@@ -396,6 +497,110 @@ rcl_send_response(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_take_request_sequence(
+  const rcl_service_t * service,
+  size_t count,
+  rmw_message_sequence_t * request_sequence,
+  rmw_service_info_t * request_headers)
+{
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Service server taking %zu requests", count);
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(request_sequence, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(request_headers, RCL_RET_INVALID_ARGUMENT);
+  if (request_sequence->capacity < count) {
+    RCL_SET_ERROR_MSG("Insufficient request sequence capacity for requested count");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  // Set the size to zero to indicate that there are no valid requests
+  request_sequence->size = 0u;
+
+  rcl_ret_t ret = RCL_RET_OK;
+  while (request_sequence->size < count) {
+    size_t i = request_sequence->size;
+    bool taken = false;
+    ret = _take_request_with_shedding(
+      service, &request_headers[i], request_sequence->data[i], &taken);
+    if (RCL_RET_OK != ret) {
+      break;  // error already set
+    }
+    if (!taken) {
+      break;
+    }
+    ++request_sequence->size;
+  }
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Service took %zu requests", request_sequence->size);
+
+  if (service->impl->service_event_publisher != NULL) {
+    for (size_t i = 0u; i < request_sequence->size; ++i) {
+      rcl_ret_t rclret = rcl_send_service_event_message(
+        service->impl->service_event_publisher,
+        service_msgs__msg__ServiceEventInfo__REQUEST_RECEIVED,
+        request_sequence->data[i],
+        request_headers[i].request_id.sequence_number,
+        request_headers[i].request_id.writer_guid);
+      if (RCL_RET_OK != rclret) {
+        RCL_SET_ERROR_MSG(rcl_get_error_string().str);
+        return rclret;
+      }
+    }
+  }
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  if (0u == request_sequence->size) {
+    return RCL_RET_SERVICE_TAKE_FAILED;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_send_response_batch(
+  const rcl_service_t * service,
+  rmw_request_id_t * response_headers,
+  const rmw_message_sequence_t * response_sequence)
+{
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(response_headers, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(response_sequence, RCL_RET_INVALID_ARGUMENT);
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Sending %zu service responses", response_sequence->size);
+
+  for (size_t i = 0u; i < response_sequence->size; ++i) {
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      response_sequence->data[i], "response in sequence is null",
+      return RCL_RET_INVALID_ARGUMENT);
+    if (rmw_send_response(
+        service->impl->rmw_handle, &response_headers[i], response_sequence->data[i]) !=
+      RMW_RET_OK)
+    {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+
+    // publish out the introspected content
+    if (service->impl->service_event_publisher != NULL) {
+      rcl_ret_t ret = rcl_send_service_event_message(
+        service->impl->service_event_publisher,
+        service_msgs__msg__ServiceEventInfo__RESPONSE_SENT,
+        response_sequence->data[i],
+        response_headers[i].sequence_number,
+        response_headers[i].writer_guid);
+      if (RCL_RET_OK != ret) {
+        RCL_SET_ERROR_MSG(rcl_get_error_string().str);
+        return ret;
+      }
+    }
+  }
+  return RCL_RET_OK;
+}
+
 bool
 rcl_service_is_valid(const rcl_service_t * service)
 {
@@ -425,6 +630,34 @@ rcl_service_response_publisher_get_actual_qos(const rcl_service_t * service)
   return &service->impl->actual_response_publisher_qos;
 }
 
+static
+size_t
+_get_pending_request_count(rcl_service_impl_t * impl)
+{
+  uint64_t notified = rcutils_atomic_load_uint64_t(&impl->notified_request_count);
+  uint64_t taken = rcutils_atomic_load_uint64_t(&impl->taken_request_count);
+  uint64_t pending = notified > taken ? notified - taken : 0u;
+  // The middleware never holds more requests than its history keeps
+  const rmw_qos_profile_t * qos = &impl->actual_request_subscription_qos;
+  if (RMW_QOS_POLICY_HISTORY_KEEP_LAST == qos->history && qos->depth > 0u &&
+    pending > qos->depth)
+  {
+    pending = qos->depth;
+  }
+  return (size_t)pending;
+}
+
+static
+void
+_service_on_new_request(const void * user_data, size_t number_of_events)
+{
+  rcl_service_impl_t * impl = (rcl_service_impl_t *)user_data;
+  rcutils_atomic_fetch_add_uint64_t(&impl->notified_request_count, number_of_events);
+  if (NULL != impl->on_new_request_callback) {
+    impl->on_new_request_callback(impl->on_new_request_user_data, number_of_events);
+  }
+}
+
 rcl_ret_t
 rcl_service_set_on_new_request_callback(
   const rcl_service_t * service,
@@ -436,10 +669,43 @@ rcl_service_set_on_new_request_callback(
     return RCL_RET_INVALID_ARGUMENT;
   }
 
-  return rmw_service_set_on_new_request_callback(
-    service->impl->rmw_handle,
-    callback,
-    user_data);
+  rcl_service_impl_t * impl = service->impl;
+  if (!impl->backpressure_options.track_pending_requests) {
+    impl->on_new_request_callback = callback;
+    impl->on_new_request_user_data = user_data;
+    return rmw_service_set_on_new_request_callback(
+      impl->rmw_handle,
+      callback,
+      user_data);
+  }
+
+  // rmw serializes setting and calling the callback, so once it is unset here
+  // the forwarding target can be changed without racing with the middleware.
+  rmw_ret_t ret = rmw_service_set_on_new_request_callback(impl->rmw_handle, NULL, NULL);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  rcl_event_callback_t previous_callback = impl->on_new_request_callback;
+  const void * previous_user_data = impl->on_new_request_user_data;
+  impl->on_new_request_callback = callback;
+  impl->on_new_request_user_data = user_data;
+  // The middleware reports requests which arrived without any callback set
+  // to the next one, do the same for those which only reached rcl.
+  if (NULL != callback && NULL == previous_callback) {
+    size_t pending = _get_pending_request_count(impl);
+    if (pending > 0u) {
+      callback(user_data, pending);
+    }
+  }
+  ret = rmw_service_set_on_new_request_callback(impl->rmw_handle, _service_on_new_request, impl);
+  if (RMW_RET_OK != ret) {
+    // Keep forwarding to the previous callback, as before this call
+    impl->on_new_request_callback = previous_callback;
+    impl->on_new_request_user_data = previous_user_data;
+    (void)rmw_service_set_on_new_request_callback(
+      impl->rmw_handle, _service_on_new_request, impl);
+  }
+  return ret;
 }
 
 rcl_ret_t
@@ -482,12 +748,105 @@ rcl_service_configure_service_introspection(
       service->impl->service_event_publisher = NULL;
       return ret;
     }
+
+    ret = rcl_service_event_publisher_set_sampling(
+      service->impl->service_event_publisher, &service->impl->introspection_sampling_options);
+    if (RCL_RET_OK != ret) {
+      (void)unconfigure_service_introspection(node, service->impl, &allocator);
+      return ret;
+    }
   }
 
   return rcl_service_event_publisher_change_state(
     service->impl->service_event_publisher, introspection_state);
 }
 
+rcl_ret_t
+rcl_service_configure_service_introspection_sampling(
+  rcl_service_t * service,
+  const rcl_service_introspection_sampling_options_t * sampling_options)
+{
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(sampling_options, RCL_RET_INVALID_ARGUMENT);
+  if (0u == sampling_options->ratio || sampling_options->min_period < 0) {
+    RCL_SET_ERROR_MSG("sampling ratio must be positive and min period not negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  service->impl->introspection_sampling_options = *sampling_options;
+  if (service->impl->service_event_publisher != NULL) {
+    return rcl_service_event_publisher_set_sampling(
+      service->impl->service_event_publisher, sampling_options);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_service_backpressure_options_t
+rcl_service_get_default_backpressure_options()
+{
+  // !!! MAKE SURE THAT CHANGES TO THESE DEFAULTS ARE REFLECTED IN THE HEADER DOC STRING
+  static rcl_service_backpressure_options_t default_options = {
+    .track_pending_requests = false,
+    .max_request_age = 0,
+  };
+  return default_options;
+}
+
+rcl_ret_t
+rcl_service_configure_backpressure(
+  rcl_service_t * service,
+  const rcl_service_backpressure_options_t * options)
+{
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(options, RCL_RET_INVALID_ARGUMENT);
+  if (options->max_request_age < 0) {
+    RCL_SET_ERROR_MSG("max request age must not be negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  rcl_service_impl_t * impl = service->impl;
+  if (options->track_pending_requests != impl->backpressure_options.track_pending_requests) {
+    rmw_ret_t ret;
+    if (options->track_pending_requests) {
+      rcutils_atomic_store(&impl->notified_request_count, 0);
+      rcutils_atomic_store(&impl->taken_request_count, 0);
+      ret = rmw_service_set_on_new_request_callback(
+        impl->rmw_handle, _service_on_new_request, impl);
+    } else {
+      ret = rmw_service_set_on_new_request_callback(
+        impl->rmw_handle, impl->on_new_request_callback, impl->on_new_request_user_data);
+    }
+    if (RMW_RET_OK != ret) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      return rcl_convert_rmw_ret_to_rcl_ret(ret);
+    }
+  }
+  impl->backpressure_options = *options;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_service_get_request_queue_status(
+  const rcl_service_t * service,
+  rcl_service_request_queue_status_t * status)
+{
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(status, RCL_RET_INVALID_ARGUMENT);
+
+  status->pending_count = service->impl->backpressure_options.track_pending_requests ?
+    _get_pending_request_count(service->impl) : 0u;
+  status->last_taken_request_age =
+    rcutils_atomic_load_int64_t(&service->impl->last_taken_request_age);
+  status->shed_count = rcutils_atomic_load_uint64_t(&service->impl->shed_request_count);
+  return RCL_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
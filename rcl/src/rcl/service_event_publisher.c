@@ -14,6 +14,8 @@
 
 #include "rcl/service_event_publisher.h"
 
+#include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "rcl/allocator.h"
@@ -26,9 +28,287 @@
 #include "rcl/types.h"
 #include "rcutils/logging_macros.h"
 #include "rcutils/macros.h"
+#include "rcutils/stdatomic_helper.h"
 #include "rmw/error_handling.h"
 #include "service_msgs/msg/service_event_info.h"
 
+/// Scratch memory from which service event messages are allocated.
+/**
+ * Every service event message is created from this arena and destroyed right
+ * after being published, so the arena is reset after each event.
+ * It is grown to the peak usage of the last event whenever that one did not
+ * fit, therefore publishing events of similar size does not touch the heap.
+ */
+typedef struct rcl_service_event_message_arena_s
+{
+  /// Start of the reusable buffer
+  uint8_t * buffer;
+  /// Size of the reusable buffer in bytes
+  size_t capacity;
+  /// Bytes of the buffer handed out since the last reset
+  size_t used;
+  /// Bytes requested since the last reset, including what did not fit in the buffer
+  size_t requested;
+  /// Allocator backing the buffer, and allocations which do not fit in it
+  rcl_allocator_t allocator;
+} rcl_service_event_message_arena_t;
+
+// Rate limited requests whose response event may still be published, by key modulo this size
+#define SAMPLED_REQUESTS_SIZE 16u
+
+struct rcl_service_event_publisher_state_s
+{
+  /// Publish the events of one request out of every `ratio`
+  atomic_uint_least64_t ratio;
+  /// Minimum time in nanoseconds between two sampled requests, 0 disables rate limiting
+  atomic_int_least64_t min_period;
+  /// Earliest time at which the next request may be sampled, when rate limited
+  atomic_uint_least64_t next_sample_time;
+  /// Keys of the last requests sampled by the rate limit
+  atomic_uint_least64_t sampled_requests[SAMPLED_REQUESTS_SIZE];
+  /// Whether a call is creating its event message in the arena
+  atomic_bool message_arena_in_use;
+  /// Memory reused by the event messages, owned by the call which set message_arena_in_use
+  rcl_service_event_message_arena_t message_arena;
+};
+
+// Every arena block starts with a header holding its size, needed by reallocate.
+#define ARENA_ALIGNMENT _Alignof(max_align_t)
+#define ARENA_HEADER_SIZE \
+  ((sizeof(size_t) + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT)
+
+static bool
+arena_owns(const rcl_service_event_message_arena_t * arena, const void * pointer)
+{
+  uintptr_t begin = (uintptr_t)arena->buffer;
+  uintptr_t p = (uintptr_t)pointer;
+  return NULL != arena->buffer && p >= begin && p < begin + arena->capacity;
+}
+
+static void *
+arena_allocate(size_t size, void * state)
+{
+  rcl_service_event_message_arena_t * arena = (rcl_service_event_message_arena_t *)state;
+  if (size > SIZE_MAX - ARENA_HEADER_SIZE - ARENA_ALIGNMENT) {
+    return NULL;
+  }
+  size_t block_size =
+    ARENA_HEADER_SIZE + (size + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+  arena->requested += block_size;
+
+  uint8_t * block;
+  if (arena->capacity - arena->used >= block_size) {
+    block = arena->buffer + arena->used;
+    arena->used += block_size;
+  } else {
+    // Does not fit, borrow from the heap; the arena is grown on the next reset.
+    block = arena->allocator.allocate(block_size, arena->allocator.state);
+    if (NULL == block) {
+      return NULL;
+    }
+  }
+  *(size_t *)block = size;
+  return block + ARENA_HEADER_SIZE;
+}
+
+static void
+arena_deallocate(void * pointer, void * state)
+{
+  rcl_service_event_message_arena_t * arena = (rcl_service_event_message_arena_t *)state;
+  if (NULL == pointer || arena_owns(arena, pointer)) {
+    // Arena memory is released all at once by arena_reset()
+    return;
+  }
+  arena->allocator.deallocate((uint8_t *)pointer - ARENA_HEADER_SIZE, arena->allocator.state);
+}
+
+static void *
+arena_reallocate(void * pointer, size_t size, void * state)
+{
+  if (NULL == pointer) {
+    return arena_allocate(size, state);
+  }
+  size_t old_size = *(size_t *)((uint8_t *)pointer - ARENA_HEADER_SIZE);
+  void * new_pointer = arena_allocate(size, state);
+  if (NULL == new_pointer) {
+    return NULL;
+  }
+  memcpy(new_pointer, pointer, old_size < size ? old_size : size);
+  arena_deallocate(pointer, state);
+  return new_pointer;
+}
+
+static void *
+arena_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  if (0u != size_of_element && number_of_elements > SIZE_MAX / size_of_element) {
+    return NULL;
+  }
+  void * pointer = arena_allocate(number_of_elements * size_of_element, state);
+  if (NULL != pointer) {
+    memset(pointer, 0, number_of_elements * size_of_element);
+  }
+  return pointer;
+}
+
+static rcl_allocator_t
+arena_get_allocator(rcl_service_event_message_arena_t * arena)
+{
+  rcl_allocator_t allocator = {
+    .allocate = arena_allocate,
+    .deallocate = arena_deallocate,
+    .reallocate = arena_reallocate,
+    .zero_allocate = arena_zero_allocate,
+    .state = arena,
+  };
+  return allocator;
+}
+
+static void
+arena_reset(rcl_service_event_message_arena_t * arena)
+{
+  if (arena->requested > arena->capacity) {
+    // Contents are dead at this point, so there is no need to reallocate.
+    arena->allocator.deallocate(arena->buffer, arena->allocator.state);
+    arena->buffer = arena->allocator.allocate(arena->requested, arena->allocator.state);
+    arena->capacity = NULL != arena->buffer ? arena->requested : 0u;
+  }
+  arena->used = 0u;
+  arena->requested = 0u;
+}
+
+// Reset the arena, if this call used it, and let other calls use it
+static void
+release_arena(
+  rcl_service_event_publisher_state_t * state, rcl_service_event_message_arena_t * arena)
+{
+  if (NULL != arena) {
+    arena_reset(arena);
+    rcutils_atomic_store(&state->message_arena_in_use, false);
+  }
+}
+
+static void
+arena_fini(rcl_service_event_message_arena_t * arena)
+{
+  if (NULL != arena->buffer) {
+    arena->allocator.deallocate(arena->buffer, arena->allocator.state);
+  }
+  arena->buffer = NULL;
+  arena->capacity = 0u;
+  arena->used = 0u;
+  arena->requested = 0u;
+}
+
+rcl_service_introspection_sampling_options_t
+rcl_service_introspection_get_default_sampling_options()
+{
+  // !!! MAKE SURE THAT CHANGES TO THESE DEFAULTS ARE REFLECTED IN THE HEADER DOC STRING
+  static rcl_service_introspection_sampling_options_t default_options = {
+    .ratio = 1u,
+    .min_period = 0,
+  };
+  return default_options;
+}
+
+static void
+state_reset_sampling(
+  rcl_service_event_publisher_state_t * state,
+  const rcl_service_introspection_sampling_options_t * sampling_options)
+{
+  rcutils_atomic_store(&state->ratio, (uint64_t)sampling_options->ratio);
+  rcutils_atomic_store(&state->min_period, sampling_options->min_period);
+  rcutils_atomic_store(&state->next_sample_time, 0u);
+  for (size_t i = 0u; i < SAMPLED_REQUESTS_SIZE; ++i) {
+    rcutils_atomic_store(&state->sampled_requests[i], 0u);
+  }
+}
+
+static rcl_service_event_publisher_state_t *
+state_init(rcl_allocator_t allocator)
+{
+  rcl_service_event_publisher_state_t * state =
+    allocator.allocate(sizeof(rcl_service_event_publisher_state_t), allocator.state);
+  if (NULL == state) {
+    return NULL;
+  }
+  rcl_service_introspection_sampling_options_t sampling_options =
+    rcl_service_introspection_get_default_sampling_options();
+  atomic_init(&state->ratio, (uint64_t)sampling_options.ratio);
+  atomic_init(&state->min_period, sampling_options.min_period);
+  atomic_init(&state->next_sample_time, 0u);
+  for (size_t i = 0u; i < SAMPLED_REQUESTS_SIZE; ++i) {
+    atomic_init(&state->sampled_requests[i], 0u);
+  }
+  atomic_init(&state->message_arena_in_use, false);
+  state->message_arena.buffer = NULL;
+  state->message_arena.capacity = 0u;
+  state->message_arena.used = 0u;
+  state->message_arena.requested = 0u;
+  state->message_arena.allocator = allocator;
+  return state;
+}
+
+static void
+state_fini(rcl_service_event_publisher_state_t * state, rcl_allocator_t allocator)
+{
+  arena_fini(&state->message_arena);
+  allocator.deallocate(state, allocator.state);
+}
+
+// Identifies a request among those of all the clients of a service
+static uint64_t
+request_key(int64_t sequence_number, const uint8_t guid[16])
+{
+  // FNV-1a of the client gid
+  uint64_t key = 14695981039346656037ULL;
+  for (size_t i = 0u; i < 16u; ++i) {
+    key ^= guid[i];
+    key *= 1099511628211ULL;
+  }
+  return key ^ (uint64_t)sequence_number;
+}
+
+// Decide whether the events of a request are published, the same way for all of them
+static bool
+is_sampled(
+  rcl_service_event_publisher_state_t * state,
+  uint8_t event_type,
+  int64_t sequence_number,
+  const uint8_t guid[16],
+  rcl_time_point_value_t now)
+{
+  uint64_t ratio = rcutils_atomic_load_uint64_t(&state->ratio);
+  if (ratio > 1u && ((uint64_t)sequence_number % ratio) != 0u) {
+    return false;
+  }
+  int64_t min_period = rcutils_atomic_load_int64_t(&state->min_period);
+  if (min_period <= 0) {
+    return true;
+  }
+
+  // Only the request event is rate limited, the response event shares its fate.
+  uint64_t key = request_key(sequence_number, guid);
+  atomic_uint_least64_t * sampled_request = &state->sampled_requests[key % SAMPLED_REQUESTS_SIZE];
+  if (service_msgs__msg__ServiceEventInfo__RESPONSE_SENT == event_type ||
+    service_msgs__msg__ServiceEventInfo__RESPONSE_RECEIVED == event_type)
+  {
+    return rcutils_atomic_load_uint64_t(sampled_request) == key;
+  }
+  uint64_t next_sample_time = rcutils_atomic_load_uint64_t(&state->next_sample_time);
+  if ((uint64_t)now < next_sample_time) {
+    return false;
+  }
+  // Of concurrent requests, only the one which moves the next sample time is sampled
+  if (!rcutils_atomic_compare_exchange_strong_uint_least64_t(
+      &state->next_sample_time, &next_sample_time, (uint64_t)(now + min_period)))
+  {
+    return false;
+  }
+  rcutils_atomic_store(sampled_request, key);
+  return true;
+}
+
 rcl_service_event_publisher_t rcl_get_zero_initialized_service_event_publisher()
 {
   static rcl_service_event_publisher_t zero_service_event_publisher = {0};
@@ -43,6 +323,9 @@ rcl_service_event_publisher_is_valid(const rcl_service_event_publisher_t * servi
   RCL_CHECK_FOR_NULL_WITH_MSG(
     service_event_publisher->service_type_support,
     "service_event_publisher's service type support is invalid", return false);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    service_event_publisher->state,
+    "service_event_publisher's state is invalid", return false);
   if (!rcl_clock_valid(service_event_publisher->clock)) {
     RCL_SET_ERROR_MSG("service_event_publisher's clock is invalid");
     return false;
@@ -125,14 +408,20 @@ rcl_ret_t rcl_service_event_publisher_init(
   service_event_publisher->service_type_support = service_type_support;
   service_event_publisher->clock = clock;
   service_event_publisher->publisher_options = publisher_options;
+  service_event_publisher->state = state_init(allocator);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    service_event_publisher->state,
+    "allocating memory for service introspection state failed",
+    return RCL_RET_BAD_ALLOC;);
 
   size_t topic_length = strlen(service_name) + strlen(RCL_SERVICE_INTROSPECTION_TOPIC_POSTFIX) + 1;
   service_event_publisher->service_event_topic_name = (char *) allocator.allocate(
     topic_length, allocator.state);
-  RCL_CHECK_FOR_NULL_WITH_MSG(
-    service_event_publisher->service_event_topic_name,
-    "allocating memory for service introspection topic name failed",
-    return RCL_RET_BAD_ALLOC;);
+  if (NULL == service_event_publisher->service_event_topic_name) {
+    RCL_SET_ERROR_MSG("allocating memory for service introspection topic name failed");
+    ret = RCL_RET_BAD_ALLOC;
+    goto free_state;
+  }
 
   snprintf(
     service_event_publisher->service_event_topic_name,
@@ -151,6 +440,10 @@ rcl_ret_t rcl_service_event_publisher_init(
 
 free_topic_name:
   allocator.deallocate(service_event_publisher->service_event_topic_name, allocator.state);
+  service_event_publisher->service_event_topic_name = NULL;
+free_state:
+  state_fini(service_event_publisher->state, allocator);
+  service_event_publisher->state = NULL;
 
   return ret;
 }
@@ -189,11 +482,14 @@ rcl_ret_t rcl_service_event_publisher_fini(
   allocator.deallocate(service_event_publisher->service_event_topic_name, allocator.state);
   service_event_publisher->service_event_topic_name = NULL;
 
+  state_fini(service_event_publisher->state, allocator);
+  service_event_publisher->state = NULL;
+
   return RCL_RET_OK;
 }
 
 rcl_ret_t rcl_send_service_event_message(
-  const rcl_service_event_publisher_t * service_event_publisher,
+  rcl_service_event_publisher_t * service_event_publisher,
   const uint8_t event_type,
   const void * ros_response_request,
   const int64_t sequence_number,
@@ -215,8 +511,9 @@ rcl_ret_t rcl_send_service_event_message(
     return RCL_RET_ERROR;
   }
 
-  rcl_allocator_t allocator = service_event_publisher->publisher_options.allocator;
-  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(
+    &service_event_publisher->publisher_options.allocator,
+    "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
 
   if (!rcl_publisher_is_valid(service_event_publisher->publisher)) {
     return RCL_RET_PUBLISHER_INVALID;
@@ -232,6 +529,10 @@ rcl_ret_t rcl_send_service_event_message(
     return RCL_RET_ERROR;
   }
 
+  if (!is_sampled(service_event_publisher->state, event_type, sequence_number, guid, now)) {
+    return RCL_RET_OK;
+  }
+
   rosidl_service_introspection_info_t info = {
     .event_type = event_type,
     .stamp_sec = (int32_t)RCL_NS_TO_S(now),
@@ -241,6 +542,13 @@ rcl_ret_t rcl_send_service_event_message(
 
   memcpy(info.client_gid, guid, 16);
 
+  // Concurrent calls do not wait for the arena, they allocate from the heap instead
+  rcl_service_event_message_arena_t * arena = NULL;
+  rcl_allocator_t allocator = service_event_publisher->publisher_options.allocator;
+  if (!rcutils_atomic_exchange_bool(&service_event_publisher->state->message_arena_in_use, true)) {
+    arena = &service_event_publisher->state->message_arena;
+    allocator = arena_get_allocator(arena);
+  }
   void * service_introspection_message;
   if (service_event_publisher->introspection_state == RCL_SERVICE_INTROSPECTION_METADATA) {
     ros_response_request = NULL;
@@ -259,18 +567,21 @@ rcl_ret_t rcl_send_service_event_message(
         &info, &allocator, NULL, ros_response_request);
       break;
     default:
+      release_arena(service_event_publisher->state, arena);
       rcutils_reset_error();
       RCL_SET_ERROR_MSG("unsupported event type");
       return RCL_RET_ERROR;
   }
   RCL_CHECK_FOR_NULL_WITH_MSG(
-    service_introspection_message, "service_introspection_message is NULL", return RCL_RET_ERROR);
+    service_introspection_message, "service_introspection_message is NULL",
+    release_arena(service_event_publisher->state, arena); return RCL_RET_ERROR);
 
   // and publish it out!
   ret = rcl_publish(service_event_publisher->publisher, service_introspection_message, NULL);
   // clean up before error checking
   service_event_publisher->service_type_support->event_message_destroy_handle_function(
     service_introspection_message, &allocator);
+  release_arena(service_event_publisher->state, arena);
   if (RCL_RET_OK != ret) {
     rcutils_reset_error();
     RCL_SET_ERROR_MSG(rmw_get_error_string().str);
@@ -292,3 +603,22 @@ rcl_service_event_publisher_change_state(
 
   return RCL_RET_OK;
 }
+
+rcl_ret_t
+rcl_service_event_publisher_set_sampling(
+  rcl_service_event_publisher_t * service_event_publisher,
+  const rcl_service_introspection_sampling_options_t * sampling_options)
+{
+  if (!rcl_service_event_publisher_is_valid(service_event_publisher)) {
+    return RCL_RET_ERROR;
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(sampling_options, RCL_RET_INVALID_ARGUMENT);
+  if (0u == sampling_options->ratio || sampling_options->min_period < 0) {
+    RCL_SET_ERROR_MSG("sampling ratio must be positive and min period not negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  state_reset_sampling(service_event_publisher->state, sampling_options);
+
+  return RCL_RET_OK;
+}
@@ -30,6 +30,9 @@ extern "C"
 
 #include "rosidl_runtime_c/service_type_support_struct.h"
 
+/// Sampling state and reusable message memory of a service event publisher.
+typedef struct rcl_service_event_publisher_state_s rcl_service_event_publisher_state_t;
+
 typedef struct rcl_service_event_publisher_s
 {
   /// Handle to publisher for publishing service events
@@ -44,6 +47,8 @@ typedef struct rcl_service_event_publisher_s
   rcl_publisher_options_t publisher_options;
   /// Handle to service typesupport
   const rosidl_service_type_support_t * service_type_support;
+  /// Sampling state and memory reused by the event messages, shared by concurrent calls
+  rcl_service_event_publisher_state_t * state;
 } rcl_service_event_publisher_t;
 
 /// Return a rcl_service_event_publisher_t struct with members set to `NULL`.
@@ -165,16 +170,27 @@ rcl_service_event_publisher_is_valid(const rcl_service_event_publisher_t * servi
  *
  * rcl_send_service_event_message() is a potentially blocking call.
  *
+ * Events of requests which are not selected by the sampling options are
+ * dropped, and #RCL_RET_OK is returned for them.
+ * The response event of a request is published only if its request event was,
+ * provided that the request event was sent first.
+ *
+ * The event message is created in memory owned by the service event publisher,
+ * and the heap is only used when an event is larger than all the previous ones,
+ * or when another call is creating its event in that memory at the same time.
+ *
  * The ROS request message given by the `ros_response_request` void pointer is always
  * owned by the calling code, but should remain constant during rcl_send_service_event_message().
  *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
- * Allocates Memory   | No
- * Thread-Safe        | No
- * Uses Atomics       | No
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | Yes [2]
+ * Uses Atomics       | Yes
  * Lock-Free          | Yes
+ * <i>[1] only when the reusable memory is too small or in use by another call</i>
+ * <i>[2] concurrently with itself, not with the other service event publisher functions</i>
  *
  * \param[in] service_event_publisher pointer to the service event publisher
  * \param[in] event_type introspection event type from service_msgs::msg::ServiceEventInfo
@@ -189,7 +205,7 @@ RCL_PUBLIC
 RCL_WARN_UNUSED
 rcl_ret_t
 rcl_send_service_event_message(
-  const rcl_service_event_publisher_t * service_event_publisher,
+  rcl_service_event_publisher_t * service_event_publisher,
   uint8_t event_type,
   const void * ros_response_request,
   int64_t sequence_number,
@@ -208,6 +224,23 @@ rcl_service_event_publisher_change_state(
   rcl_service_event_publisher_t * service_event_publisher,
   rcl_service_introspection_state_t introspection_state);
 
+/// Change which requests have their events published by this service event publisher.
+/**
+ * Changing the options restarts the rate limit, if any.
+ *
+ * \param[in] service_event_publisher pointer to the service event publisher
+ * \param[in] sampling_options new sampling options
+ * \return #RCL_RET_OK if the options were changed successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if the options are invalid, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_service_event_publisher_set_sampling(
+  rcl_service_event_publisher_t * service_event_publisher,
+  const rcl_service_introspection_sampling_options_t * sampling_options);
+
 #ifdef __cplusplus
 }
 #endif
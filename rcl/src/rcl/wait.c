@@ -32,6 +32,7 @@ extern "C"
 #include "rmw/event.h"
 
 #include "./context_impl.h"
+#include "./guard_condition_impl.h"
 
 struct rcl_wait_set_impl_s
 {
@@ -637,6 +638,9 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
     bool is_ready = wait_set->impl->rmw_guard_conditions.guard_conditions[i] != NULL;
     if (!is_ready) {
       wait_set->guard_conditions[i] = NULL;
+    } else if (NULL != wait_set->guard_conditions[i]) {
+      // Let anything derived from this guard condition, like cached graph state, know it fired.
+      rcl_guard_condition_count_trigger(wait_set->guard_conditions[i]);
     }
   }
   // Set corresponding rcl client handles NULL.
@@ -0,0 +1,283 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcl/allocator.h"
+#include "rcl/arguments.h"
+#include "rcl/error_handling.h"
+#include "rcl/lexer.h"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+constexpr const size_t kRuleCount = 500;
+
+std::vector<std::string> make_arguments()
+{
+  std::vector<std::string> arguments{"process_name", "--ros-args"};
+  for (size_t i = 0; i < kRuleCount; ++i) {
+    const std::string index = std::to_string(i);
+    arguments.push_back("-r");
+    arguments.push_back("/some/namespace/topic_" + index + ":=/remapped/topic_" + index);
+    arguments.push_back("-r");
+    arguments.push_back("node_" + index + ":rostopic://chatter_" + index + ":=talker");
+    arguments.push_back("-p");
+    arguments.push_back("node_" + index + ":parameter.nested_" + index + ":=" + index);
+  }
+  return arguments;
+}
+
+// The previous lexer, which scanned the transition ranges of each state, kept as a baseline.
+namespace baseline
+{
+enum : unsigned char
+{
+  S0, S1, S2, S3, S4, S5, S6, S7, S8, S9, S10, S11, S12, S13, S14, S15,
+  S16, S17, S18, S19, S20, S21, S22, S23, S24, S25, S26, S27, S28, S29, S30, S31,
+  T_TILDE_SLASH, T_URL_SERVICE, T_URL_TOPIC, T_COLON, T_NODE, T_NS, T_SEPARATOR,
+  T_BR1, T_BR2, T_BR3, T_BR4, T_BR5, T_BR6, T_BR7, T_BR8, T_BR9,
+  T_TOKEN, T_FORWARD_SLASH, T_WILD_ONE, T_WILD_MULTI, T_EOF, T_NONE, T_DOT
+};
+
+struct transition_t
+{
+  unsigned char to_state;
+  char range_start;
+  char range_end;
+};
+
+struct state_t
+{
+  unsigned char else_state;
+  unsigned char else_movement;
+  // Ends with a zero transition
+  transition_t transitions[12];
+};
+
+const state_t g_states[S31 + 1] =
+{
+  // S0
+  {T_NONE, 0u, {
+    {T_FORWARD_SLASH, '/', '/'}, {T_DOT, '.', '.'}, {S1, '\\', '\\'}, {S2, '~', '~'},
+    {S3, '_', '_'}, {S9, 'a', 'q'}, {S9, 's', 'z'}, {S9, 'A', 'Z'}, {S11, 'r', 'r'},
+    {S30, '*', '*'}, {S31, ':', ':'}}},
+  // S1
+  {T_NONE, 0u, {
+    {T_BR1, '1', '1'}, {T_BR2, '2', '2'}, {T_BR3, '3', '3'}, {T_BR4, '4', '4'}, {T_BR5, '5', '5'},
+    {T_BR6, '6', '6'}, {T_BR7, '7', '7'}, {T_BR8, '8', '8'}, {T_BR9, '9', '9'}}},
+  // S2
+  {T_NONE, 0u, {
+    {T_TILDE_SLASH, '/', '/'}}},
+  // S3
+  {S10, 1u, {
+    {S4, '_', '_'}}},
+  // S4
+  {T_NONE, 0u, {
+    {S5, 'n', 'n'}}},
+  // S5
+  {T_NONE, 0u, {
+    {T_NS, 's', 's'}, {S6, 'o', 'o'}, {S7, 'a', 'a'}}},
+  // S6
+  {T_NONE, 0u, {
+    {S8, 'd', 'd'}}},
+  // S7
+  {T_NONE, 0u, {
+    {S8, 'm', 'm'}}},
+  // S8
+  {T_NONE, 0u, {
+    {T_NODE, 'e', 'e'}}},
+  // S9
+  {T_TOKEN, 1u, {
+    {S9, 'a', 'z'}, {S9, 'A', 'Z'}, {S9, '0', '9'}, {S10, '_', '_'}}},
+  // S10
+  {T_TOKEN, 1u, {
+    {S9, 'a', 'z'}, {S9, 'A', 'Z'}, {S9, '0', '9'}}},
+  // S11
+  {S9, 1u, {
+    {S12, 'o', 'o'}}},
+  // S12
+  {S9, 1u, {
+    {S13, 's', 's'}}},
+  // S13
+  {S9, 1u, {
+    {S14, 't', 't'}, {S21, 's', 's'}}},
+  // S14
+  {S9, 1u, {
+    {S15, 'o', 'o'}}},
+  // S15
+  {S9, 1u, {
+    {S16, 'p', 'p'}}},
+  // S16
+  {S9, 1u, {
+    {S17, 'i', 'i'}}},
+  // S17
+  {S9, 1u, {
+    {S18, 'c', 'c'}}},
+  // S18
+  {S9, 1u, {
+    {S19, ':', ':'}}},
+  // S19
+  {S9, 2u, {
+    {S20, '/', '/'}}},
+  // S20
+  {S9, 3u, {
+    {T_URL_TOPIC, '/', '/'}}},
+  // S21
+  {S9, 1u, {
+    {S22, 'e', 'e'}}},
+  // S22
+  {S9, 1u, {
+    {S23, 'r', 'r'}}},
+  // S23
+  {S9, 1u, {
+    {S24, 'v', 'v'}}},
+  // S24
+  {S9, 1u, {
+    {S25, 'i', 'i'}}},
+  // S25
+  {S9, 1u, {
+    {S26, 'c', 'c'}}},
+  // S26
+  {S9, 1u, {
+    {S27, 'e', 'e'}}},
+  // S27
+  {S9, 1u, {
+    {S28, ':', ':'}}},
+  // S28
+  {S9, 2u, {
+    {S29, '/', '/'}}},
+  // S29
+  {S9, 3u, {
+    {T_URL_SERVICE, '/', '/'}}},
+  // S30
+  {T_WILD_ONE, 1u, {
+    {T_WILD_MULTI, '*', '*'}}},
+  // S31
+  {T_COLON, 1u, {
+    {T_SEPARATOR, '=', '='}}}
+};
+
+const rcl_lexeme_t g_terminals[T_DOT - T_TILDE_SLASH + 1] = {
+  RCL_LEXEME_TILDE_SLASH, RCL_LEXEME_URL_SERVICE, RCL_LEXEME_URL_TOPIC, RCL_LEXEME_COLON,
+  RCL_LEXEME_NODE, RCL_LEXEME_NS, RCL_LEXEME_SEPARATOR, RCL_LEXEME_BR1, RCL_LEXEME_BR2,
+  RCL_LEXEME_BR3, RCL_LEXEME_BR4, RCL_LEXEME_BR5, RCL_LEXEME_BR6, RCL_LEXEME_BR7,
+  RCL_LEXEME_BR8, RCL_LEXEME_BR9, RCL_LEXEME_TOKEN, RCL_LEXEME_FORWARD_SLASH,
+  RCL_LEXEME_WILD_ONE, RCL_LEXEME_WILD_MULTI, RCL_LEXEME_EOF, RCL_LEXEME_NONE, RCL_LEXEME_DOT
+};
+
+void analyze(const char * text, rcl_lexeme_t * lexeme, size_t * length)
+{
+  *length = 0u;
+  if ('\0' == text[0u]) {
+    *lexeme = RCL_LEXEME_EOF;
+    return;
+  }
+  size_t next_state = S0;
+  do {
+    const state_t & state = g_states[next_state];
+    const char current_char = text[*length];
+    size_t movement = 0u;
+    next_state = 0u;
+    for (const transition_t * transition = state.transitions; 0u != transition->to_state;
+      ++transition)
+    {
+      if (transition->range_start <= current_char && transition->range_end >= current_char) {
+        next_state = transition->to_state;
+        break;
+      }
+    }
+    if (0u == next_state) {
+      next_state = state.else_state;
+      movement = state.else_movement;
+    }
+    if (0u == movement) {
+      if ('\0' != current_char) {
+        ++(*length);
+      }
+    } else {
+      *length -= movement - 1u;
+    }
+  } while (next_state < T_TILDE_SLASH);
+  *lexeme = g_terminals[next_state - T_TILDE_SLASH];
+}
+}  // namespace baseline
+}  // namespace
+
+BENCHMARK_F(PerformanceTest, lexer_analyze)(benchmark::State & st)
+{
+  const std::vector<std::string> arguments = make_arguments();
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    for (const std::string & argument : arguments) {
+      const char * text = argument.c_str();
+      rcl_lexeme_t lexeme = RCL_LEXEME_NONE;
+      do {
+        size_t length = 0u;
+        if (RCL_RET_OK != rcl_lexer_analyze(text, &lexeme, &length)) {
+          st.SkipWithError(rcl_get_error_string().str);
+          return;
+        }
+        text += length;
+      } while (RCL_LEXEME_EOF != lexeme && RCL_LEXEME_NONE != lexeme);
+    }
+  }
+}
+
+BENCHMARK_F(PerformanceTest, lexer_analyze_baseline)(benchmark::State & st)
+{
+  const std::vector<std::string> arguments = make_arguments();
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    for (const std::string & argument : arguments) {
+      const char * text = argument.c_str();
+      rcl_lexeme_t lexeme = RCL_LEXEME_NONE;
+      do {
+        size_t length = 0u;
+        baseline::analyze(text, &lexeme, &length);
+        text += length;
+      } while (RCL_LEXEME_EOF != lexeme && RCL_LEXEME_NONE != lexeme);
+      benchmark::DoNotOptimize(text);
+    }
+  }
+}
+
+BENCHMARK_F(PerformanceTest, parse_arguments)(benchmark::State & st)
+{
+  const std::vector<std::string> arguments = make_arguments();
+  std::vector<const char *> argv;
+  for (const std::string & argument : arguments) {
+    argv.push_back(argument.c_str());
+  }
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rcl_arguments_t parsed_args = rcl_get_zero_initialized_arguments();
+    rcl_ret_t ret = rcl_parse_arguments(
+      static_cast<int>(argv.size()), argv.data(), allocator, &parsed_args);
+    if (RCL_RET_OK != ret) {
+      st.SkipWithError(rcl_get_error_string().str);
+    }
+    if (RCL_RET_OK != rcl_arguments_fini(&parsed_args)) {
+      st.SkipWithError(rcl_get_error_string().str);
+    }
+  }
+}
@@ -534,18 +534,46 @@ TEST_F(CLASSNAME(TestArgumentsFixture, RMW_IMPLEMENTATION), test_copy_bad_alloc)
   ret = rcl_parse_arguments(argc, argv, rcl_get_default_allocator(), &parsed_args);
   EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
 
+  // Copies share the parsed arguments, so copying does not allocate
   rcl_arguments_t copied_args = rcl_get_zero_initialized_arguments();
   rcl_allocator_t bad_alloc = get_failing_allocator();
   rcl_allocator_t saved_alloc = parsed_args.impl->allocator;
   parsed_args.impl->allocator = bad_alloc;
   ret = rcl_arguments_copy(&parsed_args, &copied_args);
-  EXPECT_EQ(RCL_RET_BAD_ALLOC, ret) << rcl_get_error_string().str;
-  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(parsed_args.impl, copied_args.impl);
   parsed_args.impl->allocator = saved_alloc;
 
+  EXPECT_EQ(RCL_RET_OK, rcl_arguments_fini(&copied_args)) << rcl_get_error_string().str;
   EXPECT_EQ(RCL_RET_OK, rcl_arguments_fini(&parsed_args)) << rcl_get_error_string().str;
 }
 
+TEST_F(CLASSNAME(TestArgumentsFixture, RMW_IMPLEMENTATION), test_copy_shares_arguments) {
+  const char * const argv[] = {
+    "process_name", "--ros-args", "-r", "foo:=bar", "-p", "param:=42", "--enclave", "/enc",
+    "--log-level", "rcl:=debug", "--", "arg"
+  };
+  const int argc = sizeof(argv) / sizeof(const char *);
+  rcl_arguments_t parsed_args = rcl_get_zero_initialized_arguments();
+  rcl_ret_t ret = rcl_parse_arguments(argc, argv, rcl_get_default_allocator(), &parsed_args);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_arguments_t copied_args = rcl_get_zero_initialized_arguments();
+  ret = rcl_arguments_copy(&parsed_args, &copied_args);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(parsed_args.impl, copied_args.impl);
+
+  // The original can go first, the copy keeps the arguments alive
+  EXPECT_EQ(RCL_RET_OK, rcl_arguments_fini(&parsed_args));
+  EXPECT_UNPARSED(copied_args, 0, 11);
+  EXPECT_EQ(1, copied_args.impl->num_remap_rules);
+  EXPECT_STREQ("/enc", copied_args.impl->enclave);
+  EXPECT_EQ(1u, copied_args.impl->log_levels.num_logger_settings);
+  ASSERT_NE(nullptr, copied_args.impl->parameter_overrides);
+  EXPECT_EQ(1u, copied_args.impl->parameter_overrides->num_nodes);
+  EXPECT_EQ(RCL_RET_OK, rcl_arguments_fini(&copied_args));
+}
+
 TEST_F(CLASSNAME(TestArgumentsFixture, RMW_IMPLEMENTATION), test_copy_no_ros_args) {
   const char * const argv[] = {"process_name", "--ros-args", "--", "arg", "--ros-args"};
   const int argc = sizeof(argv) / sizeof(const char *);
@@ -1311,9 +1339,9 @@ TEST_F(CLASSNAME(TestArgumentsFixture, RMW_IMPLEMENTATION), test_copy_with_inter
     EXPECT_EQ(RCL_RET_OK, rcl_arguments_fini(&parsed_args));
   });
 
-  rcl_arguments_t copied_args = rcl_get_zero_initialized_arguments();
   RCUTILS_FAULT_INJECTION_TEST(
   {
+    rcl_arguments_t copied_args = rcl_get_zero_initialized_arguments();
     rcl_ret_t ret = rcl_arguments_copy(&parsed_args, &copied_args);
     if (RCL_RET_OK == ret) {
       int64_t count = rcutils_fault_injection_get_count();
@@ -322,6 +322,98 @@ TEST_F(TestClientFixture, test_client_bad_arguments) {
   rcl_reset_error();
 }
 
+/* Tracking in-flight requests with deadlines
+ */
+TEST_F(TestClientFixture, test_client_request_tracking) {
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, BasicTypes);
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  rcl_ret_t ret = rcl_client_init(
+    &client, this->node_ptr, ts, "add_two_ints", &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_client_fini(&client, this->node_ptr)) << rcl_get_error_string().str;
+  });
+
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_clock_t clock;
+  ASSERT_EQ(RCL_RET_OK, rcl_clock_init(RCL_STEADY_TIME, &clock, &allocator));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_clock_fini(&clock)) << rcl_get_error_string().str;
+  });
+
+  test_msgs__srv__BasicTypes_Request req;
+  test_msgs__srv__BasicTypes_Request__init(&req);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Request__fini(&req);
+  });
+  int64_t sequence_number = 0;
+  rcl_time_point_value_t deadline = 0;
+  rcl_client_expired_request_t expired[4];
+  size_t count = 0u;
+
+  // Tracking is disabled by default
+  EXPECT_EQ(
+    RCL_RET_ERROR, rcl_send_tracked_request(&client, &req, 0, nullptr, &sequence_number));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_ERROR, rcl_client_take_expired_requests(&client, expired, 4u, &count));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_CLIENT_INVALID, rcl_client_configure_request_tracking(nullptr, &clock, 2u));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_client_configure_request_tracking(&client, nullptr, 2u));
+  rcl_reset_error();
+
+  ASSERT_EQ(RCL_RET_OK, rcl_client_configure_request_tracking(&client, &clock, 2u)) <<
+    rcl_get_error_string().str;
+
+  int cookie = 0;
+  ret = rcl_send_tracked_request(&client, &req, 0, &cookie, &sequence_number);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(1, sequence_number);
+  ret = rcl_send_tracked_request(
+    &client, &req, RCL_CLIENT_REQUEST_NO_TIMEOUT, nullptr, &sequence_number);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(2, sequence_number);
+  // The table is full, so the request must not be sent
+  ret = rcl_send_tracked_request(&client, &req, 0, nullptr, &sequence_number);
+  EXPECT_EQ(RCL_RET_CLIENT_REQUEST_TABLE_FULL, ret);
+  rcl_reset_error();
+  EXPECT_EQ(2, sequence_number);
+
+  size_t pending = 0u;
+  ASSERT_EQ(RCL_RET_OK, rcl_client_get_next_request_deadline(&client, &deadline, &pending));
+  EXPECT_EQ(2u, pending);
+  EXPECT_NE(INT64_MAX, deadline);
+
+  // The first request expired immediately, the second never does
+  ASSERT_EQ(RCL_RET_OK, rcl_client_take_expired_requests(&client, expired, 4u, &count));
+  ASSERT_EQ(1u, count);
+  EXPECT_EQ(1, expired[0].sequence_number);
+  EXPECT_EQ(&cookie, expired[0].user_data);
+  ASSERT_EQ(RCL_RET_OK, rcl_client_get_next_request_deadline(&client, &deadline, &pending));
+  EXPECT_EQ(1u, pending);
+  EXPECT_EQ(INT64_MAX, deadline);
+
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_client_take_expired_requests(&client, nullptr, 4u, &count));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_client_get_next_request_deadline(&client, nullptr, nullptr));
+  rcl_reset_error();
+
+  // Disabling tracking drops everything
+  ASSERT_EQ(RCL_RET_OK, rcl_client_configure_request_tracking(&client, &clock, 0u));
+  EXPECT_EQ(
+    RCL_RET_ERROR, rcl_client_get_next_request_deadline(&client, &deadline, &pending));
+  rcl_reset_error();
+}
+
 TEST_F(TestClientFixture, test_client_init_fini_maybe_fail)
 {
   const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
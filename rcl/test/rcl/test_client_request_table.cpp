@@ -0,0 +1,154 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "./client_request_table.h"
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+#include "rcl/allocator.h"
+#include "rcl/error_handling.h"
+
+TEST(TestClientRequestTable, init_fini) {
+  rcl_client_request_table_t table = rcl_get_zero_initialized_client_request_table();
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_client_request_table_init(nullptr, 4u, allocator));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_client_request_table_init(&table, 0u, allocator));
+  rcl_reset_error();
+  rcl_allocator_t invalid_allocator = rcutils_get_zero_initialized_allocator();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_client_request_table_init(&table, 4u, invalid_allocator));
+  rcl_reset_error();
+
+  ASSERT_EQ(RCL_RET_OK, rcl_client_request_table_init(&table, 3u, allocator)) <<
+    rcl_get_error_string().str;
+  EXPECT_EQ(3u, table.capacity);
+  EXPECT_EQ(0u, table.size);
+  // Slot count is a power of two of at least twice the capacity
+  EXPECT_EQ(7u, table.mask);
+  EXPECT_EQ(RCL_RET_OK, rcl_client_request_table_fini(&table));
+  EXPECT_EQ(nullptr, table.entries);
+  // Finalizing twice is harmless
+  EXPECT_EQ(RCL_RET_OK, rcl_client_request_table_fini(&table));
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_client_request_table_fini(nullptr));
+  rcl_reset_error();
+}
+
+TEST(TestClientRequestTable, insert_remove) {
+  rcl_client_request_table_t table = rcl_get_zero_initialized_client_request_table();
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_client_request_table_init(&table, 64u, rcl_get_default_allocator())) <<
+    rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_client_request_table_fini(&table));
+  });
+
+  std::vector<int> cookies(64);
+  for (int64_t i = 0; i < 64; ++i) {
+    EXPECT_EQ(
+      RCL_RET_OK, rcl_client_request_table_insert(&table, i + 1, 100 + i, &cookies[i])) <<
+      rcl_get_error_string().str;
+  }
+  EXPECT_EQ(64u, table.size);
+  EXPECT_EQ(
+    RCL_RET_CLIENT_REQUEST_TABLE_FULL, rcl_client_request_table_insert(&table, 65, 0, nullptr));
+  rcl_reset_error();
+
+  // Remove every other entry, the remaining ones must stay reachable
+  rcl_client_request_entry_t entry;
+  for (int64_t i = 0; i < 64; i += 2) {
+    ASSERT_TRUE(rcl_client_request_table_remove(&table, i + 1, &entry));
+    EXPECT_EQ(i + 1, entry.sequence_number);
+    EXPECT_EQ(100 + i, entry.deadline);
+    EXPECT_EQ(&cookies[i], entry.user_data);
+  }
+  EXPECT_EQ(32u, table.size);
+  for (int64_t i = 0; i < 64; ++i) {
+    EXPECT_EQ(i % 2 == 1, rcl_client_request_table_remove(&table, i + 1, &entry));
+  }
+  EXPECT_EQ(0u, table.size);
+  EXPECT_FALSE(rcl_client_request_table_remove(&table, 1, nullptr));
+
+  // Duplicated sequence numbers are rejected
+  EXPECT_EQ(RCL_RET_OK, rcl_client_request_table_insert(&table, 42, 0, nullptr));
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_client_request_table_insert(&table, 42, 0, nullptr));
+  rcl_reset_error();
+}
+
+TEST(TestClientRequestTable, churn) {
+  rcl_client_request_table_t table = rcl_get_zero_initialized_client_request_table();
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_client_request_table_init(&table, 16u, rcl_get_default_allocator())) <<
+    rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_client_request_table_fini(&table));
+  });
+
+  // Keep a sliding window of in-flight requests, as a busy client would
+  int64_t oldest = 1;
+  for (int64_t next = 1; next < 10000; ++next) {
+    if (table.size == table.capacity) {
+      ASSERT_TRUE(rcl_client_request_table_remove(&table, oldest, nullptr)) << oldest;
+      ++oldest;
+    }
+    ASSERT_EQ(RCL_RET_OK, rcl_client_request_table_insert(&table, next, next, nullptr));
+  }
+  for (; oldest < 10000; ++oldest) {
+    ASSERT_TRUE(rcl_client_request_table_remove(&table, oldest, nullptr)) << oldest;
+  }
+  EXPECT_EQ(0u, table.size);
+}
+
+TEST(TestClientRequestTable, expiration) {
+  rcl_client_request_table_t table = rcl_get_zero_initialized_client_request_table();
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_client_request_table_init(&table, 8u, rcl_get_default_allocator())) <<
+    rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_client_request_table_fini(&table));
+  });
+
+  rcl_time_point_value_t deadline = 0;
+  EXPECT_FALSE(rcl_client_request_table_get_next_deadline(&table, &deadline));
+  EXPECT_EQ(INT64_MAX, deadline);
+
+  for (int64_t i = 1; i <= 6; ++i) {
+    ASSERT_EQ(RCL_RET_OK, rcl_client_request_table_insert(&table, i, i * 10, nullptr));
+  }
+  ASSERT_EQ(RCL_RET_OK, rcl_client_request_table_insert(&table, 7, INT64_MAX, nullptr));
+  EXPECT_TRUE(rcl_client_request_table_get_next_deadline(&table, &deadline));
+  EXPECT_EQ(10, deadline);
+
+  rcl_client_expired_request_t expired[8];
+  EXPECT_EQ(0u, rcl_client_request_table_take_expired(&table, 9, expired, 8u));
+
+  // Only as many as fit are reported, the rest is kept for the next call
+  EXPECT_EQ(2u, rcl_client_request_table_take_expired(&table, 40, expired, 2u));
+  EXPECT_EQ(5u, table.size);
+  EXPECT_EQ(2u, rcl_client_request_table_take_expired(&table, 40, expired, 8u));
+  EXPECT_EQ(3u, table.size);
+  EXPECT_TRUE(rcl_client_request_table_get_next_deadline(&table, &deadline));
+  EXPECT_EQ(50, deadline);
+
+  EXPECT_EQ(2u, rcl_client_request_table_take_expired(&table, INT64_MAX - 1, expired, 8u));
+  EXPECT_EQ(1u, table.size);
+  EXPECT_TRUE(rcl_client_request_table_remove(&table, 7, nullptr));
+}
@@ -14,6 +14,9 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include "osrf_testing_tools_cpp/memory_tools/gtest_quickstart.hpp"
 #include "osrf_testing_tools_cpp/scope_exit.hpp"
 #include "rcl/context.h"
@@ -151,6 +154,60 @@ TEST_F(CLASSNAME(TestContextFixture, RMW_IMPLEMENTATION), nominal) {
   EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
 }
 
+// Test names interned in a context.
+TEST_F(CLASSNAME(TestContextFixture, RMW_IMPLEMENTATION), intern_name) {
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  rcl_ret_t ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+  });
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  const char * interned = nullptr;
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_context_intern_name(&context, "/a", &interned));
+  rcl_reset_error();
+  ret = rcl_init(0, nullptr, &init_options, &context);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_context_intern_name(nullptr, "/a", &interned));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_context_intern_name(&context, nullptr, &interned));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_context_intern_name(&context, "/a", nullptr));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_context_release_name(nullptr));
+  rcl_reset_error();
+
+  // Equal names share one copy, whatever storage they came from
+  std::vector<const char *> names;
+  for (int i = 0; i < 1000; ++i) {
+    std::string name = "/topic_" + std::to_string(i % 100);
+    ASSERT_EQ(RCL_RET_OK, rcl_context_intern_name(&context, name.c_str(), &interned)) <<
+      rcl_get_error_string().str;
+    EXPECT_EQ(name, interned);
+    if (i >= 100) {
+      EXPECT_EQ(names[i % 100], interned);
+    }
+    names.push_back(interned);
+  }
+  EXPECT_NE(names[0], names[1]);
+  // Dropping every reference but the first keeps the names alive
+  for (size_t i = 100; i < names.size(); ++i) {
+    EXPECT_EQ(RCL_RET_OK, rcl_context_release_name(names[i]));
+  }
+  ASSERT_EQ(RCL_RET_OK, rcl_context_intern_name(&context, "/topic_7", &interned));
+  EXPECT_EQ(names[7], interned);
+  EXPECT_EQ(RCL_RET_OK, rcl_context_release_name(interned));
+
+  // Names still referenced outlive the context
+  ASSERT_EQ(RCL_RET_OK, rcl_shutdown(&context)) << rcl_get_error_string().str;
+  ASSERT_EQ(RCL_RET_OK, rcl_context_fini(&context)) << rcl_get_error_string().str;
+  EXPECT_STREQ("/topic_42", names[42]);
+  for (size_t i = 0; i < 100; ++i) {
+    EXPECT_EQ(RCL_RET_OK, rcl_context_release_name(names[i]));
+  }
+}
+
 TEST_F(CLASSNAME(TestContextFixture, RMW_IMPLEMENTATION), bad_fini) {
   EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_context_fini(nullptr));
   rcl_reset_error();
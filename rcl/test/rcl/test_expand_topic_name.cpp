@@ -14,14 +14,12 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
 #include <sstream>
 #include <string>
 #include <tuple>
 #include <vector>
 
-#include "rcutils/repl_str.h"
-#include "rcutils/strdup.h"
-
 #include "rcl/expand_topic_name.h"
 
 #include "rcl/error_handling.h"
@@ -186,13 +184,14 @@ TEST(test_expand_topic_name, internal_error) {
   }
 
   {
+    // the expanded name is allocated once, whatever the substitutions
+    rcl_allocator_t bad_allocator = get_failing_allocator();
     constexpr char topic_name_with_valid_substitution[] = "{node}/test";
-    auto mock = mocking_utils::patch_to_fail(
-      "lib:rcl", rcutils_strndup, "failed to allocate", nullptr);
     ret = rcl_expand_topic_name(
       topic_name_with_valid_substitution, node_name, ns,
-      &subs, allocator, &expanded_topic_name);
+      &subs, bad_allocator, &expanded_topic_name);
     EXPECT_EQ(RCL_RET_BAD_ALLOC, ret);
+    EXPECT_EQ(nullptr, expanded_topic_name);
     EXPECT_TRUE(rcl_error_is_set());
     rcl_reset_error();
 
@@ -205,28 +204,6 @@ TEST(test_expand_topic_name, internal_error) {
     rcl_reset_error();
   }
 
-  {
-    constexpr char topic_name[] = "{node}/test";
-    auto mock = mocking_utils::patch_to_fail(
-      "lib:rcl", rcutils_repl_str, "failed to allocate", nullptr);
-    ret = rcl_expand_topic_name(
-      topic_name, node_name, ns, &subs, allocator, &expanded_topic_name);
-    EXPECT_EQ(RCL_RET_BAD_ALLOC, ret);
-    EXPECT_TRUE(rcl_error_is_set());
-    rcl_reset_error();
-  }
-
-  {
-    constexpr char topic_name[] = "/test";
-    auto mock = mocking_utils::patch_to_fail(
-      "lib:rcl", rcutils_strdup, "failed to allocate", nullptr);
-    ret = rcl_expand_topic_name(
-      topic_name, node_name, ns, &subs, allocator, &expanded_topic_name);
-    EXPECT_EQ(RCL_RET_BAD_ALLOC, ret);
-    EXPECT_TRUE(rcl_error_is_set());
-    rcl_reset_error();
-  }
-
   ret = rcutils_string_map_fini(&subs);
   ASSERT_EQ(RCL_RET_OK, ret);
 }
@@ -345,3 +322,108 @@ TEST(test_expand_topic_name, custom_substitution) {
   ret = rcutils_string_map_fini(&subs);
   ASSERT_EQ(RCL_RET_OK, ret);
 }
+
+TEST(test_expand_topic_name, to_buffer) {
+  rcl_ret_t ret;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcutils_string_map_t subs = rcutils_get_zero_initialized_string_map();
+  rcutils_ret_t rcu_ret = rcutils_string_map_init(&subs, 0, allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, rcu_ret);
+  ret = rcl_get_default_topic_name_substitutions(&subs);
+  ASSERT_EQ(RCL_RET_OK, ret);
+  rcu_ret = rcutils_string_map_set(&subs, "ping", "pong");
+  ASSERT_EQ(RCUTILS_RET_OK, rcu_ret);
+  rcu_ret = rcutils_string_map_set(&subs, "empty", "");
+  ASSERT_EQ(RCUTILS_RET_OK, rcu_ret);
+
+  char buffer[RCL_EXPANDED_TOPIC_NAME_BUFFER_SIZE];
+  size_t length = 0u;
+
+  // same results as the allocating flavor
+  std::vector<std::vector<std::string>> topics_that_should_expand_to = {
+    // {"input_topic", "node_name", "/namespace", "expected result"},
+    {"/chatter", "my_node", "/my_ns", "/chatter"},
+    {"chatter", "my_node", "/", "/chatter"},
+    {"{node}/chatter", "my_node", "/my_ns", "/my_ns/my_node/chatter"},
+    {"{namespace}/{node}/{ping}", "my_node", "/my_ns", "/my_ns/my_node/pong"},
+    {"{ns}/{ns}", "my_node", "/my_ns", "/my_ns//my_ns"},
+    {"{empty}{ns}/chatter", "my_node", "/my_ns", "/my_ns/chatter"},
+    {"{empty}chatter", "my_node", "/my_ns", "/my_ns/chatter"},
+    {"~/{ping}", "my_node", "/my_ns", "/my_ns/my_node/pong"},
+    {"~", "my_node", "/", "/my_node"},
+  };
+  for (const auto & inout : topics_that_should_expand_to) {
+    const char * topic = inout.at(0).c_str();
+    const char * node = inout.at(1).c_str();
+    const char * ns = inout.at(2).c_str();
+    ret = rcl_expand_topic_name_to_buffer(
+      topic, node, ns, &subs, buffer, sizeof(buffer), &length);
+    ASSERT_EQ(RCL_RET_OK, ret) << topic << ": " << rcl_get_error_string().str;
+    EXPECT_STREQ(inout.at(3).c_str(), buffer) << topic;
+    EXPECT_EQ(inout.at(3).size(), length) << topic;
+
+    char * expanded_topic = nullptr;
+    ret = rcl_expand_topic_name(topic, node, ns, &subs, allocator, &expanded_topic);
+    ASSERT_EQ(RCL_RET_OK, ret) << topic << ": " << rcl_get_error_string().str;
+    EXPECT_STREQ(buffer, expanded_topic) << topic;
+    allocator.deallocate(expanded_topic, allocator.state);
+  }
+
+  // measure, then expand into a buffer of exactly the right size
+  ret = rcl_expand_topic_name_to_buffer(
+    "{node}/chatter", "my_node", "/my_ns", &subs, nullptr, 0u, &length);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  EXPECT_EQ(strlen("/my_ns/my_node/chatter"), length);
+  std::vector<char> exact(length + 1u, 'x');
+  ret = rcl_expand_topic_name_to_buffer(
+    "{node}/chatter", "my_node", "/my_ns", &subs, exact.data(), exact.size() - 1u, &length);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  EXPECT_STREQ("", exact.data());
+  ret = rcl_expand_topic_name_to_buffer(
+    "{node}/chatter", "my_node", "/my_ns", &subs, exact.data(), exact.size(), &length);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_STREQ("/my_ns/my_node/chatter", exact.data());
+
+  // names longer than the stack buffer still expand with the allocating flavor
+  std::string long_node(200u, 'n');
+  std::string long_topic = "{node}/{node}/{node}";
+  std::string expected = "/my_ns/" + long_node + "/" + long_node + "/" + long_node;
+  ret = rcl_expand_topic_name_to_buffer(
+    long_topic.c_str(), long_node.c_str(), "/my_ns", &subs, buffer, sizeof(buffer), &length);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  EXPECT_EQ(expected.size(), length);
+  char * expanded_topic = nullptr;
+  ret = rcl_expand_topic_name(
+    long_topic.c_str(), long_node.c_str(), "/my_ns", &subs, allocator, &expanded_topic);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_STREQ(expected.c_str(), expanded_topic);
+  allocator.deallocate(expanded_topic, allocator.state);
+
+  // invalid arguments and unknown substitutions
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_expand_topic_name_to_buffer(
+      "chatter", "my_node", "/my_ns", &subs, nullptr, sizeof(buffer), &length));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_expand_topic_name_to_buffer(
+      "chatter", "my_node", "/my_ns", &subs, buffer, sizeof(buffer), nullptr));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_TOPIC_NAME_INVALID,
+    rcl_expand_topic_name_to_buffer(
+      "white space", "my_node", "/my_ns", &subs, buffer, sizeof(buffer), &length));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_UNKNOWN_SUBSTITUTION,
+    rcl_expand_topic_name_to_buffer(
+      "{doesnotexist}/chatter", "my_node", "/my_ns", &subs, buffer, sizeof(buffer), &length));
+  rcl_reset_error();
+
+  ret = rcutils_string_map_fini(&subs);
+  ASSERT_EQ(RCL_RET_OK, ret);
+}
@@ -35,6 +35,7 @@
 
 #include "rcutils/logging_macros.h"
 #include "rcutils/logging.h"
+#include "rcutils/strdup.h"
 
 #include "test_msgs/msg/basic_types.h"
 #include "test_msgs/srv/basic_types.h"
@@ -796,6 +797,83 @@ TEST_F(
   rcl_reset_error();
 }
 
+/* Test the rcl_wait_for_topic_endpoints function.
+ */
+TEST_F(
+  CLASSNAME(TestGraphFixture, RMW_IMPLEMENTATION),
+  test_rcl_wait_for_topic_endpoints
+) {
+  rcl_ret_t ret;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  const char * pub_topic_name = "/topic_test_rcl_wait_for_topic_endpoints_pub";
+  const char * sub_topic_name = "/topic_test_rcl_wait_for_topic_endpoints_sub";
+  rcl_topic_endpoint_condition_t conditions[] = {
+    {pub_topic_name, RMW_ENDPOINT_PUBLISHER, 1u, false},
+    {sub_topic_name, RMW_ENDPOINT_SUBSCRIPTION, 1u, false},
+    {pub_topic_name, RMW_ENDPOINT_SUBSCRIPTION, 0u, false},
+  };
+  bool success = false;
+
+  // Invalid arguments
+  ret = rcl_wait_for_topic_endpoints(nullptr, &allocator, conditions, 3u, 100, &success);
+  EXPECT_EQ(RCL_RET_NODE_INVALID, ret);
+  rcl_reset_error();
+  ret = rcl_wait_for_topic_endpoints(this->old_node_ptr, &allocator, conditions, 3u, 100, &success);
+  EXPECT_EQ(RCL_RET_NODE_INVALID, ret);
+  rcl_reset_error();
+  ret = rcl_wait_for_topic_endpoints(this->node_ptr, nullptr, conditions, 3u, 100, &success);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_wait_for_topic_endpoints(this->node_ptr, &allocator, nullptr, 3u, 100, &success);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_wait_for_topic_endpoints(this->node_ptr, &allocator, conditions, 0u, 100, &success);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_wait_for_topic_endpoints(this->node_ptr, &allocator, conditions, 3u, 100, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  rcl_topic_endpoint_condition_t bad_condition = {pub_topic_name, RMW_ENDPOINT_INVALID, 1u, false};
+  ret = rcl_wait_for_topic_endpoints(this->node_ptr, &allocator, &bad_condition, 1u, 100, &success);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  // Nothing there yet, only the condition expecting no endpoints is satisfied
+  ret = rcl_wait_for_topic_endpoints(this->node_ptr, &allocator, conditions, 3u, 100, &success);
+  EXPECT_EQ(RCL_RET_TIMEOUT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  EXPECT_FALSE(success);
+  EXPECT_FALSE(conditions[0].is_satisfied);
+  EXPECT_FALSE(conditions[1].is_satisfied);
+  EXPECT_TRUE(conditions[2].is_satisfied);
+
+  rcl_publisher_t pub = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t pub_ops = rcl_publisher_get_default_options();
+  auto ts = ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  ret = rcl_publisher_init(&pub, this->node_ptr, ts, pub_topic_name, &pub_ops);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&pub, this->node_ptr));
+  });
+  rcl_subscription_t sub = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t sub_ops = rcl_subscription_get_default_options();
+  ret = rcl_subscription_init(&sub, this->node_ptr, ts, sub_topic_name, &sub_ops);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&sub, this->node_ptr));
+  });
+
+  ret = rcl_wait_for_topic_endpoints(
+    this->node_ptr, &allocator, conditions, 3u, RCUTILS_S_TO_NS(4), &success);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_TRUE(success);
+  for (const rcl_topic_endpoint_condition_t & condition : conditions) {
+    EXPECT_TRUE(condition.is_satisfied) << condition.topic_name;
+  }
+}
+
 void
 check_entity_count(
   const rcl_node_t * node_ptr,
@@ -1262,6 +1340,291 @@ TEST_F(CLASSNAME(TestGraphFixture, RMW_IMPLEMENTATION), test_graph_query_functio
     std::chrono::seconds(4));  // timeout
 }
 
+/* Test graph queries answered from the graph cache of the context.
+ */
+TEST_F(CLASSNAME(TestGraphFixture, RMW_IMPLEMENTATION), test_graph_cache)
+{
+  std::string topic_name("/test_graph_cache__");
+  std::chrono::nanoseconds now = std::chrono::system_clock::now().time_since_epoch();
+  topic_name += std::to_string(now.count());
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_context_configure_graph_cache(nullptr, true));
+  rcl_reset_error();
+  uint64_t version = 0u;
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_context_get_graph_version(nullptr, &version));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_context_get_graph_version(this->context_ptr, nullptr));
+  rcl_reset_error();
+
+  rcl_ret_t ret = rcl_context_configure_graph_cache(this->context_ptr, true);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_context_configure_graph_cache(this->context_ptr, false));
+  });
+
+  size_t count = 1u;
+  ret = rcl_count_publishers(this->node_ptr, topic_name.c_str(), &count);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, count);
+
+  rcl_publisher_t pub = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t pub_ops = rcl_publisher_get_default_options();
+  auto ts = ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  ret = rcl_publisher_init(&pub, this->node_ptr, ts, topic_name.c_str(), &pub_ops);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&pub, this->node_ptr));
+  });
+
+  // Waiting on the graph guard condition moves the graph version, refreshing the cache
+  bool success = false;
+  ret = rcl_wait_for_publishers(
+    this->node_ptr, &allocator, topic_name.c_str(), 1u, RCUTILS_S_TO_NS(4), &success);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_TRUE(success);
+  ret = rcl_count_publishers(this->node_ptr, topic_name.c_str(), &count);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(1u, count);
+
+  // While the version stays the same, repeated queries get the same answer
+  ret = rcl_context_get_graph_version(this->context_ptr, &version);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_names_and_types_t first = rcl_get_zero_initialized_names_and_types();
+  rcl_names_and_types_t second = rcl_get_zero_initialized_names_and_types();
+  ret = rcl_get_topic_names_and_types(this->node_ptr, &allocator, false, &first);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_names_and_types_fini(&first));
+    EXPECT_EQ(RCL_RET_OK, rcl_names_and_types_fini(&second));
+  });
+  ret = rcl_get_topic_names_and_types(this->node_ptr, &allocator, false, &second);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  uint64_t new_version = 0u;
+  ret = rcl_context_get_graph_version(this->context_ptr, &new_version);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  if (version == new_version) {
+    ASSERT_EQ(first.names.size, second.names.size);
+    for (size_t i = 0u; i < first.names.size; ++i) {
+      EXPECT_STREQ(first.names.data[i], second.names.data[i]);
+      ASSERT_EQ(first.types[i].size, second.types[i].size);
+    }
+  }
+  bool found = false;
+  for (size_t i = 0u; i < second.names.size; ++i) {
+    found = found || topic_name == second.names.data[i];
+  }
+  EXPECT_TRUE(found);
+
+  rcutils_string_array_t node_names = rcutils_get_zero_initialized_string_array();
+  rcutils_string_array_t node_namespaces = rcutils_get_zero_initialized_string_array();
+  for (int i = 0; i < 2; ++i) {
+    ret = rcl_get_node_names(this->node_ptr, allocator, &node_names, &node_namespaces);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(node_names.size, node_namespaces.size);
+    EXPECT_LE(1u, node_names.size);
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&node_names));
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&node_namespaces));
+  }
+}
+
+/* Test names and types lists packed in a single block.
+ */
+TEST_F(CLASSNAME(TestGraphFixture, RMW_IMPLEMENTATION), test_names_and_types_arena)
+{
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_names_and_types_t nat = rcl_get_zero_initialized_names_and_types();
+  ASSERT_EQ(RCL_RET_OK, rcl_names_and_types_init(&nat, 3u, &allocator));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_names_and_types_fini(&nat));
+  });
+  const char * names[] = {"/a/_action/feedback", "/b", "/_action/feedback/c"};
+  const char * types[] = {"pkg/action/A_FeedbackMessage", "pkg/msg/B", "pkg/msg/C"};
+  for (size_t i = 0u; i < 3u; ++i) {
+    nat.names.data[i] = rcutils_strdup(names[i], allocator);
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_init(&nat.types[i], 1u, &allocator));
+    nat.types[i].data[0] = rcutils_strdup(types[i], allocator);
+  }
+
+  rcl_names_and_types_arena_t arena = rcl_get_zero_initialized_names_and_types_arena();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_names_and_types_arena_copy(nullptr, nullptr, nullptr, &allocator, &arena));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_names_and_types_arena_copy(&nat, nullptr, nullptr, nullptr, &arena));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_names_and_types_arena_copy(&nat, nullptr, nullptr, &allocator, nullptr));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_names_and_types_arena_fini(nullptr));
+  rcl_reset_error();
+
+  // Unfiltered copy
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_names_and_types_arena_copy(&nat, nullptr, nullptr, &allocator, &arena)) <<
+    rcl_get_error_string().str;
+  ASSERT_EQ(3u, arena.names_and_types.names.size);
+  for (size_t i = 0u; i < 3u; ++i) {
+    EXPECT_STREQ(names[i], arena.names_and_types.names.data[i]);
+    ASSERT_EQ(1u, arena.names_and_types.types[i].size);
+    EXPECT_STREQ(types[i], arena.names_and_types.types[i].data[0]);
+  }
+  // Copying into a used arena is refused
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_names_and_types_arena_copy(&nat, nullptr, nullptr, &allocator, &arena));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_OK, rcl_names_and_types_arena_fini(&arena));
+  EXPECT_EQ(nullptr, arena.block);
+
+  // Only names ending with the suffix are kept, the suffix is not searched for elsewhere
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_names_and_types_arena_copy(
+      &nat, "/_action/feedback", "_FeedbackMessage", &allocator, &arena)) <<
+    rcl_get_error_string().str;
+  ASSERT_EQ(1u, arena.names_and_types.names.size);
+  EXPECT_STREQ("/a", arena.names_and_types.names.data[0]);
+  ASSERT_EQ(1u, arena.names_and_types.types[0].size);
+  EXPECT_STREQ("pkg/action/A", arena.names_and_types.types[0].data[0]);
+  EXPECT_EQ(RCL_RET_OK, rcl_names_and_types_arena_fini(&arena));
+
+  // A name which is only the suffix is kept, with an empty name
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_names_and_types_arena_copy(&nat, "/b", nullptr, &allocator, &arena)) <<
+    rcl_get_error_string().str;
+  ASSERT_EQ(1u, arena.names_and_types.names.size);
+  EXPECT_STREQ("", arena.names_and_types.names.data[0]);
+  EXPECT_EQ(RCL_RET_OK, rcl_names_and_types_arena_fini(&arena));
+
+  // Nothing kept, nothing allocated
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_names_and_types_arena_copy(&nat, "/none", nullptr, &allocator, &arena));
+  EXPECT_EQ(0u, arena.names_and_types.names.size);
+  EXPECT_EQ(nullptr, arena.block);
+  EXPECT_EQ(RCL_RET_OK, rcl_names_and_types_arena_fini(&arena));
+
+  // Querying the graph, from the middleware and then from the graph cache
+  EXPECT_EQ(
+    RCL_RET_NODE_INVALID, rcl_get_topic_names_and_types_arena(
+      this->old_node_ptr, &allocator, false, nullptr, nullptr, &arena));
+  rcl_reset_error();
+  ASSERT_EQ(RCL_RET_OK, rcl_context_configure_graph_cache(this->context_ptr, true));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_context_configure_graph_cache(this->context_ptr, false));
+  });
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_EQ(
+      RCL_RET_OK, rcl_get_topic_names_and_types_arena(
+        this->node_ptr, &allocator, false, nullptr, nullptr, &arena)) <<
+      rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_names_and_types_arena_fini(&arena));
+  }
+}
+
+/* Test the graph change stream reports a snapshot, then the changes after it.
+ */
+TEST_F(CLASSNAME(TestGraphFixture, RMW_IMPLEMENTATION), test_rcl_get_graph_changes)
+{
+  std::string topic_name("/test_rcl_get_graph_changes__");
+  std::chrono::nanoseconds now = std::chrono::system_clock::now().time_since_epoch();
+  topic_name += std::to_string(now.count());
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_graph_change_array_t changes = rcl_get_zero_initialized_graph_change_array();
+  uint64_t latest_version = 0u;
+
+  EXPECT_EQ(
+    RCL_RET_NODE_INVALID,
+    rcl_get_graph_changes(nullptr, &allocator, 0u, &changes, &latest_version));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_NODE_INVALID,
+    rcl_get_graph_changes(this->old_node_ptr, &allocator, 0u, &changes, &latest_version));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_get_graph_changes(this->node_ptr, nullptr, 0u, &changes, &latest_version));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_get_graph_changes(this->node_ptr, &allocator, 0u, nullptr, &latest_version));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_get_graph_changes(this->node_ptr, &allocator, 0u, &changes, nullptr));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_graph_change_array_fini(nullptr));
+  rcl_reset_error();
+
+  // Starting from nothing gives the whole graph, which includes this node
+  rcl_ret_t ret = rcl_get_graph_changes(
+    this->node_ptr, &allocator, 0u, &changes, &latest_version);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_TRUE(changes.is_full_snapshot);
+  bool found = false;
+  for (size_t i = 0u; i < changes.size; ++i) {
+    found = found || (RCL_GRAPH_CHANGE_NODE_ADDED == changes.data[i].kind &&
+      std::string(this->test_graph_node_name) == changes.data[i].node_name);
+  }
+  EXPECT_TRUE(found);
+  // The array must be zero initialized
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_get_graph_changes(this->node_ptr, &allocator, 0u, &changes, &latest_version));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_OK, rcl_graph_change_array_fini(&changes));
+  EXPECT_EQ(nullptr, changes.data);
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_get_graph_changes(
+      this->node_ptr, &allocator, latest_version + 1u, &changes, &latest_version));
+  rcl_reset_error();
+
+  rcl_publisher_t pub = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t pub_ops = rcl_publisher_get_default_options();
+  auto ts = ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  ret = rcl_publisher_init(&pub, this->node_ptr, ts, topic_name.c_str(), &pub_ops);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&pub, this->node_ptr));
+  });
+
+  // The graph is only snapshot again once rcl sees the graph guard condition
+  // triggered, waiting for an impossible count lets it do so.
+  uint64_t since_version = latest_version;
+  found = false;
+  for (size_t attempt = 0u; attempt < 40u && !found; ++attempt) {
+    ret = rcl_get_graph_changes(
+      this->node_ptr, &allocator, since_version, &changes, &latest_version);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_FALSE(changes.is_full_snapshot);
+    EXPECT_EQ(latest_version - since_version, changes.size);
+    for (size_t i = 0u; i < changes.size; ++i) {
+      EXPECT_LT(since_version, changes.data[i].version);
+      found = found || (RCL_GRAPH_CHANGE_ENDPOINT_ADDED == changes.data[i].kind &&
+        RMW_ENDPOINT_PUBLISHER == changes.data[i].endpoint_type &&
+        topic_name == changes.data[i].topic_name);
+    }
+    EXPECT_EQ(RCL_RET_OK, rcl_graph_change_array_fini(&changes));
+    since_version = latest_version;
+    if (!found) {
+      bool success = false;
+      ret = rcl_wait_for_publishers(
+        this->node_ptr, &allocator, topic_name.c_str(), 2u, RCUTILS_MS_TO_NS(100), &success);
+      ASSERT_EQ(RCL_RET_TIMEOUT, ret) << rcl_get_error_string().str;
+    }
+  }
+  EXPECT_TRUE(found);
+}
+
 /* Test the graph guard condition notices below changes.
  * publisher create/destroy, subscription create/destroy
  * service create/destroy, client create/destroy
@@ -1558,6 +1921,89 @@ TEST_F(CLASSNAME(TestGraphFixture, RMW_IMPLEMENTATION), test_bad_server_availabl
   rcl_reset_error();
 }
 
+/* Test the cached server availability and rcl_wait_for_service_server.
+ */
+TEST_F(CLASSNAME(TestGraphFixture, RMW_IMPLEMENTATION), test_rcl_wait_for_service_server) {
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  auto ts = ROSIDL_GET_SRV_TYPE_SUPPORT(test_msgs, srv, BasicTypes);
+  const char * service_name = "/service_test_rcl_wait_for_service_server";
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  rcl_ret_t ret = rcl_client_init(&client, this->node_ptr, ts, service_name, &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_client_fini(&client, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+
+  EXPECT_EQ(
+    RCL_RET_NODE_INVALID, rcl_client_configure_server_availability_cache(&client, nullptr, true));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_CLIENT_INVALID,
+    rcl_client_configure_server_availability_cache(nullptr, this->node_ptr, true));
+  rcl_reset_error();
+  uint64_t version = 0u;
+  EXPECT_EQ(RCL_RET_NODE_INVALID, rcl_node_get_graph_version(nullptr, &version));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_node_get_graph_version(this->node_ptr, nullptr));
+  rcl_reset_error();
+  bool success = false;
+  EXPECT_EQ(
+    RCL_RET_NODE_INVALID, rcl_wait_for_service_server(nullptr, &allocator, &client, 0, &success));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_CLIENT_INVALID,
+    rcl_wait_for_service_server(this->node_ptr, &allocator, nullptr, 0, &success));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_wait_for_service_server(this->node_ptr, &allocator, &client, 0, nullptr));
+  rcl_reset_error();
+
+  ret = rcl_client_configure_server_availability_cache(&client, this->node_ptr, true);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  bool is_available = true;
+  ret = rcl_service_server_is_available(this->node_ptr, &client, &is_available);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_FALSE(is_available);
+  ret = rcl_wait_for_service_server(
+    this->node_ptr, &allocator, &client, RCUTILS_MS_TO_NS(10), &success);
+  EXPECT_EQ(RCL_RET_TIMEOUT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  EXPECT_FALSE(success);
+
+  ret = rcl_node_get_graph_version(this->node_ptr, &version);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  ret = rcl_service_init(&service, this->node_ptr, ts, service_name, &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_service_fini(&service, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  ret = rcl_wait_for_service_server(
+    this->node_ptr, &allocator, &client, RCUTILS_S_TO_NS(10), &success);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_TRUE(success);
+  // Waiting saw the graph change, and the cached answer was refreshed accordingly
+  uint64_t new_version = 0u;
+  ret = rcl_node_get_graph_version(this->node_ptr, &new_version);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_LT(version, new_version);
+  ret = rcl_service_server_is_available(this->node_ptr, &client, &is_available);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_TRUE(is_available);
+
+  ret = rcl_client_configure_server_availability_cache(&client, nullptr, false);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
+
 /* Test passing invalid params to get_node_names functions
  */
 TEST_F(CLASSNAME(TestGraphFixture, RMW_IMPLEMENTATION), test_bad_get_node_names) {
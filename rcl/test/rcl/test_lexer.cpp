@@ -366,3 +366,19 @@ TEST_F(CLASSNAME(TestLexerFixture, RMW_IMPLEMENTATION), test_eof)
 {
   EXPECT_LEX(RCL_LEXEME_EOF, "", "");
 }
+
+TEST_F(CLASSNAME(TestLexerFixture, RMW_IMPLEMENTATION), test_long_token)
+{
+  // Long runs of token characters are consumed at once, stopping at the first other character
+  const std::string token(1000u, 'x');
+  EXPECT_LEX(RCL_LEXEME_TOKEN, token.c_str(), token.c_str());
+  EXPECT_LEX(RCL_LEXEME_TOKEN, token.c_str(), (token + "/foo").c_str());
+  EXPECT_LEX(RCL_LEXEME_TOKEN, (token + "_").c_str(), (token + "_:").c_str());
+  EXPECT_LEX(RCL_LEXEME_TOKEN, (token + "_").c_str(), (token + "__").c_str());
+}
+
+TEST_F(CLASSNAME(TestLexerFixture, RMW_IMPLEMENTATION), test_non_ascii)
+{
+  EXPECT_LEX(RCL_LEXEME_NONE, "\xc3", "\xc3\xa9");
+  EXPECT_LEX(RCL_LEXEME_TOKEN, "foo", "foo\xc3\xa9");
+}
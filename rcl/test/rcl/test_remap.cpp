@@ -14,6 +14,9 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include "rcl/arguments.h"
 #include "rcl/rcl.h"
 #include "rcl/remap.h"
@@ -563,6 +566,102 @@ TEST_F(CLASSNAME(TestRemapFixture, RMW_IMPLEMENTATION), url_scheme_rostopic) {
   EXPECT_EQ(NULL, output);
 }
 
+TEST_F(CLASSNAME(TestRemapFixture, RMW_IMPLEMENTATION), wildcard_topic_remap) {
+  rcl_arguments_t global_arguments;
+  SCOPE_ARGS(
+    global_arguments, "process_name", "--ros-args",
+    "-r", "/one/*/end:=/one_token",
+    "-r", "/many/**/end:=/many_tokens",
+    "-r", "~/*:=private_token",
+    "-r", "/one/exact/end:=/too_late");
+
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  std::vector<std::vector<std::string>> topics_that_should_remap_to = {
+    // {"topic", "expected result", or "" if not remapped},
+    {"/one/a/end", "/one_token"},
+    {"/one/exact/end", "/one_token"},
+    {"/one/end", ""},
+    {"/one/a/b/end", ""},
+    {"/many/end", "/many_tokens"},
+    {"/many/a/end", "/many_tokens"},
+    {"/many/a/b/c/end", "/many_tokens"},
+    {"/many/a/b/c", ""},
+    {"/ns/NodeName/foo", "/ns/NodeName/private_token"},
+    {"/ns/NodeName/foo/bar", ""},
+    {"/ns/OtherNode/foo", ""},
+  };
+  for (const auto & inout : topics_that_should_remap_to) {
+    char * output = NULL;
+    rcl_ret_t ret = rcl_remap_topic_name(
+      NULL, &global_arguments, inout[0].c_str(), "NodeName", "/ns", allocator, &output);
+    EXPECT_EQ(RCL_RET_OK, ret) << inout[0];
+    if (inout[1].empty()) {
+      EXPECT_EQ(NULL, output) << inout[0];
+    } else {
+      EXPECT_STREQ(inout[1].c_str(), output) << inout[0];
+    }
+    allocator.deallocate(output, allocator.state);
+  }
+}
+
+TEST_F(CLASSNAME(TestRemapFixture, RMW_IMPLEMENTATION), many_topic_rules) {
+  // Rules generated by a launch system, matched in order through a copy of the arguments
+  std::vector<std::string> rules;
+  for (int i = 0; i < 1000; ++i) {
+    rules.push_back("/robot" + std::to_string(i) + "/scan:=/scan" + std::to_string(i));
+    rules.push_back("node" + std::to_string(i) + ":cmd:=cmd" + std::to_string(i));
+  }
+  rules.push_back("/robot0/scan:=/never");
+  std::vector<const char *> argv = {"process_name", "--ros-args"};
+  for (const std::string & rule : rules) {
+    argv.push_back("-r");
+    argv.push_back(rule.c_str());
+  }
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_arguments_t parsed_arguments = rcl_get_zero_initialized_arguments();
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_parse_arguments(static_cast<int>(argv.size()), argv.data(), allocator, &parsed_arguments))
+    << rcl_get_error_string().str;
+  rcl_arguments_t arguments = rcl_get_zero_initialized_arguments();
+  ASSERT_EQ(RCL_RET_OK, rcl_arguments_copy(&parsed_arguments, &arguments))
+    << rcl_get_error_string().str;
+  EXPECT_EQ(RCL_RET_OK, rcl_arguments_fini(&parsed_arguments));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_arguments_fini(&arguments));
+  });
+
+  for (int i = 0; i < 1000; i += 111) {
+    char * output = NULL;
+    std::string topic = "/robot" + std::to_string(i) + "/scan";
+    ASSERT_EQ(
+      RCL_RET_OK,
+      rcl_remap_topic_name(NULL, &arguments, topic.c_str(), "any", "/", allocator, &output));
+    EXPECT_EQ("/scan" + std::to_string(i), output ? std::string(output) : std::string());
+    allocator.deallocate(output, allocator.state);
+
+    std::string node_name = "node" + std::to_string(i);
+    ASSERT_EQ(
+      RCL_RET_OK,
+      rcl_remap_topic_name(
+        NULL, &arguments, "/ns/cmd", node_name.c_str(), "/ns", allocator, &output));
+    EXPECT_EQ("/ns/cmd" + std::to_string(i), output ? std::string(output) : std::string());
+    allocator.deallocate(output, allocator.state);
+  }
+  char * output = NULL;
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_remap_topic_name(NULL, &arguments, "/ns/cmd", "nobody", "/ns", allocator, &output));
+  EXPECT_EQ(NULL, output);
+
+  // The names the matches are expanded with are still validated
+  EXPECT_EQ(
+    RCL_RET_NODE_INVALID_NAMESPACE,
+    rcl_remap_topic_name(NULL, &arguments, "/ns/cmd", "any", "no_slash", allocator, &output));
+  rcl_reset_error();
+}
+
 TEST_F(CLASSNAME(TestRemapFixture, RMW_IMPLEMENTATION), _rcl_remap_name_bad_arg) {
   rcl_arguments_t global_arguments;
   SCOPE_ARGS(global_arguments, "process_name", "--ros-args", "-r", "__node:=global_name");
@@ -14,6 +14,9 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <thread>
+
 #include "rcl/service.h"
 #include "rcl/rcl.h"
 
@@ -336,6 +339,243 @@ TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_service_without_i
   test_msgs__srv__BasicTypes_Response__fini(&client_response);
 }
 
+/* Taking requests and sending responses in batches.
+ */
+TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_service_batch) {
+  rcl_ret_t ret;
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, BasicTypes);
+  const char * topic = "primitives";
+  constexpr size_t kNumRequests = 3u;
+
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_service_fini(&service, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  ret = rcl_client_init(&client, this->node_ptr, ts, topic, &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_client_fini(&client, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  ASSERT_TRUE(wait_for_server_to_be_available(this->node_ptr, &client, 10, 1000));
+
+  for (size_t i = 0u; i < kNumRequests; ++i) {
+    test_msgs__srv__BasicTypes_Request client_request;
+    test_msgs__srv__BasicTypes_Request__init(&client_request);
+    client_request.bool_value = false;
+    client_request.uint32_value = static_cast<uint32_t>(i);
+    int64_t sequence_number = 0;
+    ret = rcl_send_request(&client, &client_request, &sequence_number);
+    test_msgs__srv__BasicTypes_Request__fini(&client_request);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+
+  test_msgs__srv__BasicTypes_Request service_requests[kNumRequests + 1];
+  test_msgs__srv__BasicTypes_Response service_responses[kNumRequests + 1];
+  void * request_data[kNumRequests + 1];
+  void * response_data[kNumRequests + 1];
+  rmw_service_info_t headers[kNumRequests + 1];
+  for (size_t i = 0u; i < kNumRequests + 1; ++i) {
+    test_msgs__srv__BasicTypes_Request__init(&service_requests[i]);
+    test_msgs__srv__BasicTypes_Response__init(&service_responses[i]);
+    request_data[i] = &service_requests[i];
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    for (size_t i = 0u; i < kNumRequests + 1; ++i) {
+      test_msgs__srv__BasicTypes_Request__fini(&service_requests[i]);
+      test_msgs__srv__BasicTypes_Response__fini(&service_responses[i]);
+    }
+  });
+
+  // Requests may arrive in several chunks, keep draining until all of them are taken
+  size_t num_taken = 0u;
+  for (size_t attempt = 0u; attempt < 10u && num_taken < kNumRequests; ++attempt) {
+    if (!wait_for_service_to_be_ready(&service, context_ptr, 10, 100)) {
+      continue;
+    }
+    rmw_message_sequence_t request_sequence = rmw_get_zero_initialized_message_sequence();
+    request_sequence.data = &request_data[num_taken];
+    request_sequence.capacity = kNumRequests + 1 - num_taken;
+    ret = rcl_take_request_sequence(
+      &service, kNumRequests + 1 - num_taken, &request_sequence, &headers[num_taken]);
+    if (RCL_RET_SERVICE_TAKE_FAILED == ret) {
+      continue;
+    }
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_GT(request_sequence.size, 0u);
+    num_taken += request_sequence.size;
+  }
+  ASSERT_EQ(kNumRequests, num_taken);
+
+  rmw_request_id_t response_headers[kNumRequests];
+  for (size_t i = 0u; i < kNumRequests; ++i) {
+    EXPECT_EQ(i, service_requests[i].uint32_value);
+    service_responses[i].uint64_value = service_requests[i].uint32_value + 1u;
+    response_data[i] = &service_responses[i];
+    response_headers[i] = headers[i].request_id;
+  }
+  rmw_message_sequence_t response_sequence = rmw_get_zero_initialized_message_sequence();
+  response_sequence.data = response_data;
+  response_sequence.size = kNumRequests;
+  response_sequence.capacity = kNumRequests + 1;
+  ret = rcl_send_response_batch(&service, response_headers, &response_sequence);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  test_msgs__srv__BasicTypes_Response client_response;
+  test_msgs__srv__BasicTypes_Response__init(&client_response);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Response__fini(&client_response);
+  });
+  size_t num_responses = 0u;
+  for (size_t attempt = 0u; attempt < 10u && num_responses < kNumRequests; ++attempt) {
+    if (!wait_for_client_to_be_ready(&client, context_ptr, 10, 100)) {
+      continue;
+    }
+    rmw_service_info_t header;
+    while (RCL_RET_OK == rcl_take_response_with_info(&client, &header, &client_response)) {
+      EXPECT_EQ(
+        static_cast<uint64_t>(header.request_id.sequence_number), client_response.uint64_value);
+      ++num_responses;
+    }
+  }
+  EXPECT_EQ(kNumRequests, num_responses);
+
+  // Bad arguments
+  rmw_message_sequence_t request_sequence = rmw_get_zero_initialized_message_sequence();
+  request_sequence.data = request_data;
+  request_sequence.capacity = 1u;
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_take_request_sequence(&service, 2u, &request_sequence, headers));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_take_request_sequence(&service, 1u, nullptr, headers));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_take_request_sequence(&service, 1u, &request_sequence, nullptr));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_SERVICE_INVALID, rcl_take_request_sequence(nullptr, 1u, &request_sequence, headers));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_send_response_batch(&service, nullptr, &response_sequence));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_send_response_batch(&service, response_headers, nullptr));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_SERVICE_INVALID,
+    rcl_send_response_batch(nullptr, response_headers, &response_sequence));
+  rcl_reset_error();
+}
+
+/* Tracking the request queue and shedding stale requests.
+ */
+TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_service_backpressure) {
+  rcl_ret_t ret;
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, BasicTypes);
+  const char * topic = "primitives";
+
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_service_fini(&service, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_service_backpressure_options_t options = rcl_service_get_default_backpressure_options();
+  EXPECT_FALSE(options.track_pending_requests);
+  EXPECT_EQ(0, options.max_request_age);
+  options.max_request_age = -1;
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_service_configure_backpressure(&service, &options));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_service_configure_backpressure(&service, nullptr));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_SERVICE_INVALID, rcl_service_configure_backpressure(nullptr, &options));
+  rcl_reset_error();
+  rcl_service_request_queue_status_t status;
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_service_get_request_queue_status(&service, nullptr));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_SERVICE_INVALID, rcl_service_get_request_queue_status(nullptr, &status));
+  rcl_reset_error();
+
+  options.track_pending_requests = true;
+  options.max_request_age = 0;
+  ret = rcl_service_configure_backpressure(&service, &options);
+  if (RCL_RET_UNSUPPORTED == ret) {
+    rcl_reset_error();
+    GTEST_SKIP() << "new request callbacks are not supported by the middleware";
+  }
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  ret = rcl_client_init(&client, this->node_ptr, ts, topic, &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_client_fini(&client, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  ASSERT_TRUE(wait_for_server_to_be_available(this->node_ptr, &client, 10, 1000));
+
+  test_msgs__srv__BasicTypes_Request request;
+  test_msgs__srv__BasicTypes_Request__init(&request);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Request__fini(&request);
+  });
+  int64_t sequence_number = 0;
+  ASSERT_EQ(RCL_RET_OK, rcl_send_request(&client, &request, &sequence_number));
+  ASSERT_EQ(RCL_RET_OK, rcl_send_request(&client, &request, &sequence_number));
+
+  status.pending_count = 0u;
+  for (size_t attempt = 0u; attempt < 100u && status.pending_count < 2u; ++attempt) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_EQ(RCL_RET_OK, rcl_service_get_request_queue_status(&service, &status));
+  }
+  EXPECT_EQ(2u, status.pending_count);
+  EXPECT_EQ(0u, status.shed_count);
+
+  rmw_service_info_t header;
+  ret = rcl_take_request_with_info(&service, &header, &request);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(RCL_RET_OK, rcl_service_get_request_queue_status(&service, &status));
+  EXPECT_EQ(1u, status.pending_count);
+
+  // The remaining request is older than the allowed age by now, so it is shed
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  options.max_request_age = RCUTILS_MS_TO_NS(1);
+  ASSERT_EQ(RCL_RET_OK, rcl_service_configure_backpressure(&service, &options));
+  ret = rcl_take_request_with_info(&service, &header, &request);
+  EXPECT_EQ(RCL_RET_SERVICE_TAKE_FAILED, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(RCL_RET_OK, rcl_service_get_request_queue_status(&service, &status));
+  EXPECT_EQ(0u, status.pending_count);
+  if (0 != header.source_timestamp) {
+    EXPECT_EQ(1u, status.shed_count);
+    EXPECT_GT(status.last_taken_request_age, options.max_request_age);
+  }
+
+  options = rcl_service_get_default_backpressure_options();
+  EXPECT_EQ(RCL_RET_OK, rcl_service_configure_backpressure(&service, &options));
+}
+
 /* Passing bad/invalid arguments to service functions
  */
 TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_bad_arguments) {
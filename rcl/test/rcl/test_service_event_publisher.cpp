@@ -14,6 +14,7 @@
 
 #include <gtest/gtest.h>
 #include <rosidl_runtime_c/service_type_support_struct.h>
+#include <rosidl_runtime_c/string_functions.h>
 #include <service_msgs/msg/detail/service_event_info__struct.h>
 
 #include <cstdint>
@@ -700,3 +701,90 @@ TEST_F(
   ASSERT_EQ(service_msgs__msg__ServiceEventInfo__RESPONSE_RECEIVED, event_msg.info.event_type);
   ASSERT_EQ(2U, event_msg.response.data[0].uint32_value);
 }
+
+/* Test that only the sampled requests get their events published
+ */
+TEST_F(
+  CLASSNAME(TestServiceEventPublisherFixture, RMW_IMPLEMENTATION),
+  test_service_event_publisher_sampling)
+{
+  uint8_t guid[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+  auto sub_opts = rcl_subscription_get_default_options();
+  std::string topic = "test_service_event_publisher";
+  std::string service_event_topic = topic + RCL_SERVICE_INTROSPECTION_TOPIC_POSTFIX;
+  rcl_ret_t ret;
+
+  rcl_service_event_publisher_t service_event_publisher =
+    rcl_get_zero_initialized_service_event_publisher();
+
+  ret = rcl_service_event_publisher_init(
+    &service_event_publisher, node_ptr, clock_ptr, rcl_publisher_get_default_options(),
+    topic.c_str(), srv_ts);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    ret = rcl_service_event_publisher_fini(&service_event_publisher, node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  ret = rcl_service_event_publisher_change_state(
+    &service_event_publisher, RCL_SERVICE_INTROSPECTION_CONTENTS);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_service_introspection_sampling_options_t sampling_options =
+    rcl_service_introspection_get_default_sampling_options();
+  EXPECT_EQ(1u, sampling_options.ratio);
+  EXPECT_EQ(0, sampling_options.min_period);
+  sampling_options.ratio = 0u;
+  ret = rcl_service_event_publisher_set_sampling(&service_event_publisher, &sampling_options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcutils_reset_error();
+  ret = rcl_service_event_publisher_set_sampling(&service_event_publisher, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcutils_reset_error();
+  sampling_options.ratio = 2u;
+  ret = rcl_service_event_publisher_set_sampling(&service_event_publisher, &sampling_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  ret = rcl_subscription_init(
+    &subscription, node_ptr, srv_ts->event_typesupport, service_event_topic.c_str(), &sub_opts);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    ret = rcl_subscription_fini(&subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  ASSERT_TRUE(wait_for_established_subscription(service_event_publisher.publisher, 10, 100));
+
+  test_msgs__srv__BasicTypes_Request test_req;
+  test_msgs__srv__BasicTypes_Request__init(&test_req);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({test_msgs__srv__BasicTypes_Request__fini(&test_req);});
+  ASSERT_TRUE(rosidl_runtime_c__String__assign(&test_req.string_value, "sampled request"));
+
+  // Only even sequence numbers are sampled
+  for (int64_t sequence_number = 1; sequence_number <= 4; ++sequence_number) {
+    ret = rcl_send_service_event_message(
+      &service_event_publisher, service_msgs__msg__ServiceEventInfo__REQUEST_RECEIVED, &test_req,
+      sequence_number, guid);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+
+  test_msgs__srv__BasicTypes_Event event_msg;
+  test_msgs__srv__BasicTypes_Event__init(&event_msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({test_msgs__srv__BasicTypes_Event__fini(&event_msg);});
+  for (int64_t expected_sequence_number : {2, 4}) {
+    ASSERT_TRUE(wait_for_subscription_to_be_ready(&subscription, context_ptr, 10, 100));
+    rmw_message_info_t message_info = rmw_get_zero_initialized_message_info();
+    ret = rcl_take(&subscription, &event_msg, &message_info, nullptr);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(expected_sequence_number, event_msg.info.sequence_number);
+    ASSERT_EQ(1U, event_msg.request.size);
+    EXPECT_STREQ("sampled request", event_msg.request.data[0].string_value.data);
+  }
+  rmw_message_info_t message_info = rmw_get_zero_initialized_message_info();
+  EXPECT_EQ(
+    RCL_RET_SUBSCRIPTION_TAKE_FAILED,
+    rcl_take(&subscription, &event_msg, &message_info, nullptr));
+}
@@ -254,14 +254,20 @@ rcl_action_client_get_default_options(void);
  * In the event that error handling needs to allocate memory, this function
  * will try to use the node's allocator.
  *
+ * If the action client caches its server availability, see
+ * rcl_action_client_configure_server_availability_cache(), the middleware is
+ * only queried when the node's graph version has changed since the last query.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
  * Allocates Memory   | Yes
  * Thread-Safe        | No
- * Uses Atomics       | No
+ * Uses Atomics       | Maybe [2]
  * Lock-Free          | Maybe [1]
  * <i>[1] implementation may need to protect the data structure with a lock</i>
+ * <i>[2] only to read the graph version when the server availability is cached,
+ * the cached answer itself is not atomic</i>
  *
  * \param[in] node the handle to the node being used to query the ROS graph
  * \param[in] client the handle to the action client being queried
@@ -280,6 +286,45 @@ rcl_action_server_is_available(
   const rcl_action_client_t * client,
   bool * is_available);
 
+/// Cache the answer of rcl_action_server_is_available() for an action client.
+/**
+ * While enabled, rcl_action_server_is_available() only asks the middleware
+ * when the graph version of `node`, see rcl_node_get_graph_version(), has
+ * changed since the last answer.
+ * Otherwise the cached answer is returned without querying any of the action
+ * client's services or topics.
+ *
+ * The graph version only advances when something waits on the node's graph
+ * guard condition, e.g. a graph listener thread or rcl_wait_for_service_server().
+ * If nothing does, the cached answer is never refreshed, even after the action
+ * server appears or goes away.
+ *
+ * The cached answer is a plain field of the action client, so like
+ * rcl_action_server_is_available() this is not thread safe.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] action_client action client whose server availability is cached
+ * \param[in] node node the action client was created with, unused when disabling
+ * \param[in] enable whether or not to cache the server availability
+ * \return `RCL_RET_OK` if the call was successful, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_client_configure_server_availability_cache(
+  rcl_action_client_t * action_client,
+  const rcl_node_t * node,
+  bool enable);
+
 /// Send a ROS goal using a rcl_action_client_t.
 /**
  * This is a non-blocking call.
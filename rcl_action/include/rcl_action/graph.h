@@ -155,6 +155,41 @@ rcl_action_get_names_and_types(
   rcl_allocator_t * allocator,
   rcl_names_and_types_t * action_names_and_types);
 
+/// Return a list of action names and their types, held in a single block of memory.
+/**
+ * Same as rcl_action_get_names_and_types(), except that the list is packed as
+ * by rcl_get_topic_names_and_types_arena(), and must be released with
+ * rcl_names_and_types_arena_fini() instead of rcl_names_and_types_fini().
+ *
+ * Action names and types are sliced out of the topic list while it is
+ * packed, without copying each of them separately.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[in] allocator allocator for the list
+ * \param[out] action_names_and_types zero initialized arena, holding the list on success
+ * \return `RCL_RET_OK` if the query was successful, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_get_names_and_types_arena(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  rcl_names_and_types_arena_t * action_names_and_types);
+
 #ifdef __cplusplus
 }
 #endif
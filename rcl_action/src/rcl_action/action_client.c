@@ -63,6 +63,8 @@ _rcl_action_get_zero_initialized_client_impl(void)
     0,
     0,
     0,
+    0,
+    NULL,
     0
   };
   return null_action_client;
@@ -276,6 +278,22 @@ rcl_action_server_is_available(
 
   bool temp;
   rcl_ret_t ret;
+
+  // The cache is only used with the node it was configured for.
+  bool use_cache = NULL != client->impl->availability_cache_guard_condition &&
+    rcl_node_get_graph_guard_condition(node) == client->impl->availability_cache_guard_condition;
+  uint64_t graph_version = 0u;
+  if (use_cache) {
+    ret = rcl_node_get_graph_version(node, &graph_version);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error is already set
+    }
+    if ((client->impl->availability_cache >> 1) == graph_version + 1u) {
+      *is_available = (client->impl->availability_cache & 1u) != 0u;
+      return RCL_RET_OK;
+    }
+  }
+
   *is_available = true;
 
   ret = rcl_service_server_is_available(node, &(client->impl->goal_client), &temp);
@@ -312,6 +330,30 @@ rcl_action_server_is_available(
   }
   *is_available = *is_available && (number_of_publishers != 0);
 
+  if (use_cache) {
+    client->impl->availability_cache = ((graph_version + 1u) << 1) | (*is_available ? 1u : 0u);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_client_configure_server_availability_cache(
+  rcl_action_client_t * action_client,
+  const rcl_node_t * node,
+  bool enable)
+{
+  if (!rcl_action_client_is_valid(action_client)) {
+    return RCL_RET_ACTION_CLIENT_INVALID;  // error is already set
+  }
+  const rcl_guard_condition_t * graph_guard_condition = NULL;
+  if (enable) {
+    graph_guard_condition = rcl_node_get_graph_guard_condition(node);
+    if (NULL == graph_guard_condition) {
+      return RCL_RET_NODE_INVALID;  // error is already set
+    }
+  }
+  action_client->impl->availability_cache_guard_condition = graph_guard_condition;
+  action_client->impl->availability_cache = 0u;
   return RCL_RET_OK;
 }
 
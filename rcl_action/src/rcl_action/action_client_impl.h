@@ -33,6 +33,10 @@ typedef struct rcl_action_client_impl_s
   size_t wait_set_result_client_index;
   size_t wait_set_feedback_subscription_index;
   size_t wait_set_status_subscription_index;
+  // Graph guard condition the cached server availability is tied to, NULL if not cached
+  const rcl_guard_condition_t * availability_cache_guard_condition;
+  // Graph version plus one, shifted left once, with the availability in the lowest bit
+  uint64_t availability_cache;
 } rcl_action_client_impl_t;
 
 
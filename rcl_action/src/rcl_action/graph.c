@@ -18,6 +18,7 @@ extern "C"
 #endif
 
 #include <assert.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include "rcl/error_handling.h"
@@ -27,6 +28,25 @@ extern "C"
 
 #include "rcl_action/graph.h"
 
+// Assumption: actions provide a topic name with the suffix "/_action/feedback"
+// and it has type with the suffix "_FeedbackMessage"
+static const char * const action_name_identifier = "/_action/feedback";
+static const char * const action_type_identifier = "_FeedbackMessage";
+
+// Whether `name` ends with `suffix`, if so `length` is set to the length of `name` without it.
+static
+bool
+_length_without_suffix(
+  const char * name, const char * suffix, size_t suffix_len, size_t * length)
+{
+  const size_t name_len = strlen(name);
+  if (name_len < suffix_len || 0 != memcmp(name + name_len - suffix_len, suffix, suffix_len)) {
+    return false;
+  }
+  *length = name_len - suffix_len;
+  return true;
+}
+
 static
 rcl_ret_t
 _filter_action_names(
@@ -38,20 +58,17 @@ _filter_action_names(
   assert(allocator);
   assert(action_names_and_types);
 
-  // Assumption: actions provide a topic name with the suffix "/_action/feedback"
-  // and it has type with the suffix "_FeedbackMessage"
-  const char * action_name_identifier = "/_action/feedback";
-  const char * action_type_identifier = "_FeedbackMessage";
-
   rcl_ret_t ret;
   const size_t num_names = topic_names_and_types->names.size;
   char ** names = topic_names_and_types->names.data;
+  const size_t suffix_len = strlen(action_name_identifier);
+  const size_t type_suffix_len = strlen(action_type_identifier);
 
   // Count number of actions to determine how much memory to allocate
   size_t num_actions = 0u;
   for (size_t i = 0u; i < num_names; ++i) {
-    const char * identifier_index = strstr(names[i], action_name_identifier);
-    if (identifier_index && strlen(identifier_index) == strlen(action_name_identifier)) {
+    size_t action_name_len;
+    if (_length_without_suffix(names[i], action_name_identifier, suffix_len, &action_name_len)) {
       ++num_actions;
     }
   }
@@ -67,13 +84,11 @@ _filter_action_names(
 
   ret = RCL_RET_OK;
 
-  // Prune names/types that are not actions (ie. do not contain the suffix)
-  const size_t suffix_len = strlen(action_name_identifier);
+  // Prune names/types that are not actions (ie. do not end with the suffix)
   size_t j = 0u;
   for (size_t i = 0u; i < num_names; ++i) {
-    const char * identifier_index = strstr(names[i], action_name_identifier);
-    if (identifier_index && strlen(identifier_index) == strlen(action_name_identifier)) {
-      const size_t action_name_len = strlen(names[i]) - suffix_len;
+    size_t action_name_len;
+    if (_length_without_suffix(names[i], action_name_identifier, suffix_len, &action_name_len)) {
       char * action_name = rcutils_strndup(names[i], action_name_len, *allocator);
       if (!action_name) {
         RCL_SET_ERROR_MSG("Failed to allocate memory for action name");
@@ -97,14 +112,12 @@ _filter_action_names(
       // Populate types list
       for (size_t k = 0u; k < topic_names_and_types->types[i].size; ++k) {
         char * type_name = topic_names_and_types->types[i].data[k];
-        size_t action_type_len = strlen(type_name);
         // Trim type name suffix
-        const size_t type_suffix_len = strlen(action_type_identifier);
-        const char * type_identifier_index = strstr(type_name, action_type_identifier);
-        if (type_identifier_index &&
-          strlen(type_identifier_index) == strlen(action_type_identifier))
+        size_t action_type_len;
+        if (!_length_without_suffix(
+            type_name, action_type_identifier, type_suffix_len, &action_type_len))
         {
-          action_type_len = strlen(type_name) - type_suffix_len;
+          action_type_len = strlen(type_name);
         }
         // Copy name to output struct
         char * action_type_name = rcutils_strndup(type_name, action_type_len, *allocator);
@@ -232,6 +245,18 @@ rcl_action_get_names_and_types(
   return ret;
 }
 
+rcl_ret_t
+rcl_action_get_names_and_types_arena(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  rcl_names_and_types_arena_t * action_names_and_types)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(action_names_and_types, RCL_RET_INVALID_ARGUMENT);
+  return rcl_get_topic_names_and_types_arena(
+    node, allocator, false, action_name_identifier, action_type_identifier,
+    action_names_and_types);
+}
+
 #ifdef __cplusplus
 }
 #endif
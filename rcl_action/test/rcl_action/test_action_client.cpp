@@ -268,6 +268,34 @@ TEST_F(TestActionClientFixture, test_action_server_is_available) {
   EXPECT_FALSE(is_available);
 }
 
+TEST_F(TestActionClientFixture, test_action_server_availability_cache) {
+  rcl_ret_t ret = rcl_action_client_configure_server_availability_cache(
+    nullptr, &this->node, true);
+  EXPECT_EQ(ret, RCL_RET_ACTION_CLIENT_INVALID);
+  rcl_reset_error();
+
+  ret = rcl_action_client_configure_server_availability_cache(
+    &this->action_client, nullptr, true);
+  EXPECT_EQ(ret, RCL_RET_NODE_INVALID);
+  rcl_reset_error();
+
+  ret = rcl_action_client_configure_server_availability_cache(
+    &this->action_client, &this->node, true);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  // Without graph changes being observed, the cached answer is returned
+  bool is_available = true;
+  for (int i = 0; i < 3; ++i) {
+    ret = rcl_action_server_is_available(&this->node, &this->action_client, &is_available);
+    EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+    EXPECT_FALSE(is_available);
+  }
+
+  ret = rcl_action_client_configure_server_availability_cache(
+    &this->action_client, nullptr, false);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+}
+
 TEST_F(TestActionClientFixture, test_action_client_is_valid) {
   bool is_valid = rcl_action_client_is_valid(nullptr);
   EXPECT_FALSE(is_valid) << rcl_get_error_string().str;
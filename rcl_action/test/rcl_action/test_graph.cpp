@@ -255,6 +255,21 @@ TEST_F(
 
   ret = rcl_names_and_types_fini(&nat);
   EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_names_and_types_arena_t arena = rcl_get_zero_initialized_names_and_types_arena();
+  ret = rcl_action_get_names_and_types_arena(&this->old_node, &this->allocator, &arena);
+  EXPECT_EQ(RCL_RET_NODE_INVALID, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_action_get_names_and_types_arena(&this->node, &this->zero_allocator, &arena);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_action_get_names_and_types_arena(&this->node, &this->allocator, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_action_get_names_and_types_arena(&this->node, &this->allocator, &arena);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_names_and_types_arena_fini(&arena);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
 }
 
 /**
@@ -469,6 +484,19 @@ TEST_F(TestActionGraphMultiNodeFixture, test_action_get_names_and_types) {
 
   ret = rcl_names_and_types_fini(&nat);
   EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // The packed list holds the same actions
+  rcl_names_and_types_arena_t arena = rcl_get_zero_initialized_names_and_types_arena();
+  ret = rcl_action_get_names_and_types_arena(&this->node, &this->allocator, &arena);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(arena.names_and_types.names.size, 2u);
+  EXPECT_STREQ(arena.names_and_types.names.data[0], client_action_name);
+  EXPECT_STREQ(arena.names_and_types.names.data[1], server_action_name);
+  ASSERT_EQ(arena.names_and_types.types[1].size, 1u);
+  EXPECT_STREQ(arena.names_and_types.types[1].data[0], "test_msgs/action/Fibonacci");
+  ret = rcl_names_and_types_arena_fini(&arena);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(nullptr, arena.block);
 }
 
 // Note, this test could be affected by other communication on the same ROS domain
@@ -56,6 +56,18 @@ rcl_params_t * rcl_yaml_node_struct_init_with_capacity(
   size_t capacity,
   const rcutils_allocator_t allocator);
 
+/// \brief Initialize parameter structure carving all its memory from an arena
+/// Everything the structure holds is carved from large blocks obtained with \p allocator,
+/// and rcl_yaml_node_struct_fini() releases those blocks at once.
+/// Memory given back before then is not reused, so this suits structures that are
+/// parsed once and then only read, as parameter files usually are.
+/// The memory of the structure must only be managed through its own allocator.
+/// \param[in] allocator memory allocator for the blocks of the arena
+/// \return a pointer to param structure on success or NULL on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_params_t * rcl_yaml_node_struct_init_with_arena(
+  const rcutils_allocator_t allocator);
+
 /// \brief Reallocate parameter structure with a new capacity
 /// \post the address of \p node_names in \p params_st might be changed
 ///   even if the result value is `RCL_RET_BAD_ALLOC`.
@@ -74,6 +86,12 @@ rcutils_ret_t rcl_yaml_node_struct_reallocate(
   const rcutils_allocator_t allocator);
 
 /// \brief Copy parameter structure
+/// The copy has an arena of its own if \p params_st has one.
+/// Otherwise the parameters of each node are shared with \p params_st instead of being copied,
+/// until either structure modifies them through the parser. The structures may then be used and
+/// finalized independently, even from different threads, as long as their allocator is thread safe.
+/// Modifying the parameters of either structure directly, rather than through the parser,
+/// modifies them for both and is not supported.
 /// \param[in] params_st points to the parameter struct to be copied
 /// \return a pointer to the copied param structure on success or NULL on failure
 RCL_YAML_PARAM_PARSER_PUBLIC
@@ -97,6 +115,96 @@ bool rcl_parse_yaml_file(
   const char * file_path,
   rcl_params_t * params_st);
 
+/// \brief Parse the YAML file and populate \p params_st with the parameters of some nodes
+/// Only the parameters applying to at least one of \p node_names are added to \p params_st,
+/// taking the `*` and `**` wildcards of the file into account. The events of the other node
+/// sections are skipped without storing anything, nor validating their node names.
+/// \pre Given \p params_st must be a valid parameter struct
+///   as returned by `rcl_yaml_node_struct_init()`
+/// \param[in] file_path is the path to the YAML file
+/// \param[in] node_names fully qualified names of the nodes, e.g. "/ns/node"
+/// \param[in] num_node_names number of node names
+/// \param[inout] params_st points to the struct to be populated
+/// \return true on success and false on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool rcl_parse_yaml_file_for_nodes(
+  const char * file_path,
+  const char * const * node_names,
+  size_t num_node_names,
+  rcl_params_t * params_st);
+
+/// \brief Parse several YAML files concurrently and populate \p params_st
+/// The result is the same as parsing each file in turn with rcl_parse_yaml_file(), the
+/// parameters of later files overriding those of earlier ones. The files are parsed on a few
+/// threads into separate structures, which are then merged in order into \p params_st.
+/// \pre Given \p params_st must be a valid parameter struct
+///   as returned by `rcl_yaml_node_struct_init()`, and its allocator must be thread safe
+/// \param[in] file_paths paths to the YAML files, in override order
+/// \param[in] num_file_paths number of paths
+/// \param[inout] params_st points to the struct to be populated
+/// \return true on success and false on failure, the error naming the first file
+///   that failed to parse
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool rcl_parse_yaml_files(
+  const char * const * file_paths,
+  size_t num_file_paths,
+  rcl_params_t * params_st);
+
+/// \brief Return a zero initialized parameter diff
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_params_diff_t rcl_yaml_params_diff_get_zero_initialized(void);
+
+/// \brief Free the changes of a parameter diff
+/// \param[inout] diff points to the diff, left zero initialized
+RCL_YAML_PARAM_PARSER_PUBLIC
+void rcl_yaml_params_diff_fini(
+  rcl_params_diff_t * diff);
+
+/// \brief Reload a YAML file into \p params_st and report which parameters changed
+/// The file is parsed into a new structure first, \p params_st is left untouched if that fails.
+/// \p params_st is then updated in place to hold the parameters of the file only: the nodes and
+/// parameters which are not in the file anymore are removed, new ones are appended, and values
+/// that differ are replaced. Unchanged nodes and values keep their memory.
+/// The changes are reported in the order of the nodes and parameters of \p params_st, removed
+/// and changed parameters first, followed by the added ones in the order of the file.
+/// \pre Given \p params_st must be a valid parameter struct, usually populated by
+///   rcl_parse_yaml_file() with a previous version of the file
+/// \param[in] file_path is the path to the YAML file
+/// \param[inout] params_st points to the parameter struct to update
+/// \param[out] diff points to a zero initialized diff to populate with the changes, to be freed
+///   with rcl_yaml_params_diff_fini() once done
+/// \return true on success and false on failure, \p params_st being possibly partially updated
+///   if memory ran out after the file was parsed
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool rcl_yaml_node_struct_reload(
+  const char * file_path,
+  rcl_params_t * params_st,
+  rcl_params_diff_t * diff);
+
+/// \brief Write a parameter structure to a binary snapshot file
+/// Snapshots are meant to be loaded by rcl_yaml_node_struct_load_snapshot() on the same
+/// machine, they are written in its byte order and are not portable across versions.
+/// \param[in] params_st points to the populated parameter struct
+/// \param[in] file_path is the path to the snapshot file to write
+/// \return true on success and false on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool rcl_yaml_node_struct_write_snapshot(
+  const rcl_params_t * params_st,
+  const char * file_path);
+
+/// \brief Load a parameter structure from a binary snapshot file
+/// The file is mapped in memory where supported, and names and values point into the mapping
+/// instead of being copied. The structure is backed by an arena as if initialized with
+/// rcl_yaml_node_struct_init_with_arena(), and rcl_yaml_node_struct_fini() unmaps the file.
+/// Modifying the structure never modifies the file.
+/// \param[in] file_path is the path to a file written by rcl_yaml_node_struct_write_snapshot()
+/// \param[in] allocator memory allocator for the blocks of the arena
+/// \return a pointer to param structure on success or NULL on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_params_t * rcl_yaml_node_struct_load_snapshot(
+  const char * file_path,
+  const rcutils_allocator_t allocator);
+
 /// \brief Parse a parameter value as a YAML string, updating params_st accordingly
 /// \param[in] node_name is the name of the node to which the parameter belongs
 /// \param[in] param_name is the name of the parameter whose value will be parsed
@@ -112,6 +220,9 @@ bool rcl_parse_yaml_value(
 
 /// \brief Get the variant value for a given parameter, zero initializing it in the
 /// process if not present already
+/// The parameters of the node are copied first if they are shared with a copy of the
+/// structure, as the value may be modified through the returned pointer.
+/// Use rcl_yaml_node_struct_find() to only read the value.
 /// \param[in] node_name is the name of the node to which the parameter belongs
 /// \param[in] param_name is the name of the parameter whose value is to be retrieved
 /// \param[inout] params_st points to the populated (or to be populated) parameter struct
@@ -122,6 +233,19 @@ rcl_variant_t * rcl_yaml_node_struct_get(
   const char * param_name,
   rcl_params_t * params_st);
 
+/// \brief Find the variant value for a given parameter
+/// Unlike rcl_yaml_node_struct_get(), neither \p params_st nor the parameters it shares with
+/// its copies are modified.
+/// \param[in] node_name is the name of the node to which the parameter belongs
+/// \param[in] param_name is the name of the parameter whose value is to be retrieved
+/// \param[in] params_st points to the populated parameter struct
+/// \return parameter variant value, or NULL if not present or on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+const rcl_variant_t * rcl_yaml_node_struct_find(
+  const char * node_name,
+  const char * param_name,
+  const rcl_params_t * params_st);
+
 /// \brief Print the parameter structure to stdout
 /// \param[in] params_st points to the populated parameter struct
 RCL_YAML_PARAM_PARSER_PUBLIC
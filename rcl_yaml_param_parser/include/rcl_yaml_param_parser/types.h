@@ -83,8 +83,33 @@ typedef struct rcl_variant_s
   rcutils_string_array_t * string_array_value;  ///< If array of strings
 } rcl_variant_t;
 
+/// Hash index of an array of names
+/*
+ * Maps names to their index in the array with open addressing, so that they
+ * are found without comparing them with every other name.
+ * It is maintained by the parser, arrays of names must not be modified directly.
+ * \typedef rcl_yaml_name_index_t
+ */
+typedef struct rcl_yaml_name_index_s
+{
+  size_t * slots;  ///< Index of a name plus one for every slot, 0 for empty slots
+  size_t capacity;  ///< Number of slots, 0 or a power of 2
+  size_t size;  ///< Number of names at the start of the array which are indexed
+} rcl_yaml_name_index_t;
+
+/// Reference count of the parameters of a node shared by copies of a parameter structure
+/*
+ * Opaque, see rcl_yaml_node_struct_copy().
+ * \typedef rcl_yaml_shared_count_t
+ */
+typedef struct rcl_yaml_shared_count_s rcl_yaml_shared_count_t;
+
 /// node_params_t stores all the parameters(key:value) of a single node
 /*
+* The arrays, names and values may be shared with copies of the parameter structure,
+* they must only be modified through the parser, which copies them first if needed.
+* Modifying them directly was supported before parameter structures shared their
+* parameters, it now modifies every copy as well.
 * \typedef rcl_node_params_t
 */
 typedef struct rcl_node_params_s
@@ -93,8 +118,17 @@ typedef struct rcl_node_params_s
   rcl_variant_t * parameter_values;  ///< Array of coressponding parameter values
   size_t num_params;  ///< Number of parameters in the node
   size_t capacity_params;  ///< Capacity of parameters in the node
+  rcl_yaml_name_index_t parameter_index;  ///< Hash index of parameter_names
+  rcl_yaml_shared_count_t * shared_count;  ///< Number of copies sharing the parameters, or NULL
 } rcl_node_params_t;
 
+/// Arena that the memory of a parameter structure can be carved from
+/*
+ * Opaque, see rcl_yaml_node_struct_init_with_arena().
+ * \typedef rcl_yaml_arena_t
+ */
+typedef struct rcl_yaml_arena_s rcl_yaml_arena_t;
+
 /// stores all the parameters of all nodes of a process
 /*
 * \typedef rcl_params_t
@@ -106,6 +140,43 @@ typedef struct rcl_params_s
   size_t num_nodes;       ///< Number of nodes
   size_t capacity_nodes;  ///< Capacity of nodes
   rcutils_allocator_t allocator;  ///< Allocator used
+  rcl_yaml_name_index_t node_index;  ///< Hash index of node_names
+  rcl_yaml_arena_t * arena;  ///< Arena providing the memory of the structure, NULL if none
 } rcl_params_t;
 
+/// Kind of change of a parameter between two versions of a parameter file
+/*
+* \typedef rcl_param_change_kind_t
+*/
+typedef enum rcl_param_change_kind_e
+{
+  RCL_PARAM_CHANGE_ADDED,  ///< The parameter was not set before
+  RCL_PARAM_CHANGE_REMOVED,  ///< The parameter is not set anymore
+  RCL_PARAM_CHANGE_CHANGED  ///< The parameter was set to another value
+} rcl_param_change_kind_t;
+
+/// param_change_t stores the change of a single parameter
+/*
+* \typedef rcl_param_change_t
+*/
+typedef struct rcl_param_change_s
+{
+  rcl_param_change_kind_t kind;  ///< Kind of change
+  char * node_name;  ///< Name of the node the parameter belongs to
+  char * parameter_name;  ///< Name of the parameter
+  rcl_variant_t value;  ///< New value of the parameter, empty if it was removed
+} rcl_param_change_t;
+
+/// params_diff_t stores the changes of the parameters of a parameter structure
+/*
+* \typedef rcl_params_diff_t
+*/
+typedef struct rcl_params_diff_s
+{
+  rcl_param_change_t * changes;  ///< Array of changes
+  size_t num_changes;  ///< Number of changes
+  size_t capacity_changes;  ///< Capacity of changes
+  rcutils_allocator_t allocator;  ///< Allocator used
+} rcl_params_diff_t;
+
 #endif  // RCL_YAML_PARAM_PARSER__TYPES_H_
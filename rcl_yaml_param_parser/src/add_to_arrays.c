@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <stdint.h>
+
 #include "rcutils/allocator.h"
 #include "rcutils/error_handling.h"
 #include "rcutils/types/rcutils_ret.h"
@@ -19,41 +21,64 @@
 
 #include "./impl/add_to_arrays.h"
 
-#define ADD_VALUE_TO_SIMPLE_ARRAY(val_array, value, value_type, allocator) \
+///
+/// Make room for one more element in an array of `size` elements
+/// The capacity of the array is implicitly the smallest power of two not below its size,
+/// so it is doubled whenever a full array grows and appending is amortized constant time.
+///
+static rcutils_ret_t grow_array(
+  void ** values,
+  const size_t size,
+  const size_t value_size,
+  const rcutils_allocator_t allocator)
+{
+  if (NULL != *values && 0U != (size & (size - 1U))) {
+    return RCUTILS_RET_OK;
+  }
+  const size_t capacity = NULL == *values ? 1U : size * 2U;
+  if (capacity > SIZE_MAX / value_size) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem\n");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  void * new_values = allocator.reallocate(*values, capacity * value_size, allocator.state);
+  if (NULL == new_values) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem\n");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  *values = new_values;
+  return RCUTILS_RET_OK;
+}
+
+#define ADD_VALUE_TO_SIMPLE_ARRAY(val_array, value, allocator) \
   do { \
     if (NULL == val_array->values) { \
-      val_array->values = value; \
-      val_array->size = 1; \
-    } else { \
-      /* Increase the array size by one and add the new value */ \
-      value_type * tmp_arr = val_array->values; \
-      val_array->values = allocator.zero_allocate( \
-        val_array->size + 1U, sizeof(value_type), allocator.state); \
-      if (NULL == val_array->values) { \
-        val_array->values = tmp_arr; \
-        RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem\n"); \
-        return RCUTILS_RET_BAD_ALLOC; \
-      } \
-      memcpy(val_array->values, tmp_arr, (val_array->size * sizeof(value_type))); \
-      val_array->values[val_array->size] = *value; \
-      val_array->size++; \
-      allocator.deallocate(value, allocator.state); \
-      allocator.deallocate(tmp_arr, allocator.state); \
+      val_array->size = 0U; \
+    } \
+    void * values = val_array->values; \
+    rcutils_ret_t ret = grow_array( \
+      &values, val_array->size, sizeof(*val_array->values), allocator); \
+    if (RCUTILS_RET_OK != ret) { \
+      return ret; \
     } \
+    val_array->values = values; \
+    val_array->values[val_array->size] = value; \
+    val_array->size++; \
     return RCUTILS_RET_OK; \
   } while (0)
 
+///
+/// Add a value to a bool array. Create the array if it does not exist
+///
 rcutils_ret_t add_val_to_bool_arr(
   rcl_bool_array_t * const val_array,
-  bool * value,
+  const bool value,
   const rcutils_allocator_t allocator)
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(val_array, RCUTILS_RET_INVALID_ARGUMENT);
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(value, RCUTILS_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
     &allocator, "invalid allocator", return RCUTILS_RET_INVALID_ARGUMENT);
 
-  ADD_VALUE_TO_SIMPLE_ARRAY(val_array, value, bool, allocator);
+  ADD_VALUE_TO_SIMPLE_ARRAY(val_array, value, allocator);
 }
 
 ///
@@ -61,15 +86,14 @@ rcutils_ret_t add_val_to_bool_arr(
 ///
 rcutils_ret_t add_val_to_int_arr(
   rcl_int64_array_t * const val_array,
-  int64_t * value,
+  const int64_t value,
   const rcutils_allocator_t allocator)
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(val_array, RCUTILS_RET_INVALID_ARGUMENT);
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(value, RCUTILS_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
     &allocator, "invalid allocator", return RCUTILS_RET_INVALID_ARGUMENT);
 
-  ADD_VALUE_TO_SIMPLE_ARRAY(val_array, value, int64_t, allocator);
+  ADD_VALUE_TO_SIMPLE_ARRAY(val_array, value, allocator);
 }
 
 ///
@@ -77,15 +101,14 @@ rcutils_ret_t add_val_to_int_arr(
 ///
 rcutils_ret_t add_val_to_double_arr(
   rcl_double_array_t * const val_array,
-  double * value,
+  const double value,
   const rcutils_allocator_t allocator)
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(val_array, RCUTILS_RET_INVALID_ARGUMENT);
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(value, RCUTILS_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
     &allocator, "invalid allocator", return RCUTILS_RET_INVALID_ARGUMENT);
 
-  ADD_VALUE_TO_SIMPLE_ARRAY(val_array, value, double, allocator);
+  ADD_VALUE_TO_SIMPLE_ARRAY(val_array, value, allocator);
 }
 
 ///
@@ -107,18 +130,15 @@ rcutils_ret_t add_val_to_string_arr(
       return ret;
     }
     val_array->data[0U] = value;
-  } else {
-    /// Increase the array size by one and add the new value
-    char ** new_string_arr_ptr = allocator.reallocate(
-      val_array->data,
-      ((val_array->size + 1U) * sizeof(char *)), allocator.state);
-    if (NULL == new_string_arr_ptr) {
-      RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem\n");
-      return RCUTILS_RET_BAD_ALLOC;
-    }
-    val_array->data = new_string_arr_ptr;
-    val_array->data[val_array->size] = value;
-    val_array->size++;
+    return RCUTILS_RET_OK;
+  }
+  void * data = val_array->data;
+  rcutils_ret_t ret = grow_array(&data, val_array->size, sizeof(char *), allocator);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
   }
+  val_array->data = data;
+  val_array->data[val_array->size] = value;
+  val_array->size++;
   return RCUTILS_RET_OK;
 }
@@ -0,0 +1,227 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+
+#include "./impl/arena.h"
+
+#define ARENA_BLOCK_SIZE 65536U
+/// Allocations larger than this get a block of their own
+#define MAX_SHARED_ALLOCATION_SIZE (ARENA_BLOCK_SIZE / 4U)
+#define ARENA_ALIGNMENT (_Alignof(max_align_t))
+#define ALIGN_UP(size) (((size) + ARENA_ALIGNMENT - 1U) & ~(ARENA_ALIGNMENT - 1U))
+/// Every allocation is preceded by its size, padded to keep the allocation aligned
+#define ALLOCATION_HEADER_SIZE ALIGN_UP(sizeof(size_t))
+
+typedef struct arena_block_s
+{
+  struct arena_block_s * next;
+  size_t size;  ///< Number of bytes after the block header
+  size_t used;  ///< Number of bytes carved from the start of the block
+} arena_block_t;
+
+#define BLOCK_HEADER_SIZE ALIGN_UP(sizeof(arena_block_t))
+
+struct rcl_yaml_arena_s
+{
+  rcutils_allocator_t allocator;  ///< Allocator of the blocks
+  arena_block_t * blocks;  ///< Blocks, the one allocations are carved from first
+  unsigned char * last;  ///< Last allocation carved from the first block, NULL if unknown
+  arena_fini_callback_t fini_callback;  ///< Called when the arena is finalized, if any
+  void * fini_data;  ///< Argument of the callback
+  size_t fini_size;  ///< Argument of the callback
+};
+
+static unsigned char * block_data(arena_block_t * block)
+{
+  return (unsigned char *)block + BLOCK_HEADER_SIZE;
+}
+
+static size_t allocation_size(const unsigned char * pointer)
+{
+  size_t size;
+  memcpy(&size, pointer - ALLOCATION_HEADER_SIZE, sizeof(size_t));
+  return size;
+}
+
+static arena_block_t * add_block(rcl_yaml_arena_t * arena, size_t size, bool dedicated)
+{
+  if (size > SIZE_MAX - BLOCK_HEADER_SIZE) {
+    return NULL;
+  }
+  arena_block_t * block = arena->allocator.allocate(
+    BLOCK_HEADER_SIZE + size, arena->allocator.state);
+  if (NULL == block) {
+    return NULL;
+  }
+  block->size = size;
+  block->used = 0U;
+  if (dedicated && NULL != arena->blocks) {
+    // Keep carving from the current block, which likely has room left
+    block->next = arena->blocks->next;
+    arena->blocks->next = block;
+  } else {
+    block->next = arena->blocks;
+    arena->blocks = block;
+    arena->last = NULL;
+  }
+  return block;
+}
+
+static void * arena_allocate(size_t size, void * state)
+{
+  rcl_yaml_arena_t * arena = state;
+  if (size > SIZE_MAX / 2U) {
+    return NULL;
+  }
+  const size_t total_size = ALLOCATION_HEADER_SIZE + ALIGN_UP(size);
+  arena_block_t * block = arena->blocks;
+  if (NULL == block || block->size - block->used < total_size) {
+    if (total_size > MAX_SHARED_ALLOCATION_SIZE) {
+      block = add_block(arena, total_size, true);
+    } else {
+      block = add_block(arena, ARENA_BLOCK_SIZE, false);
+    }
+    if (NULL == block) {
+      return NULL;
+    }
+  }
+  unsigned char * pointer = block_data(block) + block->used + ALLOCATION_HEADER_SIZE;
+  memcpy(pointer - ALLOCATION_HEADER_SIZE, &size, sizeof(size_t));
+  block->used += total_size;
+  if (block == arena->blocks) {
+    arena->last = pointer;
+  }
+  return pointer;
+}
+
+static void arena_deallocate(void * pointer, void * state)
+{
+  rcl_yaml_arena_t * arena = state;
+  if (NULL != pointer && pointer == arena->last) {
+    // Give back the memory of the last allocation, anything else waits for arena_fini()
+    arena_block_t * block = arena->blocks;
+    block->used = (size_t)(arena->last - ALLOCATION_HEADER_SIZE - block_data(block));
+    arena->last = NULL;
+  }
+}
+
+static void * arena_reallocate(void * pointer, size_t size, void * state)
+{
+  rcl_yaml_arena_t * arena = state;
+  if (NULL == pointer) {
+    return arena_allocate(size, state);
+  }
+  if (pointer == arena->last && size <= SIZE_MAX / 2U) {
+    // The last allocation grows or shrinks in place when the block has room for it
+    arena_block_t * block = arena->blocks;
+    const size_t offset = (size_t)(arena->last - block_data(block));
+    if (ALIGN_UP(size) <= block->size - offset) {
+      memcpy(arena->last - ALLOCATION_HEADER_SIZE, &size, sizeof(size_t));
+      block->used = offset + ALIGN_UP(size);
+      return pointer;
+    }
+  }
+  const size_t old_size = allocation_size(pointer);
+  if (size <= old_size) {
+    return pointer;
+  }
+  void * new_pointer = arena_allocate(size, state);
+  if (NULL == new_pointer) {
+    return NULL;
+  }
+  memcpy(new_pointer, pointer, old_size);
+  return new_pointer;
+}
+
+static void * arena_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  if (0U != size_of_element && number_of_elements > SIZE_MAX / size_of_element) {
+    return NULL;
+  }
+  const size_t size = number_of_elements * size_of_element;
+  void * pointer = arena_allocate(size, state);
+  if (NULL != pointer) {
+    memset(pointer, 0, size);
+  }
+  return pointer;
+}
+
+rcl_yaml_arena_t * arena_init(const rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return NULL);
+  rcl_yaml_arena_t * arena = allocator.allocate(sizeof(rcl_yaml_arena_t), allocator.state);
+  if (NULL == arena) {
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory for arena");
+    return NULL;
+  }
+  arena->allocator = allocator;
+  arena->blocks = NULL;
+  arena->last = NULL;
+  arena->fini_callback = NULL;
+  arena->fini_data = NULL;
+  arena->fini_size = 0U;
+  return arena;
+}
+
+rcutils_allocator_t arena_get_allocator(rcl_yaml_arena_t * arena)
+{
+  rcutils_allocator_t allocator = rcutils_get_zero_initialized_allocator();
+  allocator.allocate = arena_allocate;
+  allocator.deallocate = arena_deallocate;
+  allocator.reallocate = arena_reallocate;
+  allocator.zero_allocate = arena_zero_allocate;
+  allocator.state = arena;
+  return allocator;
+}
+
+rcutils_allocator_t arena_get_block_allocator(const rcl_yaml_arena_t * arena)
+{
+  return arena->allocator;
+}
+
+void arena_set_fini_callback(
+  rcl_yaml_arena_t * arena,
+  arena_fini_callback_t callback,
+  void * data,
+  size_t size)
+{
+  arena->fini_callback = callback;
+  arena->fini_data = data;
+  arena->fini_size = size;
+}
+
+void arena_fini(rcl_yaml_arena_t * arena)
+{
+  if (NULL == arena) {
+    return;
+  }
+  if (NULL != arena->fini_callback) {
+    arena->fini_callback(arena->fini_data, arena->fini_size);
+  }
+  rcutils_allocator_t allocator = arena->allocator;
+  arena_block_t * block = arena->blocks;
+  while (NULL != block) {
+    arena_block_t * next = block->next;
+    allocator.deallocate(block, allocator.state);
+    block = next;
+  }
+  allocator.deallocate(arena, allocator.state);
+}
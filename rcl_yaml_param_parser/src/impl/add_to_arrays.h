@@ -31,12 +31,14 @@ extern "C"
 
 ///
 /// Add a value to a bool array. Create the array if it does not exist
+/// Arrays grow geometrically, so they must have been created by these functions:
+/// their capacity is the smallest power of two not below their size.
 ///
 RCL_YAML_PARAM_PARSER_PUBLIC
 RCUTILS_WARN_UNUSED
 rcutils_ret_t add_val_to_bool_arr(
   rcl_bool_array_t * const val_array,
-  bool * value,
+  const bool value,
   const rcutils_allocator_t allocator);
 
 ///
@@ -46,7 +48,7 @@ RCL_YAML_PARAM_PARSER_PUBLIC
 RCUTILS_WARN_UNUSED
 rcutils_ret_t add_val_to_int_arr(
   rcl_int64_array_t * const val_array,
-  int64_t * value,
+  const int64_t value,
   const rcutils_allocator_t allocator);
 
 ///
@@ -56,7 +58,7 @@ RCL_YAML_PARAM_PARSER_PUBLIC
 RCUTILS_WARN_UNUSED
 rcutils_ret_t add_val_to_double_arr(
   rcl_double_array_t * const val_array,
-  double * value,
+  const double value,
   const rcutils_allocator_t allocator);
 
 ///
@@ -0,0 +1,76 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IMPL__ARENA_H_
+#define IMPL__ARENA_H_
+
+#include <stddef.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+
+#include "rcl_yaml_param_parser/types.h"
+#include "rcl_yaml_param_parser/visibility_control.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Function releasing a resource tied to an arena
+typedef void (* arena_fini_callback_t)(void * data, size_t size);
+
+///
+/// Create an arena carving memory from blocks obtained with an allocator
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+RCUTILS_WARN_UNUSED
+rcl_yaml_arena_t * arena_init(const rcutils_allocator_t allocator);
+
+///
+/// Get an allocator carving memory from an arena
+/// Deallocating only gives memory back for the last allocation, everything else is
+/// released by arena_fini(). The allocator is not thread safe.
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcutils_allocator_t arena_get_allocator(rcl_yaml_arena_t * arena);
+
+///
+/// Get the allocator the blocks of an arena are obtained with
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcutils_allocator_t arena_get_block_allocator(const rcl_yaml_arena_t * arena);
+
+///
+/// Set a function to call with `data` and `size` when an arena is finalized
+/// This ties the lifetime of another resource, like a mapped file, to the arena.
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+void arena_set_fini_callback(
+  rcl_yaml_arena_t * arena,
+  arena_fini_callback_t callback,
+  void * data,
+  size_t size);
+
+///
+/// Release all the memory carved from an arena, and the arena itself
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+void arena_fini(rcl_yaml_arena_t * arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // IMPL__ARENA_H_
@@ -0,0 +1,118 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IMPL__NAME_INDEX_H_
+#define IMPL__NAME_INDEX_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+#include "rcutils/types/rcutils_ret.h"
+
+#include "rcl_yaml_param_parser/types.h"
+#include "rcl_yaml_param_parser/visibility_control.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+///
+/// Return an empty name index
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_yaml_name_index_t name_index_get_zero_initialized(void);
+
+///
+/// Index the names appended to an array since the last call
+/// If names were removed from the array the index is rebuilt. `NULL` names are not indexed.
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t name_index_update(
+  rcl_yaml_name_index_t * index,
+  char * const * names,
+  size_t num_names,
+  const rcutils_allocator_t allocator);
+
+///
+/// Find the first index of a name in an array
+/// The index is updated first, the array is scanned instead if that fails.
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool name_index_find(
+  rcl_yaml_name_index_t * index,
+  char * const * names,
+  size_t num_names,
+  const char * name,
+  const rcutils_allocator_t allocator,
+  size_t * name_idx);
+
+///
+/// Find the first index of a name in an array without updating the index
+/// Names which are not indexed yet are scanned, so the index may be shared by several readers.
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool name_index_lookup(
+  const rcl_yaml_name_index_t * index,
+  char * const * names,
+  size_t num_names,
+  const char * name,
+  size_t * name_idx);
+
+///
+/// Replace a name of an array, taking ownership of the new one and freeing the old one
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+void name_index_replace(
+  rcl_yaml_name_index_t * index,
+  char ** names,
+  size_t num_names,
+  size_t name_idx,
+  char * name,
+  const rcutils_allocator_t allocator);
+
+///
+/// Remove the last name of an array from the index and free it
+/// The caller is left to decrement the number of names.
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+void name_index_remove_last(
+  rcl_yaml_name_index_t * index,
+  char ** names,
+  size_t num_names,
+  const rcutils_allocator_t allocator);
+
+///
+/// Forget the indexed names, so that the next update indexes the whole array
+/// To be called after names were removed from the middle of the array or moved.
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+void name_index_invalidate(rcl_yaml_name_index_t * index);
+
+///
+/// Free the slots of a name index
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+void name_index_fini(
+  rcl_yaml_name_index_t * index,
+  const rcutils_allocator_t allocator);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // IMPL__NAME_INDEX_H_
@@ -15,6 +15,8 @@
 #ifndef IMPL__NODE_PARAMS_H_
 #define IMPL__NODE_PARAMS_H_
 
+#include <stdbool.h>
+
 #include "rcutils/allocator.h"
 #include "rcutils/macros.h"
 #include "rcutils/types/rcutils_ret.h"
@@ -58,6 +60,36 @@ rcutils_ret_t node_params_reallocate(
   size_t new_capacity,
   const rcutils_allocator_t allocator);
 
+///
+/// Copy the parameters of a node into an uninitialized rcl_node_params_t structure
+/// On failure \p out_node_params is left to be finalized.
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t node_params_copy(
+  rcl_node_params_t * out_node_params,
+  const rcl_node_params_t * node_params,
+  const rcutils_allocator_t allocator);
+
+///
+/// Share the parameters of a node with an uninitialized rcl_node_params_t structure
+/// Both must then be modified only after node_params_make_unique().
+/// \return false if the parameters cannot be shared and must be copied instead
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool node_params_share(
+  rcl_node_params_t * out_node_params,
+  const rcl_node_params_t * node_params);
+
+///
+/// Copy the parameters of a node if they are shared, before modifying them
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t node_params_make_unique(
+  rcl_node_params_t * node_params,
+  const rcutils_allocator_t allocator);
+
 ///
 /// Finalize rcl_node_params_t structure
 ///
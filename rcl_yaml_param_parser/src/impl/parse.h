@@ -30,6 +30,16 @@ extern "C"
 {
 #endif
 
+RCL_YAML_PARAM_PARSER_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t get_scalar_value(
+  const char * const value,
+  yaml_scalar_style_t style,
+  const yaml_char_t * const tag,
+  data_types_t * val_type,
+  scalar_value_t * scalar,
+  const rcutils_allocator_t allocator);
+
 RCL_YAML_PARAM_PARSER_PUBLIC
 RCUTILS_WARN_UNUSED
 void * get_value(
@@ -67,6 +77,15 @@ rcutils_ret_t parse_file_events(
   namespace_tracker_t * ns_tracker,
   rcl_params_t * params_st);
 
+RCL_YAML_PARAM_PARSER_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t parse_file_events_for_nodes(
+  yaml_parser_t * parser,
+  namespace_tracker_t * ns_tracker,
+  const char * const * node_names,
+  const size_t num_node_names,
+  rcl_params_t * params_st);
+
 RCL_YAML_PARAM_PARSER_PUBLIC
 RCUTILS_WARN_UNUSED
 rcutils_ret_t parse_value_events(
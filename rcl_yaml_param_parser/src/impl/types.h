@@ -20,6 +20,7 @@
 #define IMPL__TYPES_H_
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -48,6 +49,15 @@ typedef enum data_types_e
   DATA_TYPE_STRING = 4U
 } data_types_t;
 
+/// A scalar value converted from its YAML representation, the member used depends on its type
+typedef union scalar_value_u
+{
+  bool bool_value;
+  int64_t integer_value;
+  double double_value;
+  char * string_value;
+} scalar_value_t;
+
 typedef enum namespace_type_e
 {
   NS_TYPE_NODE = 1U,
@@ -35,6 +35,19 @@ void rcl_yaml_variant_fini(
   rcl_variant_t * param_var,
   const rcutils_allocator_t allocator);
 
+///
+/// Check whether an rcl_yaml_variant_t holds no value
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool rcl_yaml_variant_is_empty(const rcl_variant_t * param_var);
+
+///
+/// Check whether two rcl_yaml_variant_t hold the same value
+/// Doubles are compared bit for bit, so that a NaN equals itself and 0.0 differs from -0.0.
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool rcl_yaml_variant_equal(const rcl_variant_t * lhs, const rcl_variant_t * rhs);
+
 ///
 /// Copy a yaml_variant_t from param_var to out_param_var
 ///
@@ -0,0 +1,267 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/types/rcutils_ret.h"
+
+#include "./impl/name_index.h"
+
+#define INIT_NUM_INDEX_SLOTS 64U
+
+static size_t hash_name(const char * name)
+{
+  // FNV-1a
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const unsigned char * c = (const unsigned char *)name; '\0' != *c; ++c) {
+    hash = (hash ^ *c) * 0x100000001b3ULL;
+  }
+  return (size_t)hash;
+}
+
+static void insert_name(
+  rcl_yaml_name_index_t * index,
+  char * const * names,
+  size_t name_idx)
+{
+  const size_t mask = index->capacity - 1U;
+  size_t slot = hash_name(names[name_idx]) & mask;
+  while (0U != index->slots[slot]) {
+    slot = (slot + 1U) & mask;
+  }
+  index->slots[slot] = name_idx + 1U;
+}
+
+static void remove_name(
+  rcl_yaml_name_index_t * index,
+  char * const * names,
+  size_t name_idx)
+{
+  const size_t mask = index->capacity - 1U;
+  size_t slot = hash_name(names[name_idx]) & mask;
+  while (index->slots[slot] != name_idx + 1U) {
+    if (0U == index->slots[slot]) {
+      return;
+    }
+    slot = (slot + 1U) & mask;
+  }
+  // Shift back the following names of the cluster which would not be found anymore
+  size_t next = slot;
+  while (true) {
+    next = (next + 1U) & mask;
+    if (0U == index->slots[next]) {
+      break;
+    }
+    size_t home = hash_name(names[index->slots[next] - 1U]) & mask;
+    // Distance from the home slot, modulo the capacity
+    if (((next - home) & mask) >= ((next - slot) & mask)) {
+      index->slots[slot] = index->slots[next];
+      slot = next;
+    }
+  }
+  index->slots[slot] = 0U;
+}
+
+static void clear_index(rcl_yaml_name_index_t * index)
+{
+  if (NULL != index->slots) {
+    memset(index->slots, 0, index->capacity * sizeof(size_t));
+  }
+  index->size = 0U;
+}
+
+rcl_yaml_name_index_t name_index_get_zero_initialized(void)
+{
+  rcl_yaml_name_index_t index = {NULL, 0U, 0U};
+  return index;
+}
+
+rcutils_ret_t name_index_update(
+  rcl_yaml_name_index_t * index,
+  char * const * names,
+  size_t num_names,
+  const rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(index, RCUTILS_RET_INVALID_ARGUMENT);
+
+  if (index->size > num_names) {
+    // Names were removed, start over
+    clear_index(index);
+  }
+  if (index->size == num_names) {
+    return RCUTILS_RET_OK;
+  }
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(names, RCUTILS_RET_INVALID_ARGUMENT);
+
+  // Keep at least half of the slots empty so that probe sequences stay short
+  if (num_names > index->capacity / 2U) {
+    size_t capacity = 0U == index->capacity ? INIT_NUM_INDEX_SLOTS : index->capacity;
+    while (num_names > capacity / 2U) {
+      capacity *= 2U;
+    }
+    size_t * slots = allocator.zero_allocate(capacity, sizeof(size_t), allocator.state);
+    if (NULL == slots) {
+      RCUTILS_SET_ERROR_MSG("Failed to allocate memory for name index");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+    if (NULL != index->slots) {
+      allocator.deallocate(index->slots, allocator.state);
+    }
+    index->slots = slots;
+    index->capacity = capacity;
+    index->size = 0U;
+  }
+
+  for (; index->size < num_names; ++index->size) {
+    if (NULL != names[index->size]) {
+      insert_name(index, names, index->size);
+    }
+  }
+  return RCUTILS_RET_OK;
+}
+
+bool name_index_find(
+  rcl_yaml_name_index_t * index,
+  char * const * names,
+  size_t num_names,
+  const char * name,
+  const rcutils_allocator_t allocator,
+  size_t * name_idx)
+{
+  if (RCUTILS_RET_OK != name_index_update(index, names, num_names, allocator)) {
+    rcutils_reset_error();
+    for (size_t i = 0U; i < num_names; ++i) {
+      if (NULL != names[i] && 0 == strcmp(names[i], name)) {
+        *name_idx = i;
+        return true;
+      }
+    }
+    return false;
+  }
+  if (0U == index->capacity) {
+    return false;
+  }
+
+  // Names may appear more than once, the first one is returned as a scan would
+  bool found = false;
+  const size_t mask = index->capacity - 1U;
+  for (size_t slot = hash_name(name) & mask; 0U != index->slots[slot]; slot = (slot + 1U) & mask) {
+    size_t i = index->slots[slot] - 1U;
+    if ((!found || i < *name_idx) && 0 == strcmp(names[i], name)) {
+      *name_idx = i;
+      found = true;
+    }
+  }
+  return found;
+}
+
+bool name_index_lookup(
+  const rcl_yaml_name_index_t * index,
+  char * const * names,
+  size_t num_names,
+  const char * name,
+  size_t * name_idx)
+{
+  // Names past the indexed ones, or all of them if names were removed since, are scanned
+  size_t num_indexed = index->size <= num_names ? index->size : 0U;
+  if (0U != num_indexed) {
+    bool found = false;
+    const size_t mask = index->capacity - 1U;
+    for (size_t slot = hash_name(name) & mask; 0U != index->slots[slot];
+      slot = (slot + 1U) & mask)
+    {
+      size_t i = index->slots[slot] - 1U;
+      if ((!found || i < *name_idx) && 0 == strcmp(names[i], name)) {
+        *name_idx = i;
+        found = true;
+      }
+    }
+    if (found) {
+      return true;
+    }
+  }
+  for (size_t i = num_indexed; i < num_names; ++i) {
+    if (NULL != names[i] && 0 == strcmp(names[i], name)) {
+      *name_idx = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+void name_index_replace(
+  rcl_yaml_name_index_t * index,
+  char ** names,
+  size_t num_names,
+  size_t name_idx,
+  char * name,
+  const rcutils_allocator_t allocator)
+{
+  if (index->size > num_names) {
+    // Names were removed, the next update rebuilds the index
+    clear_index(index);
+  }
+  const bool indexed = name_idx < index->size;
+  if (NULL != names[name_idx]) {
+    if (indexed) {
+      remove_name(index, names, name_idx);
+    }
+    allocator.deallocate(names[name_idx], allocator.state);
+  }
+  names[name_idx] = name;
+  if (indexed && NULL != name) {
+    // The slot of the old name was freed, so there is room for the new one
+    insert_name(index, names, name_idx);
+  }
+}
+
+void name_index_remove_last(
+  rcl_yaml_name_index_t * index,
+  char ** names,
+  size_t num_names,
+  const rcutils_allocator_t allocator)
+{
+  if (index->size > num_names) {
+    clear_index(index);
+  }
+  const size_t name_idx = num_names - 1U;
+  if (name_idx < index->size) {
+    if (NULL != names[name_idx]) {
+      remove_name(index, names, name_idx);
+    }
+    index->size = name_idx;
+  }
+  if (NULL != names[name_idx]) {
+    allocator.deallocate(names[name_idx], allocator.state);
+  }
+  names[name_idx] = NULL;
+}
+
+void name_index_invalidate(rcl_yaml_name_index_t * index)
+{
+  clear_index(index);
+}
+
+void name_index_fini(
+  rcl_yaml_name_index_t * index,
+  const rcutils_allocator_t allocator)
+{
+  if (NULL != index->slots) {
+    allocator.deallocate(index->slots, allocator.state);
+  }
+  *index = name_index_get_zero_initialized();
+}
@@ -16,14 +16,23 @@
 
 #include "rcutils/allocator.h"
 #include "rcutils/error_handling.h"
+#include "rcutils/stdatomic_helper.h"
+#include "rcutils/strdup.h"
 #include "rcutils/types/rcutils_ret.h"
 
+#include "./impl/name_index.h"
 #include "./impl/node_params.h"
 #include "./impl/types.h"
 #include "./impl/yaml_variant.h"
 
 #define INIT_NUM_PARAMS_PER_NODE 128U
 
+struct rcl_yaml_shared_count_s
+{
+  /// Number of rcl_node_params_t using the parameters
+  atomic_uint_least64_t count;
+};
+
 rcutils_ret_t node_params_init(
   rcl_node_params_t * node_params,
   const rcutils_allocator_t allocator)
@@ -60,8 +69,90 @@ rcutils_ret_t node_params_init_with_capacity(
     return RCUTILS_RET_BAD_ALLOC;
   }
 
+  node_params->shared_count = allocator.allocate(
+    sizeof(rcl_yaml_shared_count_t), allocator.state);
+  if (NULL == node_params->shared_count) {
+    allocator.deallocate(node_params->parameter_values, allocator.state);
+    node_params->parameter_values = NULL;
+    allocator.deallocate(node_params->parameter_names, allocator.state);
+    node_params->parameter_names = NULL;
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory for node parameter count");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  atomic_init(&node_params->shared_count->count, 1u);
+
   node_params->num_params = 0U;
   node_params->capacity_params = capacity;
+  node_params->parameter_index = name_index_get_zero_initialized();
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t node_params_copy(
+  rcl_node_params_t * out_node_params,
+  const rcl_node_params_t * node_params,
+  const rcutils_allocator_t allocator)
+{
+  rcutils_ret_t ret = node_params_init_with_capacity(
+    out_node_params, node_params->capacity_params, allocator);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  for (size_t parameter_idx = 0U; parameter_idx < node_params->num_params; ++parameter_idx) {
+    out_node_params->parameter_names[parameter_idx] =
+      rcutils_strdup(node_params->parameter_names[parameter_idx], allocator);
+    if (NULL == out_node_params->parameter_names[parameter_idx]) {
+      RCUTILS_SET_ERROR_MSG("Failed to allocate memory for node parameter name");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+    out_node_params->num_params++;
+
+    if (!rcl_yaml_variant_copy(
+        &out_node_params->parameter_values[parameter_idx],
+        &node_params->parameter_values[parameter_idx], allocator))
+    {
+      RCUTILS_SET_ERROR_MSG("Failed to copy node parameter value");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+  }
+  return name_index_update(
+    &out_node_params->parameter_index, out_node_params->parameter_names,
+    out_node_params->num_params, allocator);
+}
+
+bool node_params_share(
+  rcl_node_params_t * out_node_params,
+  const rcl_node_params_t * node_params)
+{
+  // The index of shared parameters must never be updated, it would be updated for all copies
+  if (NULL == node_params->shared_count ||
+    node_params->parameter_index.size != node_params->num_params)
+  {
+    return false;
+  }
+  rcutils_atomic_fetch_add_uint64_t(&node_params->shared_count->count, 1u);
+  *out_node_params = *node_params;
+  return true;
+}
+
+rcutils_ret_t node_params_make_unique(
+  rcl_node_params_t * node_params,
+  const rcutils_allocator_t allocator)
+{
+  if (NULL == node_params->shared_count ||
+    1u == rcutils_atomic_load_uint64_t(&node_params->shared_count->count))
+  {
+    return RCUTILS_RET_OK;
+  }
+  rcl_node_params_t unique_node_params;
+  memset(&unique_node_params, 0, sizeof(unique_node_params));
+  rcutils_ret_t ret = node_params_copy(&unique_node_params, node_params, allocator);
+  if (RCUTILS_RET_OK != ret) {
+    rcl_yaml_node_params_fini(&unique_node_params, allocator);
+    return ret;
+  }
+  // Only drops the shared reference, other copies keep the parameters alive
+  rcl_yaml_node_params_fini(node_params, allocator);
+  *node_params = unique_node_params;
   return RCUTILS_RET_OK;
 }
 
@@ -122,6 +213,17 @@ void rcl_yaml_node_params_fini(
     return;
   }
 
+  if (NULL != node_params_st->shared_count) {
+    rcl_yaml_shared_count_t * shared_count = node_params_st->shared_count;
+    if (1u != rcutils_atomic_fetch_add_uint64_t(&shared_count->count, (uint64_t)-1)) {
+      // Still used by a copy
+      memset(node_params_st, 0, sizeof(*node_params_st));
+      return;
+    }
+    allocator.deallocate(shared_count, allocator.state);
+    node_params_st->shared_count = NULL;
+  }
+
   if (NULL != node_params_st->parameter_names) {
     for (size_t parameter_idx = 0U; parameter_idx < node_params_st->num_params;
       parameter_idx++)
@@ -146,6 +248,8 @@ void rcl_yaml_node_params_fini(
     node_params_st->parameter_values = NULL;
   }
 
+  name_index_fini(&node_params_st->parameter_index, allocator);
+
   node_params_st->num_params = 0;
   node_params_st->capacity_params = 0;
 }
@@ -12,8 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <ctype.h>
 #include <errno.h>
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -31,9 +33,11 @@
 #include "rmw/validate_node_name.h"
 
 #include "./impl/add_to_arrays.h"
+#include "./impl/name_index.h"
 #include "./impl/parse.h"
 #include "./impl/namespace.h"
 #include "./impl/node_params.h"
+#include "./impl/yaml_variant.h"
 #include "rcl_yaml_param_parser/parser.h"
 #include "rcl_yaml_param_parser/visibility_control.h"
 
@@ -72,150 +76,370 @@ RCL_YAML_PARAM_PARSER_LOCAL
 rcutils_ret_t
 _validate_name(const char * name, rcutils_allocator_t allocator);
 
+/// Largest mantissa converted exactly to a double
+#define MAX_EXACT_DOUBLE_MANTISSA (UINT64_C(1) << 53)
+/// Largest power of ten that is exactly a double
+#define MAX_EXACT_POWER_OF_TEN 22
+/// Digits always fitting in an uint64_t
+#define MAX_FAST_MANTISSA_DIGITS 19
+/// Number of slots of the keyword table
+#define NUM_KEYWORD_SLOTS_BITS 6U
+/// Multiplier hashing every keyword to a different slot
+#define KEYWORD_HASH_MULTIPLIER UINT64_C(0xc64c590eccb4798d)
+/// Length of the longest keyword
+#define MAX_KEYWORD_LENGTH 5U
+
+typedef enum scalar_keyword_kind_e
+{
+  SCALAR_KEYWORD_TRUE,
+  SCALAR_KEYWORD_FALSE,
+  SCALAR_KEYWORD_NAN,
+  SCALAR_KEYWORD_INF,
+  SCALAR_KEYWORD_NEGATIVE_INF
+} scalar_keyword_kind_t;
+
+typedef struct scalar_keyword_s
+{
+  const char * keyword;
+  size_t length;
+  scalar_keyword_kind_t kind;
+} scalar_keyword_t;
+
 ///
-/// Determine the type of the value and return the converted value
-/// NOTE: Only canonical forms supported as of now
+/// Keywords of plain scalars, each in the slot given by hash_keyword()
 ///
-void * get_value(
-  const char * const value,
-  yaml_scalar_style_t style,
-  const yaml_char_t * const tag,
-  data_types_t * val_type,
-  const rcutils_allocator_t allocator)
-{
-  void * ret_val;
-  int64_t ival;
-  double dval;
-  char * endptr = NULL;
+static const scalar_keyword_t scalar_keywords[1U << NUM_KEYWORD_SLOTS_BITS] = {
+  [0] = {".inf", 4U, SCALAR_KEYWORD_INF},
+  [2] = {"off", 3U, SCALAR_KEYWORD_FALSE},
+  [3] = {".nan", 4U, SCALAR_KEYWORD_NAN},
+  [9] = {".NaN", 4U, SCALAR_KEYWORD_NAN},
+  [10] = {"Yes", 3U, SCALAR_KEYWORD_TRUE},
+  [11] = {"TRUE", 4U, SCALAR_KEYWORD_TRUE},
+  [13] = {"n", 1U, SCALAR_KEYWORD_FALSE},
+  [15] = {"No", 2U, SCALAR_KEYWORD_FALSE},
+  [16] = {"+.Inf", 5U, SCALAR_KEYWORD_INF},
+  [17] = {"false", 5U, SCALAR_KEYWORD_FALSE},
+  [18] = {"yes", 3U, SCALAR_KEYWORD_TRUE},
+  [19] = {"on", 2U, SCALAR_KEYWORD_TRUE},
+  [23] = {"FALSE", 5U, SCALAR_KEYWORD_FALSE},
+  [24] = {"+.inf", 5U, SCALAR_KEYWORD_INF},
+  [26] = {"N", 1U, SCALAR_KEYWORD_FALSE},
+  [29] = {"NO", 2U, SCALAR_KEYWORD_FALSE},
+  [31] = {"true", 4U, SCALAR_KEYWORD_TRUE},
+  [33] = {"-.INF", 5U, SCALAR_KEYWORD_NEGATIVE_INF},
+  [34] = {".INF", 4U, SCALAR_KEYWORD_INF},
+  [37] = {"OFF", 3U, SCALAR_KEYWORD_FALSE},
+  [38] = {".NAN", 4U, SCALAR_KEYWORD_NAN},
+  [41] = {"True", 4U, SCALAR_KEYWORD_TRUE},
+  [43] = {"False", 5U, SCALAR_KEYWORD_FALSE},
+  [46] = {"y", 1U, SCALAR_KEYWORD_TRUE},
+  [49] = {"On", 2U, SCALAR_KEYWORD_TRUE},
+  [50] = {"no", 2U, SCALAR_KEYWORD_FALSE},
+  [53] = {"YES", 3U, SCALAR_KEYWORD_TRUE},
+  [54] = {"-.Inf", 5U, SCALAR_KEYWORD_NEGATIVE_INF},
+  [55] = {".Inf", 4U, SCALAR_KEYWORD_INF},
+  [58] = {"Off", 3U, SCALAR_KEYWORD_FALSE},
+  [59] = {"+.INF", 5U, SCALAR_KEYWORD_INF},
+  [60] = {"Y", 1U, SCALAR_KEYWORD_TRUE},
+  [62] = {"ON", 2U, SCALAR_KEYWORD_TRUE},
+  [63] = {"-.inf", 5U, SCALAR_KEYWORD_NEGATIVE_INF},
+};
 
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(value, NULL);
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(val_type, NULL);
-  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
-    &allocator, "allocator is invalid", return NULL);
+///
+/// Find the keyword a plain scalar spells, if any
+/// The bytes of the scalar are packed in a key, whose hash is a slot of the table that
+/// only holds that keyword, so a single comparison is needed.
+///
+static const scalar_keyword_t * find_scalar_keyword(const char * value)
+{
+  uint64_t key = 0U;
+  size_t length = 0U;
+  while ('\0' != value[length]) {
+    if (MAX_KEYWORD_LENGTH == length) {
+      return NULL;
+    }
+    key = (key << 8U) | (unsigned char)value[length];
+    ++length;
+  }
+  const scalar_keyword_t * keyword =
+    &scalar_keywords[(key * KEYWORD_HASH_MULTIPLIER) >> (64U - NUM_KEYWORD_SLOTS_BITS)];
+  if (keyword->length != length || 0 != memcmp(keyword->keyword, value, length)) {
+    return NULL;
+  }
+  return keyword;
+}
 
-  /// Check for yaml string tag
-  if (tag != NULL && strcmp(YAML_STR_TAG, (char *)tag) == 0) {
-    *val_type = DATA_TYPE_STRING;
-    return rcutils_strdup(value, allocator);
+///
+/// Convert a plain scalar in the common decimal forms of integers and floats
+/// Integers are decimal without leading zeros and floats have at most 19 significant digits
+/// and a small exponent, so that the conversion is exact or correctly rounded, independently
+/// of the locale. Other forms are left to strtoll() and strtod().
+///
+static bool parse_decimal_number(
+  const char * value,
+  data_types_t * val_type,
+  scalar_value_t * scalar)
+{
+  static const double powers_of_ten[MAX_EXACT_POWER_OF_TEN + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  const char * iter = value;
+  const bool negative = ('-' == *iter);
+  if ('-' == *iter || '+' == *iter) {
+    ++iter;
   }
 
-  /// Check if it is bool
-  if (style != YAML_SINGLE_QUOTED_SCALAR_STYLE &&
-    style != YAML_DOUBLE_QUOTED_SCALAR_STYLE)
-  {
-    if ((0 == strcmp(value, "Y")) ||
-      (0 == strcmp(value, "y")) ||
-      (0 == strcmp(value, "yes")) ||
-      (0 == strcmp(value, "Yes")) ||
-      (0 == strcmp(value, "YES")) ||
-      (0 == strcmp(value, "true")) ||
-      (0 == strcmp(value, "True")) ||
-      (0 == strcmp(value, "TRUE")) ||
-      (0 == strcmp(value, "on")) ||
-      (0 == strcmp(value, "On")) ||
-      (0 == strcmp(value, "ON")))
+  uint64_t mantissa = 0U;
+  int num_mantissa_digits = 0;
+  int exponent = 0;
+  const char * int_digits = iter;
+  for (; *iter >= '0' && *iter <= '9'; ++iter) {
+    if ((0U != mantissa || '0' != *iter) &&
+      ++num_mantissa_digits > MAX_FAST_MANTISSA_DIGITS)
     {
-      *val_type = DATA_TYPE_BOOL;
-      ret_val = allocator.zero_allocate(1U, sizeof(bool), allocator.state);
-      if (NULL == ret_val) {
-        return NULL;
-      }
-      *((bool *)ret_val) = true;
-      return ret_val;
+      return false;
     }
+    mantissa = mantissa * 10U + (uint64_t)(*iter - '0');
+  }
+  const size_t num_int_digits = (size_t)(iter - int_digits);
 
-    if ((0 == strcmp(value, "N")) ||
-      (0 == strcmp(value, "n")) ||
-      (0 == strcmp(value, "no")) ||
-      (0 == strcmp(value, "No")) ||
-      (0 == strcmp(value, "NO")) ||
-      (0 == strcmp(value, "false")) ||
-      (0 == strcmp(value, "False")) ||
-      (0 == strcmp(value, "FALSE")) ||
-      (0 == strcmp(value, "off")) ||
-      (0 == strcmp(value, "Off")) ||
-      (0 == strcmp(value, "OFF")))
-    {
-      *val_type = DATA_TYPE_BOOL;
-      ret_val = allocator.zero_allocate(1U, sizeof(bool), allocator.state);
-      if (NULL == ret_val) {
-        return NULL;
+  if ('\0' == *iter) {
+    // Leading zeros make octal integers
+    if (0U == num_int_digits || (num_int_digits > 1U && '0' == *int_digits)) {
+      return false;
+    }
+    if (negative) {
+      if (mantissa > (uint64_t)INT64_MAX + 1U) {
+        return false;
+      }
+      scalar->integer_value =
+        (mantissa == (uint64_t)INT64_MAX + 1U) ? INT64_MIN : -(int64_t)mantissa;
+    } else {
+      if (mantissa > (uint64_t)INT64_MAX) {
+        return false;
       }
-      *((bool *)ret_val) = false;
-      return ret_val;
+      scalar->integer_value = (int64_t)mantissa;
     }
+    *val_type = DATA_TYPE_INT64;
+    return true;
   }
 
-  /// Check for int
-  if (style != YAML_SINGLE_QUOTED_SCALAR_STYLE &&
-    style != YAML_DOUBLE_QUOTED_SCALAR_STYLE)
-  {
-    errno = 0;
-    ival = strtol(value, &endptr, 0);
-    if ((0 == errno) && (NULL != endptr)) {
-      if ((NULL != endptr) && (endptr != value)) {
-        if (('\0' != *value) && ('\0' == *endptr)) {
-          *val_type = DATA_TYPE_INT64;
-          ret_val = allocator.zero_allocate(1U, sizeof(int64_t), allocator.state);
-          if (NULL == ret_val) {
-            return NULL;
-          }
-          *((int64_t *)ret_val) = ival;
-          return ret_val;
-        }
+  size_t num_frac_digits = 0U;
+  if ('.' == *iter) {
+    for (++iter; *iter >= '0' && *iter <= '9'; ++iter, ++num_frac_digits) {
+      if ((0U != mantissa || '0' != *iter) &&
+        ++num_mantissa_digits > MAX_FAST_MANTISSA_DIGITS)
+      {
+        return false;
       }
+      mantissa = mantissa * 10U + (uint64_t)(*iter - '0');
+      --exponent;
     }
   }
+  if (0U == num_int_digits + num_frac_digits) {
+    return false;
+  }
+  if ('e' == *iter || 'E' == *iter) {
+    ++iter;
+    const bool negative_exponent = ('-' == *iter);
+    if ('-' == *iter || '+' == *iter) {
+      ++iter;
+    }
+    if (*iter < '0' || *iter > '9') {
+      return false;
+    }
+    int explicit_exponent = 0;
+    for (; *iter >= '0' && *iter <= '9'; ++iter) {
+      if (explicit_exponent > 2 * MAX_EXACT_POWER_OF_TEN) {
+        return false;
+      }
+      explicit_exponent = explicit_exponent * 10 + (*iter - '0');
+    }
+    exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+  }
+  if ('\0' != *iter) {
+    return false;
+  }
 
-  /// Check for float
-  if (style != YAML_SINGLE_QUOTED_SCALAR_STYLE &&
-    style != YAML_DOUBLE_QUOTED_SCALAR_STYLE)
-  {
-    errno = 0;
-    endptr = NULL;
-    const char * iter_ptr = NULL;
-    if ((0 == strcmp(value, ".nan")) ||
-      (0 == strcmp(value, ".NaN")) ||
-      (0 == strcmp(value, ".NAN")) ||
-      (0 == strcmp(value, ".inf")) ||
-      (0 == strcmp(value, ".Inf")) ||
-      (0 == strcmp(value, ".INF")) ||
-      (0 == strcmp(value, "+.inf")) ||
-      (0 == strcmp(value, "+.Inf")) ||
-      (0 == strcmp(value, "+.INF")) ||
-      (0 == strcmp(value, "-.inf")) ||
-      (0 == strcmp(value, "-.Inf")) ||
-      (0 == strcmp(value, "-.INF")))
+  double dval = 0.0;
+  if (0U != mantissa) {
+#if FLT_EVAL_METHOD != 0
+    // Intermediate results in extended precision would round twice
+    return false;
+#endif
+    if (mantissa > MAX_EXACT_DOUBLE_MANTISSA ||
+      exponent < -MAX_EXACT_POWER_OF_TEN || exponent > MAX_EXACT_POWER_OF_TEN)
     {
-      for (iter_ptr = value; !isalpha(*iter_ptr); ) {
-        iter_ptr += 1;
-      }
-      dval = strtod(iter_ptr, &endptr);
-      if (*value == '-') {
-        dval = -dval;
-      }
+      return false;
+    }
+    // Both operands are exact, so the single rounding of the operation is correct
+    dval = (double)mantissa;
+    if (exponent < 0) {
+      dval /= powers_of_ten[-exponent];
     } else {
-      dval = strtod(value, &endptr);
+      dval *= powers_of_ten[exponent];
     }
-    if ((0 == errno) && (NULL != endptr)) {
-      if ((NULL != endptr) && (endptr != value)) {
-        if (('\0' != *value) && ('\0' == *endptr)) {
-          *val_type = DATA_TYPE_DOUBLE;
-          ret_val = allocator.zero_allocate(1U, sizeof(double), allocator.state);
-          if (NULL == ret_val) {
-            return NULL;
-          }
-          *((double *)ret_val) = dval;
-          return ret_val;
-        }
-      }
+  }
+  *val_type = DATA_TYPE_DOUBLE;
+  scalar->double_value = negative ? -dval : dval;
+  return true;
+}
+
+///
+/// Convert a plain scalar with strtoll() and strtod(), as a number that is not in the
+/// common forms, e.g. hexadecimal, or a string that they might take for one
+///
+static bool parse_other_number(
+  const char * value,
+  data_types_t * val_type,
+  scalar_value_t * scalar)
+{
+  char * endptr = NULL;
+
+  /// Check for int
+  errno = 0;
+  long long ival = strtoll(value, &endptr, 0);
+  if ((0 == errno) && (endptr != value) && ('\0' == *endptr)) {
+    *val_type = DATA_TYPE_INT64;
+    scalar->integer_value = (int64_t)ival;
+    return true;
+  }
+
+  /// Check for float
+  errno = 0;
+  double dval = strtod(value, &endptr);
+  if ((0 == errno) && (endptr != value) && ('\0' == *endptr)) {
+    *val_type = DATA_TYPE_DOUBLE;
+    scalar->double_value = dval;
+    return true;
+  }
+  errno = 0;
+  return false;
+}
+
+///
+/// Determine the type of a plain scalar and convert it, unless it is a string
+///
+static bool classify_plain_scalar(
+  const char * value,
+  data_types_t * val_type,
+  scalar_value_t * scalar)
+{
+  const scalar_keyword_t * keyword = find_scalar_keyword(value);
+  if (NULL != keyword) {
+    switch (keyword->kind) {
+      case SCALAR_KEYWORD_TRUE:
+      case SCALAR_KEYWORD_FALSE:
+        *val_type = DATA_TYPE_BOOL;
+        scalar->bool_value = (SCALAR_KEYWORD_TRUE == keyword->kind);
+        break;
+      case SCALAR_KEYWORD_NAN:
+        *val_type = DATA_TYPE_DOUBLE;
+        scalar->double_value = NAN;
+        break;
+      case SCALAR_KEYWORD_INF:
+      case SCALAR_KEYWORD_NEGATIVE_INF:
+        *val_type = DATA_TYPE_DOUBLE;
+        scalar->double_value =
+          (SCALAR_KEYWORD_INF == keyword->kind) ? (double)INFINITY : -(double)INFINITY;
+        break;
     }
-    errno = 0;
+    return true;
+  }
+
+  switch (*value) {
+    case '0': case '1': case '2': case '3': case '4':
+    case '5': case '6': case '7': case '8': case '9':
+    case '+': case '-': case '.':
+      return parse_decimal_number(value, val_type, scalar) ||
+             parse_other_number(value, val_type, scalar);
+    // strtod() also reads "inf", "infinity" and "nan" regardless of case,
+    // and both skip leading white space
+    case 'i': case 'I': case 'n': case 'N':
+    case ' ': case '\t': case '\n': case '\v': case '\f': case '\r':
+      return parse_other_number(value, val_type, scalar);
+    default:
+      return false;
+  }
+}
+
+///
+/// Determine the type of the value and convert it in place, only strings are allocated
+/// NOTE: Only canonical forms supported as of now
+///
+rcutils_ret_t get_scalar_value(
+  const char * const value,
+  yaml_scalar_style_t style,
+  const yaml_char_t * const tag,
+  data_types_t * val_type,
+  scalar_value_t * scalar,
+  const rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(value, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(val_type, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(scalar, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "allocator is invalid", return RCUTILS_RET_INVALID_ARGUMENT);
+
+  /// Check for bool, int and float unless it is quoted or tagged as a string
+  const bool is_string_tag = (tag != NULL && strcmp(YAML_STR_TAG, (char *)tag) == 0);
+  if (!is_string_tag &&
+    style != YAML_SINGLE_QUOTED_SCALAR_STYLE &&
+    style != YAML_DOUBLE_QUOTED_SCALAR_STYLE &&
+    classify_plain_scalar(value, val_type, scalar))
+  {
+    return RCUTILS_RET_OK;
   }
 
   /// It is a string
   *val_type = DATA_TYPE_STRING;
-  ret_val = rcutils_strdup(value, allocator);
+  scalar->string_value = rcutils_strdup(value, allocator);
+  return NULL == scalar->string_value ? RCUTILS_RET_BAD_ALLOC : RCUTILS_RET_OK;
+}
+
+///
+/// Determine the type of the value and return the converted value
+/// NOTE: Only canonical forms supported as of now
+///
+void * get_value(
+  const char * const value,
+  yaml_scalar_style_t style,
+  const yaml_char_t * const tag,
+  data_types_t * val_type,
+  const rcutils_allocator_t allocator)
+{
+  scalar_value_t scalar;
+  if (RCUTILS_RET_OK != get_scalar_value(value, style, tag, val_type, &scalar, allocator)) {
+    return NULL;
+  }
+
+  void * ret_val = NULL;
+  switch (*val_type) {
+    case DATA_TYPE_BOOL:
+      ret_val = allocator.zero_allocate(1U, sizeof(bool), allocator.state);
+      if (NULL != ret_val) {
+        *((bool *)ret_val) = scalar.bool_value;
+      }
+      break;
+    case DATA_TYPE_INT64:
+      ret_val = allocator.zero_allocate(1U, sizeof(int64_t), allocator.state);
+      if (NULL != ret_val) {
+        *((int64_t *)ret_val) = scalar.integer_value;
+      }
+      break;
+    case DATA_TYPE_DOUBLE:
+      ret_val = allocator.zero_allocate(1U, sizeof(double), allocator.state);
+      if (NULL != ret_val) {
+        *((double *)ret_val) = scalar.double_value;
+      }
+      break;
+    case DATA_TYPE_STRING:
+      ret_val = scalar.string_value;
+      break;
+    default:
+      break;
+  }
   return ret_val;
 }
 
@@ -267,11 +491,25 @@ rcutils_ret_t parse_value(
   rcl_variant_t * param_value = &(params_st->params[node_idx].parameter_values[parameter_idx]);
 
   data_types_t val_type;
-  void * ret_val = get_value(value, style, tag, &val_type, allocator);
-  if (NULL == ret_val) {
-    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
-      "Error parsing value %s at line %d", value, line_num);
-    return RCUTILS_RET_ERROR;
+  void * ret_val = NULL;
+  scalar_value_t scalar;
+  if (is_seq) {
+    /// Sequence elements are copied into their array, so they are converted in place
+    if (RCUTILS_RET_OK != get_scalar_value(value, style, tag, &val_type, &scalar, allocator)) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Error parsing value %s at line %d", value, line_num);
+      return RCUTILS_RET_ERROR;
+    }
+    if (DATA_TYPE_STRING == val_type) {
+      ret_val = scalar.string_value;
+    }
+  } else {
+    ret_val = get_value(value, style, tag, &val_type, allocator);
+    if (NULL == ret_val) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Error parsing value %s at line %d", value, line_num);
+      return RCUTILS_RET_ERROR;
+    }
   }
 
   rcutils_ret_t ret = RCUTILS_RET_OK;
@@ -283,23 +521,16 @@ rcutils_ret_t parse_value(
       break;
     case DATA_TYPE_BOOL:
       if (!is_seq) {
-        if (NULL != param_value->bool_value) {
-          // Overwriting, deallocate original
-          allocator.deallocate(param_value->bool_value, allocator.state);
-        }
+        // Overwriting, deallocate the original value whatever its type
+        rcl_yaml_variant_fini(param_value, allocator);
         param_value->bool_value = (bool *)ret_val;
       } else {
         if (DATA_TYPE_UNKNOWN == *seq_data_type) {
           *seq_data_type = val_type;
-          if (NULL != param_value->bool_array_value) {
-            allocator.deallocate(param_value->bool_array_value->values, allocator.state);
-            allocator.deallocate(param_value->bool_array_value, allocator.state);
-            param_value->bool_array_value = NULL;
-          }
+          rcl_yaml_variant_fini(param_value, allocator);
           param_value->bool_array_value =
             allocator.zero_allocate(1U, sizeof(rcl_bool_array_t), allocator.state);
           if (NULL == param_value->bool_array_value) {
-            allocator.deallocate(ret_val, allocator.state);
             RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem\n");
             ret = RCUTILS_RET_BAD_ALLOC;
             break;
@@ -309,38 +540,25 @@ rcutils_ret_t parse_value(
             RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
               "Sequence should be of same type. Value type 'bool' do not belong at line_num %d",
               line_num);
-            allocator.deallocate(ret_val, allocator.state);
             ret = RCUTILS_RET_ERROR;
             break;
           }
         }
-        ret = add_val_to_bool_arr(param_value->bool_array_value, ret_val, allocator);
-        if (RCUTILS_RET_OK != ret) {
-          if (NULL != ret_val) {
-            allocator.deallocate(ret_val, allocator.state);
-          }
-        }
+        ret = add_val_to_bool_arr(param_value->bool_array_value, scalar.bool_value, allocator);
       }
       break;
     case DATA_TYPE_INT64:
       if (!is_seq) {
-        if (NULL != param_value->integer_value) {
-          // Overwriting, deallocate original
-          allocator.deallocate(param_value->integer_value, allocator.state);
-        }
+        // Overwriting, deallocate the original value whatever its type
+        rcl_yaml_variant_fini(param_value, allocator);
         param_value->integer_value = (int64_t *)ret_val;
       } else {
         if (DATA_TYPE_UNKNOWN == *seq_data_type) {
-          if (NULL != param_value->integer_array_value) {
-            allocator.deallocate(param_value->integer_array_value->values, allocator.state);
-            allocator.deallocate(param_value->integer_array_value, allocator.state);
-            param_value->integer_array_value = NULL;
-          }
+          rcl_yaml_variant_fini(param_value, allocator);
           *seq_data_type = val_type;
           param_value->integer_array_value =
             allocator.zero_allocate(1U, sizeof(rcl_int64_array_t), allocator.state);
           if (NULL == param_value->integer_array_value) {
-            allocator.deallocate(ret_val, allocator.state);
             RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem\n");
             ret = RCUTILS_RET_BAD_ALLOC;
             break;
@@ -350,38 +568,25 @@ rcutils_ret_t parse_value(
             RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
               "Sequence should be of same type. Value type 'integer' do not belong at line_num %d",
               line_num);
-            allocator.deallocate(ret_val, allocator.state);
             ret = RCUTILS_RET_ERROR;
             break;
           }
         }
-        ret = add_val_to_int_arr(param_value->integer_array_value, ret_val, allocator);
-        if (RCUTILS_RET_OK != ret) {
-          if (NULL != ret_val) {
-            allocator.deallocate(ret_val, allocator.state);
-          }
-        }
+        ret = add_val_to_int_arr(param_value->integer_array_value, scalar.integer_value, allocator);
       }
       break;
     case DATA_TYPE_DOUBLE:
       if (!is_seq) {
-        if (NULL != param_value->double_value) {
-          // Overwriting, deallocate original
-          allocator.deallocate(param_value->double_value, allocator.state);
-        }
+        // Overwriting, deallocate the original value whatever its type
+        rcl_yaml_variant_fini(param_value, allocator);
         param_value->double_value = (double *)ret_val;
       } else {
         if (DATA_TYPE_UNKNOWN == *seq_data_type) {
-          if (NULL != param_value->double_array_value) {
-            allocator.deallocate(param_value->double_array_value->values, allocator.state);
-            allocator.deallocate(param_value->double_array_value, allocator.state);
-            param_value->double_array_value = NULL;
-          }
+          rcl_yaml_variant_fini(param_value, allocator);
           *seq_data_type = val_type;
           param_value->double_array_value =
             allocator.zero_allocate(1U, sizeof(rcl_double_array_t), allocator.state);
           if (NULL == param_value->double_array_value) {
-            allocator.deallocate(ret_val, allocator.state);
             RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem\n");
             ret = RCUTILS_RET_BAD_ALLOC;
             break;
@@ -391,36 +596,22 @@ rcutils_ret_t parse_value(
             RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
               "Sequence should be of same type. Value type 'double' do not belong at line_num %d",
               line_num);
-            allocator.deallocate(ret_val, allocator.state);
             ret = RCUTILS_RET_ERROR;
             break;
           }
         }
-        ret = add_val_to_double_arr(param_value->double_array_value, ret_val, allocator);
-        if (RCUTILS_RET_OK != ret) {
-          if (NULL != ret_val) {
-            allocator.deallocate(ret_val, allocator.state);
-          }
-        }
+        ret = add_val_to_double_arr(
+          param_value->double_array_value, scalar.double_value, allocator);
       }
       break;
     case DATA_TYPE_STRING:
       if (!is_seq) {
-        if (NULL != param_value->string_value) {
-          // Overwriting, deallocate original
-          allocator.deallocate(param_value->string_value, allocator.state);
-        }
+        // Overwriting, deallocate the original value whatever its type
+        rcl_yaml_variant_fini(param_value, allocator);
         param_value->string_value = (char *)ret_val;
       } else {
         if (DATA_TYPE_UNKNOWN == *seq_data_type) {
-          if (NULL != param_value->string_array_value) {
-            if (RCUTILS_RET_OK != rcutils_string_array_fini(param_value->string_array_value)) {
-              // Log and continue ...
-              RCUTILS_SAFE_FWRITE_TO_STDERR("Error deallocating string array");
-            }
-            allocator.deallocate(param_value->string_array_value, allocator.state);
-            param_value->string_array_value = NULL;
-          }
+          rcl_yaml_variant_fini(param_value, allocator);
           *seq_data_type = val_type;
           param_value->string_array_value =
             allocator.zero_allocate(1U, sizeof(rcutils_string_array_t), allocator.state);
@@ -590,6 +781,32 @@ clean:
   return ret;
 }
 
+///
+/// Remove the last parameter of a node if it is the valueless parameter named after a
+/// parameter namespace, which keys of that namespace are renamed from
+///
+static void remove_param_ns_placeholder(
+  rcl_node_params_t * node_params_st,
+  const char * parameter_ns,
+  const rcutils_allocator_t allocator)
+{
+  if (0U == node_params_st->num_params) {
+    return;
+  }
+  const size_t last_idx = node_params_st->num_params - 1U;
+  const char * last_name = node_params_st->parameter_names[last_idx];
+  const rcl_variant_t * last_value = &node_params_st->parameter_values[last_idx];
+  if (NULL == last_name || 0 != strcmp(last_name, parameter_ns) ||
+    !rcl_yaml_variant_is_empty(last_value))
+  {
+    return;
+  }
+  name_index_remove_last(
+    &node_params_st->parameter_index, node_params_st->parameter_names,
+    node_params_st->num_params, allocator);
+  node_params_st->num_params--;
+}
+
 ///
 /// Parse the key part of the <key:value> pair
 ///
@@ -709,11 +926,6 @@ rcutils_ret_t parse_key(
             break;
           }
         } else {
-          ret = find_parameter(*node_idx, parameter_ns, params_st, parameter_idx);
-          if (ret != RCUTILS_RET_OK) {
-            break;
-          }
-
           const size_t params_ns_len = strlen(parameter_ns);
           const size_t param_name_len = strlen(value);
           const size_t tot_len = (params_ns_len + param_name_len + 2U);
@@ -729,12 +941,32 @@ rcutils_ret_t parse_key(
           memcpy((param_name + params_ns_len + 1U), value, param_name_len);
           param_name[tot_len - 1U] = '\0';
 
-          if (NULL != params_st->params[*node_idx].parameter_names[*parameter_idx]) {
-            // This memory was allocated in find_parameter(), and its pointer is being overwritten
-            allocator.deallocate(
-              params_st->params[*node_idx].parameter_names[*parameter_idx], allocator.state);
+          rcl_node_params_t * node_params_st = &(params_st->params[*node_idx]);
+          ret = node_params_make_unique(node_params_st, allocator);
+          if (RCUTILS_RET_OK != ret) {
+            allocator.deallocate(param_name, allocator.state);
+            break;
+          }
+          if (name_index_find(
+              &node_params_st->parameter_index, node_params_st->parameter_names,
+              node_params_st->num_params, param_name, allocator, parameter_idx))
+          {
+            // Overriding a parameter of an earlier file, drop the namespace added for it
+            remove_param_ns_placeholder(node_params_st, parameter_ns, allocator);
+            allocator.deallocate(param_name, allocator.state);
+            break;
+          }
+
+          ret = find_parameter(*node_idx, parameter_ns, params_st, parameter_idx);
+          if (ret != RCUTILS_RET_OK) {
+            allocator.deallocate(param_name, allocator.state);
+            break;
           }
-          params_st->params[*node_idx].parameter_names[*parameter_idx] = param_name;
+
+          // The name allocated in find_parameter() is freed and replaced
+          name_index_replace(
+            &node_params_st->parameter_index, node_params_st->parameter_names,
+            node_params_st->num_params, *parameter_idx, param_name, allocator);
         }
       }
       break;
@@ -746,6 +978,107 @@ rcutils_ret_t parse_key(
   return ret;
 }
 
+///
+/// Get the length of the token at the start of a node name, up to the next separator
+///
+static size_t node_token_length(const char * name)
+{
+  const char * separator = strchr(name, '/');
+  return NULL != separator ? (size_t)(separator - name) : strlen(name);
+}
+
+///
+/// Skip a token of a node name and the separator after it
+///
+static const char * skip_node_token(const char * name, const size_t length)
+{
+  return '/' == name[length] ? name + length + 1U : name + length;
+}
+
+///
+/// Match the tokens of a node name against those of a node name pattern of a parameter file
+/// As when parameters are applied to a node, "*" matches exactly one token and "**"
+/// matches zero or more tokens.
+///
+static bool match_node_tokens(const char * pattern, const char * node_name)
+{
+  if ('\0' == *pattern) {
+    return '\0' == *node_name;
+  }
+  const size_t pattern_length = node_token_length(pattern);
+  const char * pattern_rest = skip_node_token(pattern, pattern_length);
+  if (2U == pattern_length && 0 == strncmp(pattern, "**", 2U)) {
+    while (!match_node_tokens(pattern_rest, node_name)) {
+      if ('\0' == *node_name) {
+        return false;
+      }
+      node_name = skip_node_token(node_name, node_token_length(node_name));
+    }
+    return true;
+  }
+  if ('\0' == *node_name) {
+    return false;
+  }
+  const size_t name_length = node_token_length(node_name);
+  if (!(1U == pattern_length && '*' == *pattern) &&
+    (pattern_length != name_length || 0 != strncmp(pattern, node_name, name_length)))
+  {
+    return false;
+  }
+  return match_node_tokens(pattern_rest, skip_node_token(node_name, name_length));
+}
+
+///
+/// Check if the parameters of a node name pattern apply to any of the given nodes
+///
+static bool node_pattern_matches_any(
+  const char * pattern,
+  const char * const * node_names,
+  const size_t num_node_names)
+{
+  /// Patterns without a leading '/' are relative to the root namespace
+  if ('/' == *pattern) {
+    ++pattern;
+  }
+  for (size_t i = 0U; i < num_node_names; ++i) {
+    const char * node_name = '/' == *node_names[i] ? node_names[i] + 1 : node_names[i];
+    if (match_node_tokens(pattern, node_name)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+///
+/// Skip the events of a value, which may be a whole mapping or sequence
+///
+static rcutils_ret_t skip_value_events(yaml_parser_t * parser)
+{
+  uint32_t depth = 0U;
+  do {
+    yaml_event_t event;
+    if (0 == yaml_parser_parse(parser, &event)) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Error parsing a event near line %d", (uint32_t)(parser->mark.line) + 1U);
+      return RCUTILS_RET_ERROR;
+    }
+    switch (event.type) {
+      case YAML_MAPPING_START_EVENT:
+      case YAML_SEQUENCE_START_EVENT:
+        depth++;
+        break;
+      case YAML_MAPPING_END_EVENT:
+      case YAML_SEQUENCE_END_EVENT:
+        depth--;
+        break;
+      default:
+        break;
+    }
+    yaml_event_delete(&event);
+  } while (0U != depth);
+  return RCUTILS_RET_OK;
+}
+
 ///
 /// Get events from parsing a parameter YAML file and process them
 ///
@@ -753,6 +1086,19 @@ rcutils_ret_t parse_file_events(
   yaml_parser_t * parser,
   namespace_tracker_t * ns_tracker,
   rcl_params_t * params_st)
+{
+  return parse_file_events_for_nodes(parser, ns_tracker, NULL, 0U, params_st);
+}
+
+///
+/// Get events from parsing a parameter YAML file and process those of the given nodes
+///
+rcutils_ret_t parse_file_events_for_nodes(
+  yaml_parser_t * parser,
+  namespace_tracker_t * ns_tracker,
+  const char * const * node_names,
+  const size_t num_node_names,
+  rcl_params_t * params_st)
 {
   int32_t done_parsing = 0;
   bool is_key = true;
@@ -794,6 +1140,23 @@ rcutils_ret_t parse_file_events(
         {
           /// Need to toggle between key and value at params level
           if (is_key) {
+            if (NULL != node_names && MAP_NODE_NAME_LVL == map_level &&
+              0U != ns_tracker->num_node_ns &&
+              0 == strncmp(PARAMS_KEY, (char *)event.data.scalar.value, strlen(PARAMS_KEY)) &&
+              !node_pattern_matches_any(ns_tracker->node_ns, node_names, num_node_names))
+            {
+              /// The parameters do not apply to any of the nodes, skip them without
+              /// adding anything to params_st. The node name is removed from the
+              /// namespace as when they are parsed.
+              ret = rem_name_from_ns(ns_tracker, NS_TYPE_NODE, allocator);
+              if (RCUTILS_RET_OK != ret) {
+                RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+                  "Internal error removing node namespace at line %d", line_num);
+                break;
+              }
+              ret = skip_value_events(parser);
+              break;
+            }
             ret = parse_key(
               event, &map_level, &is_new_map, &node_idx, &parameter_idx, ns_tracker, params_st);
             if (RCUTILS_RET_OK != ret) {
@@ -987,14 +1350,21 @@ rcutils_ret_t find_parameter(
   assert(node_idx < param_st->num_nodes);
 
   rcl_node_params_t * node_param_st = &(param_st->params[node_idx]);
-  for (*parameter_idx = 0U; *parameter_idx < node_param_st->num_params; (*parameter_idx)++) {
-    if (0 == strcmp(node_param_st->parameter_names[*parameter_idx], parameter_name)) {
-      // Parameter found.
-      return RCUTILS_RET_OK;
-    }
+  rcutils_allocator_t allocator = param_st->allocator;
+  // The parameter is about to be set, which a copy sharing it must not see
+  rcutils_ret_t ret = node_params_make_unique(node_param_st, allocator);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  if (name_index_find(
+      &node_param_st->parameter_index, node_param_st->parameter_names,
+      node_param_st->num_params, parameter_name, allocator, parameter_idx))
+  {
+    // Parameter found.
+    return RCUTILS_RET_OK;
   }
   // Parameter not found, add it.
-  rcutils_allocator_t allocator = param_st->allocator;
+  *parameter_idx = node_param_st->num_params;
   // Reallocate if necessary
   if (node_param_st->num_params >= node_param_st->capacity_params) {
     if (RCUTILS_RET_OK != node_params_reallocate(
@@ -1012,6 +1382,13 @@ rcutils_ret_t find_parameter(
     return RCUTILS_RET_BAD_ALLOC;
   }
   node_param_st->num_params++;
+  // Best effort, the next lookup indexes it otherwise
+  if (RCUTILS_RET_OK != name_index_update(
+      &node_param_st->parameter_index, node_param_st->parameter_names,
+      node_param_st->num_params, allocator))
+  {
+    rcutils_reset_error();
+  }
   return RCUTILS_RET_OK;
 }
 
@@ -1027,14 +1404,16 @@ rcutils_ret_t find_node(
   assert(NULL != param_st);
   assert(NULL != node_idx);
 
-  for (*node_idx = 0U; *node_idx < param_st->num_nodes; (*node_idx)++) {
-    if (0 == strcmp(param_st->node_names[*node_idx], node_name)) {
-      // Node found.
-      return RCUTILS_RET_OK;
-    }
+  rcutils_allocator_t allocator = param_st->allocator;
+  if (name_index_find(
+      &param_st->node_index, param_st->node_names, param_st->num_nodes,
+      node_name, allocator, node_idx))
+  {
+    // Node found.
+    return RCUTILS_RET_OK;
   }
   // Node not found, add it.
-  rcutils_allocator_t allocator = param_st->allocator;
+  *node_idx = param_st->num_nodes;
   // Reallocate if necessary
   if (param_st->num_nodes >= param_st->capacity_nodes) {
     if (RCUTILS_RET_OK != rcl_yaml_node_struct_reallocate(
@@ -1054,5 +1433,11 @@ rcutils_ret_t find_node(
     return ret;
   }
   param_st->num_nodes++;
+  // Best effort, the next lookup indexes it otherwise
+  if (RCUTILS_RET_OK != name_index_update(
+      &param_st->node_index, param_st->node_names, param_st->num_nodes, allocator))
+  {
+    rcutils_reset_error();
+  }
   return RCUTILS_RET_OK;
 }
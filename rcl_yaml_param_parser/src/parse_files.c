@@ -0,0 +1,308 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include "rcl_yaml_param_parser/parser.h"
+#include "rcl_yaml_param_parser/types.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/types/rcutils_ret.h"
+
+#include "./impl/arena.h"
+#include "./impl/parse.h"
+#include "./impl/yaml_variant.h"
+
+/// Number of threads parsing files, the calling one included
+#define MAX_NUM_PARSE_THREADS 4U
+/// Below this many bytes of files, starting threads and merging costs more than it saves
+#define MIN_PARALLEL_PARSE_SIZE (64U * 1024U)
+
+///
+/// File to parse, and the outcome of parsing it
+///
+typedef struct parse_job_s
+{
+  const char * file_path;
+  rcl_params_t * params_st;
+  bool parsed;
+  rcutils_error_string_t error;
+} parse_job_t;
+
+///
+/// Files parsed by a thread, every `stride` job starting from `first_job`
+///
+typedef struct parse_worker_s
+{
+  parse_job_t * jobs;
+  size_t num_jobs;
+  size_t first_job;
+  size_t stride;
+} parse_worker_t;
+
+static void run_parse_worker(const parse_worker_t * worker)
+{
+  for (size_t i = worker->first_job; i < worker->num_jobs; i += worker->stride) {
+    parse_job_t * job = &worker->jobs[i];
+    job->parsed = rcl_parse_yaml_file(job->file_path, job->params_st);
+    if (!job->parsed) {
+      // Error states are per thread, keep the message for the calling one
+      job->error = rcutils_get_error_string();
+      rcutils_reset_error();
+    }
+  }
+}
+
+#ifdef _WIN32
+static size_t get_num_cpus(void)
+{
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return (size_t)info.dwNumberOfProcessors;
+}
+
+typedef HANDLE parse_thread_t;
+
+static DWORD WINAPI parse_thread_main(LPVOID arg)
+{
+  run_parse_worker(arg);
+  return 0;
+}
+
+static bool start_parse_thread(parse_thread_t * thread, parse_worker_t * worker)
+{
+  *thread = CreateThread(NULL, 0, parse_thread_main, worker, 0, NULL);
+  return NULL != *thread;
+}
+
+static void join_parse_thread(parse_thread_t thread)
+{
+  WaitForSingleObject(thread, INFINITE);
+  CloseHandle(thread);
+}
+#else
+static size_t get_num_cpus(void)
+{
+  const long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  return num_cpus > 0 ? (size_t)num_cpus : 1U;
+}
+
+typedef pthread_t parse_thread_t;
+
+static void * parse_thread_main(void * arg)
+{
+  run_parse_worker(arg);
+  return NULL;
+}
+
+static bool start_parse_thread(parse_thread_t * thread, parse_worker_t * worker)
+{
+  return 0 == pthread_create(thread, NULL, parse_thread_main, worker);
+}
+
+static void join_parse_thread(parse_thread_t thread)
+{
+  pthread_join(thread, NULL);
+}
+#endif
+
+///
+/// Get the number of threads worth parsing files on, 1 if they are better parsed in turn
+///
+static size_t get_num_parse_threads(const char * const * file_paths, size_t num_file_paths)
+{
+  size_t num_threads = get_num_cpus();
+  if (num_threads > MAX_NUM_PARSE_THREADS) {
+    num_threads = MAX_NUM_PARSE_THREADS;
+  }
+  if (num_threads > num_file_paths) {
+    num_threads = num_file_paths;
+  }
+  if (num_threads < 2U) {
+    return 1U;
+  }
+  size_t total_size = 0U;
+  for (size_t i = 0U; i < num_file_paths && total_size < MIN_PARALLEL_PARSE_SIZE; ++i) {
+    struct stat file_stat;
+    // Files which cannot be stat'ed fail to parse anyway
+    if (0 == stat(file_paths[i], &file_stat) && file_stat.st_size > 0) {
+      total_size += (size_t)file_stat.st_size;
+    }
+  }
+  return total_size < MIN_PARALLEL_PARSE_SIZE ? 1U : num_threads;
+}
+
+///
+/// Move the value of `src` into `dst`, unless `src` has none
+/// This mirrors parse_value(), which replaces the whole value of parameters it parses.
+///
+static void move_variant(
+  rcl_variant_t * dst,
+  rcl_variant_t * src,
+  const rcutils_allocator_t allocator)
+{
+  if (rcl_yaml_variant_is_empty(src)) {
+    return;
+  }
+  rcl_yaml_variant_fini(dst, allocator);
+  *dst = *src;
+  memset(src, 0, sizeof(*src));
+}
+
+///
+/// Apply the parameters of `src` over those of `params_st`, as if the file `src` was parsed
+/// from had been parsed into `params_st`
+/// Values are moved out of `src`, or copied if it does not share the allocator of `params_st`.
+///
+static rcutils_ret_t merge_params(rcl_params_t * params_st, rcl_params_t * src, bool copy)
+{
+  const rcutils_allocator_t allocator = params_st->allocator;
+  for (size_t node_idx = 0U; node_idx < src->num_nodes; ++node_idx) {
+    size_t dst_node_idx;
+    rcutils_ret_t ret = find_node(src->node_names[node_idx], params_st, &dst_node_idx);
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+    rcl_node_params_t * node_params = &src->params[node_idx];
+    for (size_t param_idx = 0U; param_idx < node_params->num_params; ++param_idx) {
+      size_t dst_param_idx;
+      ret = find_parameter(
+        dst_node_idx, node_params->parameter_names[param_idx], params_st, &dst_param_idx);
+      if (RCUTILS_RET_OK != ret) {
+        return ret;
+      }
+      rcl_variant_t * value = &node_params->parameter_values[param_idx];
+      rcl_variant_t copied;
+      memset(&copied, 0, sizeof(copied));
+      if (copy) {
+        if (!rcl_yaml_variant_copy(&copied, value, allocator)) {
+          rcl_yaml_variant_fini(&copied, allocator);
+          return RCUTILS_RET_BAD_ALLOC;
+        }
+        value = &copied;
+      }
+      move_variant(
+        &params_st->params[dst_node_idx].parameter_values[dst_param_idx], value, allocator);
+    }
+  }
+  return RCUTILS_RET_OK;
+}
+
+bool rcl_parse_yaml_files(
+  const char * const * file_paths,
+  size_t num_file_paths,
+  rcl_params_t * params_st)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(params_st, false);
+  if (0U == num_file_paths) {
+    return true;
+  }
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(file_paths, false);
+  for (size_t i = 0U; i < num_file_paths; ++i) {
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(file_paths[i], false);
+  }
+  const size_t num_threads = get_num_parse_threads(file_paths, num_file_paths);
+  if (1U == num_threads) {
+    for (size_t i = 0U; i < num_file_paths; ++i) {
+      if (!rcl_parse_yaml_file(file_paths[i], params_st)) {
+        rcutils_error_string_t error = rcutils_get_error_string();
+        rcutils_reset_error();
+        RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+          "Error parsing %s: %s", file_paths[i], error.str);
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Files after the first one are parsed into trees of their own, merged in order afterwards
+  const bool use_arenas = NULL != params_st->arena;
+  const rcutils_allocator_t allocator = use_arenas ?
+    arena_get_block_allocator(params_st->arena) : params_st->allocator;
+  parse_job_t * jobs = allocator.zero_allocate(
+    num_file_paths, sizeof(parse_job_t), allocator.state);
+  if (NULL == jobs) {
+    RCUTILS_SET_ERROR_MSG("Error allocating mem");
+    return false;
+  }
+  bool ret = true;
+  jobs[0].file_path = file_paths[0];
+  jobs[0].params_st = params_st;
+  for (size_t i = 1U; i < num_file_paths && ret; ++i) {
+    jobs[i].file_path = file_paths[i];
+    jobs[i].params_st = use_arenas ?
+      rcl_yaml_node_struct_init_with_arena(allocator) : rcl_yaml_node_struct_init(allocator);
+    ret = NULL != jobs[i].params_st;
+  }
+
+  if (ret) {
+    parse_worker_t workers[MAX_NUM_PARSE_THREADS];
+    parse_thread_t threads[MAX_NUM_PARSE_THREADS];
+    bool started[MAX_NUM_PARSE_THREADS];
+    for (size_t i = 0U; i < num_threads; ++i) {
+      workers[i].jobs = jobs;
+      workers[i].num_jobs = num_file_paths;
+      workers[i].first_job = i;
+      workers[i].stride = num_threads;
+      // The calling thread is the first worker
+      started[i] = 0U != i && start_parse_thread(&threads[i], &workers[i]);
+    }
+    for (size_t i = 0U; i < num_threads; ++i) {
+      if (!started[i]) {
+        run_parse_worker(&workers[i]);
+      }
+    }
+    for (size_t i = 0U; i < num_threads; ++i) {
+      if (started[i]) {
+        join_parse_thread(threads[i]);
+      }
+    }
+
+    for (size_t i = 0U; i < num_file_paths && ret; ++i) {
+      if (!jobs[i].parsed) {
+        RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+          "Error parsing %s: %s", jobs[i].file_path, jobs[i].error.str);
+        ret = false;
+      } else if (0U != i &&
+        RCUTILS_RET_OK != merge_params(params_st, jobs[i].params_st, use_arenas))
+      {
+        RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+          "Error merging parameters of %s", jobs[i].file_path);
+        ret = false;
+      }
+    }
+  } else {
+    RCUTILS_SET_ERROR_MSG("Error allocating mem");
+  }
+
+  for (size_t i = 1U; i < num_file_paths; ++i) {
+    if (NULL != jobs[i].params_st) {
+      rcl_yaml_node_struct_fini(jobs[i].params_st);
+    }
+  }
+  allocator.deallocate(jobs, allocator.state);
+  return ret;
+}
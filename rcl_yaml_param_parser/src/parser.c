@@ -32,7 +32,9 @@
 #include "rcutils/types/rcutils_ret.h"
 
 #include "./impl/types.h"
+#include "./impl/arena.h"
 #include "./impl/parse.h"
+#include "./impl/name_index.h"
 #include "./impl/node_params.h"
 #include "./impl/yaml_variant.h"
 
@@ -82,6 +84,7 @@ rcl_params_t * rcl_yaml_node_struct_init_with_capacity(
 
   params_st->num_nodes = 0U;
   params_st->capacity_nodes = capacity;
+  params_st->node_index = name_index_get_zero_initialized();
   return params_st;
 
 clean:
@@ -89,6 +92,30 @@ clean:
   return NULL;
 }
 
+static rcl_params_t * init_with_arena_and_capacity(
+  size_t capacity,
+  const rcutils_allocator_t allocator)
+{
+  rcl_yaml_arena_t * arena = arena_init(allocator);
+  if (NULL == arena) {
+    return NULL;
+  }
+  rcl_params_t * params_st = rcl_yaml_node_struct_init_with_capacity(
+    capacity, arena_get_allocator(arena));
+  if (NULL == params_st) {
+    arena_fini(arena);
+    return NULL;
+  }
+  params_st->arena = arena;
+  return params_st;
+}
+
+rcl_params_t * rcl_yaml_node_struct_init_with_arena(
+  const rcutils_allocator_t allocator)
+{
+  return init_with_arena_and_capacity(INIT_NUM_NODE_ENTRIES, allocator);
+}
+
 rcutils_ret_t rcl_yaml_node_struct_reallocate(
   rcl_params_t * params_st,
   size_t new_capacity,
@@ -146,15 +173,22 @@ rcl_params_t * rcl_yaml_node_struct_copy(
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(params_st, NULL);
 
-  rcutils_allocator_t allocator = params_st->allocator;
-  rcl_params_t * out_params_st = rcl_yaml_node_struct_init_with_capacity(
-    params_st->capacity_nodes,
-    allocator);
+  rcl_params_t * out_params_st = NULL;
+  if (NULL != params_st->arena) {
+    out_params_st = init_with_arena_and_capacity(
+      params_st->capacity_nodes,
+      arena_get_block_allocator(params_st->arena));
+  } else {
+    out_params_st = rcl_yaml_node_struct_init_with_capacity(
+      params_st->capacity_nodes,
+      params_st->allocator);
+  }
 
   if (NULL == out_params_st) {
     RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem\n");
     return NULL;
   }
+  rcutils_allocator_t allocator = out_params_st->allocator;
 
   rcutils_ret_t ret;
   for (size_t node_idx = 0U; node_idx < params_st->num_nodes; ++node_idx) {
@@ -166,34 +200,25 @@ rcl_params_t * rcl_yaml_node_struct_copy(
     }
     out_params_st->num_nodes++;
 
-    rcl_node_params_t * node_params_st = &(params_st->params[node_idx]);
+    const rcl_node_params_t * node_params_st = &(params_st->params[node_idx]);
     rcl_node_params_t * out_node_params_st = &(out_params_st->params[node_idx]);
-    ret = node_params_init_with_capacity(
-      out_node_params_st,
-      node_params_st->capacity_params,
-      allocator);
-    if (RCUTILS_RET_OK != ret) {
-      if (RCUTILS_RET_BAD_ALLOC == ret) {
-        RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem\n");
-      }
-      goto fail;
-    }
-    for (size_t parameter_idx = 0U; parameter_idx < node_params_st->num_params; ++parameter_idx) {
-      out_node_params_st->parameter_names[parameter_idx] =
-        rcutils_strdup(node_params_st->parameter_names[parameter_idx], allocator);
-      if (NULL == out_node_params_st->parameter_names[parameter_idx]) {
-        RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem\n");
-        goto fail;
-      }
-      out_node_params_st->num_params++;
-
-      const rcl_variant_t * param_var = &(node_params_st->parameter_values[parameter_idx]);
-      rcl_variant_t * out_param_var = &(out_node_params_st->parameter_values[parameter_idx]);
-      if (!rcl_yaml_variant_copy(out_param_var, param_var, allocator)) {
+    // Parameters are shared until either structure modifies them, unless in an arena
+    if (NULL != params_st->arena || !node_params_share(out_node_params_st, node_params_st)) {
+      ret = node_params_copy(out_node_params_st, node_params_st, allocator);
+      if (RCUTILS_RET_OK != ret) {
+        if (RCUTILS_RET_BAD_ALLOC == ret) {
+          RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem\n");
+        }
         goto fail;
       }
     }
   }
+  ret = name_index_update(
+    &out_params_st->node_index, out_params_st->node_names, out_params_st->num_nodes, allocator);
+  if (RCUTILS_RET_OK != ret) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem\n");
+    goto fail;
+  }
   return out_params_st;
 
 fail:
@@ -212,6 +237,11 @@ void rcl_yaml_node_struct_fini(
   if (NULL == params_st) {
     return;
   }
+  if (NULL != params_st->arena) {
+    // The structure itself was carved from the arena
+    arena_fini(params_st->arena);
+    return;
+  }
   rcutils_allocator_t allocator = params_st->allocator;
 
   if (NULL != params_st->node_names) {
@@ -235,6 +265,8 @@ void rcl_yaml_node_struct_fini(
     params_st->params = NULL;
   }  // if (params)
 
+  name_index_fini(&params_st->node_index, allocator);
+
   params_st->num_nodes = 0U;
   params_st->capacity_nodes = 0U;
   allocator.deallocate(params_st, allocator.state);
@@ -244,10 +276,13 @@ void rcl_yaml_node_struct_fini(
 /// TODO (anup.pemmaiah): Support Mutiple yaml files
 ///
 ///
-/// Parse the YAML file and populate params_st
+/// Parse the YAML file and populate params_st with the parameters of the given nodes,
+/// or of every node if node_names is NULL
 ///
-bool rcl_parse_yaml_file(
+static bool parse_yaml_file(
   const char * file_path,
+  const char * const * node_names,
+  const size_t num_node_names,
   rcl_params_t * params_st)
 {
   RCUTILS_CHECK_FOR_NULL_WITH_MSG(
@@ -276,7 +311,8 @@ bool rcl_parse_yaml_file(
 
   namespace_tracker_t ns_tracker;
   memset(&ns_tracker, 0, sizeof(namespace_tracker_t));
-  rcutils_ret_t ret = parse_file_events(&parser, &ns_tracker, params_st);
+  rcutils_ret_t ret = parse_file_events_for_nodes(
+    &parser, &ns_tracker, node_names, num_node_names, params_st);
 
   fclose(yaml_file);
 
@@ -293,6 +329,39 @@ bool rcl_parse_yaml_file(
   return RCUTILS_RET_OK == ret;
 }
 
+///
+/// Parse the YAML file and populate params_st
+///
+bool rcl_parse_yaml_file(
+  const char * file_path,
+  rcl_params_t * params_st)
+{
+  return parse_yaml_file(file_path, NULL, 0U, params_st);
+}
+
+///
+/// Parse the YAML file and populate params_st with the parameters of some nodes only
+///
+bool rcl_parse_yaml_file_for_nodes(
+  const char * file_path,
+  const char * const * node_names,
+  size_t num_node_names,
+  rcl_params_t * params_st)
+{
+  if (0U == num_node_names) {
+    /// No parameter applies, but the file is still parsed for errors
+    static const char * const no_node_names[] = {""};
+    return parse_yaml_file(file_path, no_node_names, 0U, params_st);
+  }
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    node_names, "node names are NULL", return false);
+  for (size_t i = 0U; i < num_node_names; ++i) {
+    RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+      node_names[i], "node name is NULL", return false);
+  }
+  return parse_yaml_file(file_path, node_names, num_node_names, params_st);
+}
+
 ///
 /// Parse a YAML string and populate params_st
 ///
@@ -367,6 +436,33 @@ rcl_variant_t * rcl_yaml_node_struct_get(
   return param_value;
 }
 
+const rcl_variant_t * rcl_yaml_node_struct_find(
+  const char * node_name,
+  const char * param_name,
+  const rcl_params_t * params_st)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(node_name, NULL);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(param_name, NULL);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(params_st, NULL);
+
+  size_t node_idx = 0U;
+  if (!name_index_lookup(
+      &params_st->node_index, params_st->node_names, params_st->num_nodes,
+      node_name, &node_idx))
+  {
+    return NULL;
+  }
+  const rcl_node_params_t * node_params_st = &(params_st->params[node_idx]);
+  size_t parameter_idx = 0U;
+  if (!name_index_lookup(
+      &node_params_st->parameter_index, node_params_st->parameter_names,
+      node_params_st->num_params, param_name, &parameter_idx))
+  {
+    return NULL;
+  }
+  return &(node_params_st->parameter_values[parameter_idx]);
+}
+
 ///
 /// Dump the param structure
 ///
@@ -0,0 +1,365 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "rcl_yaml_param_parser/parser.h"
+#include "rcl_yaml_param_parser/types.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/strdup.h"
+#include "rcutils/types/rcutils_ret.h"
+
+#include "./impl/arena.h"
+#include "./impl/name_index.h"
+#include "./impl/node_params.h"
+#include "./impl/parse.h"
+#include "./impl/yaml_variant.h"
+
+#define INIT_NUM_CHANGES 16U
+
+rcl_params_diff_t rcl_yaml_params_diff_get_zero_initialized(void)
+{
+  rcl_params_diff_t diff;
+  memset(&diff, 0, sizeof(diff));
+  return diff;
+}
+
+void rcl_yaml_params_diff_fini(
+  rcl_params_diff_t * diff)
+{
+  if (NULL == diff) {
+    return;
+  }
+  if (NULL != diff->changes) {
+    rcutils_allocator_t allocator = diff->allocator;
+    for (size_t change_idx = 0U; change_idx < diff->num_changes; ++change_idx) {
+      rcl_param_change_t * change = &diff->changes[change_idx];
+      if (NULL != change->node_name) {
+        allocator.deallocate(change->node_name, allocator.state);
+      }
+      if (NULL != change->parameter_name) {
+        allocator.deallocate(change->parameter_name, allocator.state);
+      }
+      rcl_yaml_variant_fini(&change->value, allocator);
+    }
+    allocator.deallocate(diff->changes, allocator.state);
+  }
+  *diff = rcl_yaml_params_diff_get_zero_initialized();
+}
+
+///
+/// Find a node of a parameter structure without adding it
+///
+static rcl_node_params_t * lookup_node(rcl_params_t * params_st, const char * node_name)
+{
+  size_t node_idx;
+  if (!name_index_find(
+      &params_st->node_index, params_st->node_names, params_st->num_nodes,
+      node_name, params_st->allocator, &node_idx))
+  {
+    return NULL;
+  }
+  return &params_st->params[node_idx];
+}
+
+///
+/// Find a parameter of a node without adding it
+/// The parameters may be shared with other structures, they are left untouched.
+///
+static const rcl_variant_t * lookup_parameter(
+  const rcl_node_params_t * node_params,
+  const char * parameter_name)
+{
+  size_t parameter_idx;
+  if (NULL == node_params || !name_index_lookup(
+      &node_params->parameter_index, node_params->parameter_names, node_params->num_params,
+      parameter_name, &parameter_idx))
+  {
+    return NULL;
+  }
+  return &node_params->parameter_values[parameter_idx];
+}
+
+///
+/// Append a change to a diff, copying the names and the new value if any
+///
+static rcutils_ret_t add_change(
+  rcl_params_diff_t * diff,
+  rcl_param_change_kind_t kind,
+  const char * node_name,
+  const char * parameter_name,
+  const rcl_variant_t * value)
+{
+  rcutils_allocator_t allocator = diff->allocator;
+  if (diff->num_changes == diff->capacity_changes) {
+    size_t capacity =
+      0U == diff->capacity_changes ? INIT_NUM_CHANGES : 2U * diff->capacity_changes;
+    void * changes = allocator.reallocate(
+      diff->changes, capacity * sizeof(rcl_param_change_t), allocator.state);
+    if (NULL == changes) {
+      RCUTILS_SET_ERROR_MSG("Failed to allocate memory for parameter changes");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+    diff->changes = changes;
+    diff->capacity_changes = capacity;
+  }
+
+  rcl_param_change_t * change = &diff->changes[diff->num_changes];
+  memset(change, 0, sizeof(*change));
+  // Counted right away so that rcl_yaml_params_diff_fini() frees it if a copy fails
+  diff->num_changes++;
+  change->kind = kind;
+  change->node_name = rcutils_strdup(node_name, allocator);
+  change->parameter_name = rcutils_strdup(parameter_name, allocator);
+  if (NULL == change->node_name || NULL == change->parameter_name ||
+    (NULL != value && !rcl_yaml_variant_copy(&change->value, value, allocator)))
+  {
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory for parameter change");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  return RCUTILS_RET_OK;
+}
+
+///
+/// Record the differences between the parameters of `params_st` and `new_params_st`
+///
+static rcutils_ret_t collect_changes(
+  rcl_params_t * params_st,
+  rcl_params_t * new_params_st,
+  rcl_params_diff_t * diff)
+{
+  rcutils_ret_t ret;
+  for (size_t node_idx = 0U; node_idx < params_st->num_nodes; ++node_idx) {
+    const char * node_name = params_st->node_names[node_idx];
+    const rcl_node_params_t * node_params = &params_st->params[node_idx];
+    rcl_node_params_t * new_node_params = lookup_node(new_params_st, node_name);
+    for (size_t param_idx = 0U; param_idx < node_params->num_params; ++param_idx) {
+      const char * param_name = node_params->parameter_names[param_idx];
+      const rcl_variant_t * value = &node_params->parameter_values[param_idx];
+      const rcl_variant_t * new_value =
+        lookup_parameter(new_node_params, param_name);
+      if (NULL == new_value) {
+        ret = add_change(diff, RCL_PARAM_CHANGE_REMOVED, node_name, param_name, NULL);
+      } else if (!rcl_yaml_variant_equal(value, new_value)) {
+        ret = add_change(diff, RCL_PARAM_CHANGE_CHANGED, node_name, param_name, new_value);
+      } else {
+        ret = RCUTILS_RET_OK;
+      }
+      if (RCUTILS_RET_OK != ret) {
+        return ret;
+      }
+    }
+  }
+
+  for (size_t node_idx = 0U; node_idx < new_params_st->num_nodes; ++node_idx) {
+    const char * node_name = new_params_st->node_names[node_idx];
+    const rcl_node_params_t * new_node_params = &new_params_st->params[node_idx];
+    rcl_node_params_t * node_params = lookup_node(params_st, node_name);
+    for (size_t param_idx = 0U; param_idx < new_node_params->num_params; ++param_idx) {
+      const char * param_name = new_node_params->parameter_names[param_idx];
+      if (NULL == lookup_parameter(node_params, param_name)) {
+        ret = add_change(
+          diff, RCL_PARAM_CHANGE_ADDED, node_name, param_name,
+          &new_node_params->parameter_values[param_idx]);
+        if (RCUTILS_RET_OK != ret) {
+          return ret;
+        }
+      }
+    }
+  }
+  return RCUTILS_RET_OK;
+}
+
+///
+/// Copy the parameters of the nodes of `params_st` which are shared with copies of the
+/// structure and which some parameters are about to be removed from
+///
+static rcutils_ret_t make_unique_nodes_with_missing_params(
+  rcl_params_t * params_st,
+  rcl_params_t * new_params_st)
+{
+  for (size_t node_idx = 0U; node_idx < params_st->num_nodes; ++node_idx) {
+    rcl_node_params_t * node_params = &params_st->params[node_idx];
+    rcl_node_params_t * new_node_params =
+      lookup_node(new_params_st, params_st->node_names[node_idx]);
+    if (NULL == new_node_params) {
+      // Removed as a whole, which only releases shared parameters
+      continue;
+    }
+    for (size_t param_idx = 0U; param_idx < node_params->num_params; ++param_idx) {
+      if (NULL == lookup_parameter(new_node_params, node_params->parameter_names[param_idx])) {
+        rcutils_ret_t ret = node_params_make_unique(node_params, params_st->allocator);
+        if (RCUTILS_RET_OK != ret) {
+          return ret;
+        }
+        break;
+      }
+    }
+  }
+  return RCUTILS_RET_OK;
+}
+
+///
+/// Remove the nodes and parameters of `params_st` which `new_params_st` does not have
+/// The others are moved down to fill the gaps, keeping their order.
+/// \pre make_unique_nodes_with_missing_params() succeeded
+///
+static void remove_missing_params(rcl_params_t * params_st, rcl_params_t * new_params_st)
+{
+  const rcutils_allocator_t allocator = params_st->allocator;
+  size_t num_nodes = 0U;
+  for (size_t node_idx = 0U; node_idx < params_st->num_nodes; ++node_idx) {
+    rcl_node_params_t * node_params = &params_st->params[node_idx];
+    rcl_node_params_t * new_node_params =
+      lookup_node(new_params_st, params_st->node_names[node_idx]);
+    if (NULL == new_node_params) {
+      rcl_yaml_node_params_fini(node_params, allocator);
+      allocator.deallocate(params_st->node_names[node_idx], allocator.state);
+      continue;
+    }
+
+    size_t num_params = 0U;
+    for (size_t param_idx = 0U; param_idx < node_params->num_params; ++param_idx) {
+      char * param_name = node_params->parameter_names[param_idx];
+      rcl_variant_t * value = &node_params->parameter_values[param_idx];
+      if (NULL == lookup_parameter(new_node_params, param_name)) {
+        allocator.deallocate(param_name, allocator.state);
+        rcl_yaml_variant_fini(value, allocator);
+        continue;
+      }
+      node_params->parameter_names[num_params] = param_name;
+      node_params->parameter_values[num_params] = *value;
+      ++num_params;
+    }
+    if (num_params != node_params->num_params) {
+      const size_t num_removed = node_params->num_params - num_params;
+      memset(&node_params->parameter_names[num_params], 0, num_removed * sizeof(char *));
+      memset(&node_params->parameter_values[num_params], 0, num_removed * sizeof(rcl_variant_t));
+      node_params->num_params = num_params;
+      name_index_invalidate(&node_params->parameter_index);
+    }
+
+    params_st->node_names[num_nodes] = params_st->node_names[node_idx];
+    params_st->params[num_nodes] = *node_params;
+    ++num_nodes;
+  }
+  if (num_nodes != params_st->num_nodes) {
+    const size_t num_removed = params_st->num_nodes - num_nodes;
+    memset(&params_st->node_names[num_nodes], 0, num_removed * sizeof(char *));
+    memset(&params_st->params[num_nodes], 0, num_removed * sizeof(rcl_node_params_t));
+    params_st->num_nodes = num_nodes;
+    name_index_invalidate(&params_st->node_index);
+  }
+}
+
+///
+/// Set the values of `params_st` which differ from those of `new_params_st`, adding the
+/// nodes and parameters it is missing
+/// Values are moved out of `new_params_st`, or copied if it does not share the allocator
+/// of `params_st`.
+///
+static rcutils_ret_t set_changed_params(
+  rcl_params_t * params_st,
+  rcl_params_t * new_params_st,
+  bool copy)
+{
+  const rcutils_allocator_t allocator = params_st->allocator;
+  for (size_t new_node_idx = 0U; new_node_idx < new_params_st->num_nodes; ++new_node_idx) {
+    const char * node_name = new_params_st->node_names[new_node_idx];
+    size_t node_idx;
+    rcutils_ret_t ret = find_node(node_name, params_st, &node_idx);
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+    rcl_node_params_t * new_node_params = &new_params_st->params[new_node_idx];
+    for (size_t new_param_idx = 0U; new_param_idx < new_node_params->num_params; ++new_param_idx) {
+      const char * param_name = new_node_params->parameter_names[new_param_idx];
+      rcl_variant_t * new_value = &new_node_params->parameter_values[new_param_idx];
+      // Looked up first, as find_parameter() copies parameters shared with other structures
+      const rcl_variant_t * unchanged_value =
+        lookup_parameter(&params_st->params[node_idx], param_name);
+      if (NULL != unchanged_value && rcl_yaml_variant_equal(unchanged_value, new_value)) {
+        continue;
+      }
+      size_t param_idx;
+      ret = find_parameter(node_idx, param_name, params_st, &param_idx);
+      if (RCUTILS_RET_OK != ret) {
+        return ret;
+      }
+      rcl_variant_t * value = &params_st->params[node_idx].parameter_values[param_idx];
+      rcl_variant_t copied;
+      memset(&copied, 0, sizeof(copied));
+      if (copy) {
+        if (!rcl_yaml_variant_copy(&copied, new_value, allocator)) {
+          rcl_yaml_variant_fini(&copied, allocator);
+          return RCUTILS_RET_BAD_ALLOC;
+        }
+        new_value = &copied;
+      }
+      rcl_yaml_variant_fini(value, allocator);
+      *value = *new_value;
+      memset(new_value, 0, sizeof(*new_value));
+    }
+  }
+  return RCUTILS_RET_OK;
+}
+
+bool rcl_yaml_node_struct_reload(
+  const char * file_path,
+  rcl_params_t * params_st,
+  rcl_params_diff_t * diff)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(file_path, false);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(params_st, false);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(diff, false);
+  if (NULL != diff->changes) {
+    RCUTILS_SET_ERROR_MSG("diff must be zero initialized");
+    return false;
+  }
+
+  // The new tree never has an arena, its values are copied into the arena of params_st
+  const bool use_arena = NULL != params_st->arena;
+  const rcutils_allocator_t allocator = use_arena ?
+    arena_get_block_allocator(params_st->arena) : params_st->allocator;
+  rcl_params_t * new_params_st = rcl_yaml_node_struct_init(allocator);
+  if (NULL == new_params_st) {
+    return false;
+  }
+  if (!rcl_parse_yaml_file(file_path, new_params_st)) {
+    rcl_yaml_node_struct_fini(new_params_st);
+    return false;
+  }
+
+  diff->allocator = allocator;
+  rcutils_ret_t ret = collect_changes(params_st, new_params_st, diff);
+  if (RCUTILS_RET_OK == ret) {
+    ret = make_unique_nodes_with_missing_params(params_st, new_params_st);
+  }
+  if (RCUTILS_RET_OK == ret) {
+    remove_missing_params(params_st, new_params_st);
+    ret = set_changed_params(params_st, new_params_st, use_arena);
+    if (RCUTILS_RET_OK != ret) {
+      RCUTILS_SET_ERROR_MSG("Error allocating mem");
+    }
+  }
+  if (RCUTILS_RET_OK != ret) {
+    rcl_yaml_params_diff_fini(diff);
+  }
+  rcl_yaml_node_struct_fini(new_params_st);
+  return RCUTILS_RET_OK == ret;
+}
@@ -0,0 +1,822 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "rcl_yaml_param_parser/parser.h"
+#include "rcl_yaml_param_parser/types.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/format_string.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/types/string_array.h"
+
+#include "./impl/arena.h"
+#include "./impl/name_index.h"
+#include "./impl/node_params.h"
+
+/// Start of every snapshot
+#define SNAPSHOT_MAGIC "RCLPARAM"
+/// Bumped whenever the layout of snapshots, or the hash of the name indexes, changes
+#define SNAPSHOT_VERSION 1U
+/// Snapshots are written in native byte order and only loaded with the same one
+#define SNAPSHOT_BYTE_ORDER_MARK 0x01020304U
+/// Alignment of every section of a snapshot
+#define SNAPSHOT_ALIGNMENT 8U
+#define ALIGN_UP(size) (((size) + SNAPSHOT_ALIGNMENT - 1U) & ~(size_t)(SNAPSHOT_ALIGNMENT - 1U))
+#define INIT_SNAPSHOT_SIZE 4096U
+#define INIT_NUM_SNAPSHOT_STRINGS 128U
+
+// Boolean values are mapped in place, one byte each
+_Static_assert(sizeof(bool) == 1U, "bool values must be one byte long");
+
+typedef enum snapshot_value_type_e
+{
+  SNAPSHOT_TYPE_NONE = 0U,
+  SNAPSHOT_TYPE_BOOL = 1U,
+  SNAPSHOT_TYPE_INTEGER = 2U,
+  SNAPSHOT_TYPE_DOUBLE = 3U,
+  SNAPSHOT_TYPE_STRING = 4U,
+  SNAPSHOT_TYPE_BYTE_ARRAY = 5U,
+  SNAPSHOT_TYPE_BOOL_ARRAY = 6U,
+  SNAPSHOT_TYPE_INTEGER_ARRAY = 7U,
+  SNAPSHOT_TYPE_DOUBLE_ARRAY = 8U,
+  SNAPSHOT_TYPE_STRING_ARRAY = 9U
+} snapshot_value_type_t;
+
+/// Header of a snapshot
+/// Offsets are counted from the start of the snapshot, and strings are referred to by their
+/// index in the string table.
+typedef struct snapshot_header_s
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint64_t size;  ///< Size of the whole snapshot
+  uint64_t num_nodes;
+  uint64_t nodes;  ///< Offset of the snapshot_node_t of every node
+  uint64_t node_index;  ///< Offset of the slots of the index of the node names
+  uint64_t node_index_capacity;  ///< Number of slots of the index of the node names
+  uint64_t num_strings;
+  uint64_t string_offsets;  ///< Offset of the offsets of every string
+  uint64_t strings;  ///< Offset of the null terminated strings
+  uint64_t strings_size;  ///< Size of the strings, terminators included
+} snapshot_header_t;
+
+typedef struct snapshot_node_s
+{
+  uint64_t name;
+  uint64_t num_params;
+  uint64_t params;  ///< Offset of the snapshot_param_t of every parameter
+  uint64_t index;  ///< Offset of the slots of the index of the parameter names
+  uint64_t index_capacity;  ///< Number of slots of the index of the parameter names
+} snapshot_node_t;
+
+typedef struct snapshot_param_s
+{
+  uint64_t name;
+  uint64_t type;  ///< A snapshot_value_type_t
+  uint64_t size;  ///< Number of values of arrays
+  /// Scalars are stored in place, strings as their index and arrays as the offset of their values
+  union
+  {
+    bool boolean;
+    int64_t integer;
+    double floating;
+    uint64_t reference;
+  } value;
+} snapshot_param_t;
+
+///
+/// Snapshot being written, and the distinct strings of its string table
+///
+typedef struct snapshot_writer_s
+{
+  rcutils_allocator_t allocator;
+  unsigned char * data;
+  size_t size;
+  size_t capacity;
+  char ** strings;
+  size_t num_strings;
+  size_t capacity_strings;
+  rcl_yaml_name_index_t string_index;
+} snapshot_writer_t;
+
+#define WRITER_AT(writer, offset, type) ((type *)(void *)((writer)->data + (offset)))
+
+///
+/// Append `size` zeroed bytes to a snapshot and get their offset
+///
+static bool writer_reserve(snapshot_writer_t * writer, size_t size, uint64_t * offset)
+{
+  const size_t start = ALIGN_UP(writer->size);
+  if (size > SIZE_MAX / 2U - start) {
+    return false;
+  }
+  const size_t end = start + size;
+  if (end > writer->capacity) {
+    size_t capacity = 0U == writer->capacity ? INIT_SNAPSHOT_SIZE : writer->capacity;
+    while (capacity < end) {
+      capacity *= 2U;
+    }
+    unsigned char * data = writer->allocator.reallocate(
+      writer->data, capacity, writer->allocator.state);
+    if (NULL == data) {
+      return false;
+    }
+    writer->data = data;
+    writer->capacity = capacity;
+  }
+  memset(writer->data + writer->size, 0, end - writer->size);
+  writer->size = end;
+  *offset = (uint64_t)start;
+  return true;
+}
+
+///
+/// Get the index of a string in the string table, adding it if needed
+///
+static bool writer_add_string(snapshot_writer_t * writer, char * string, uint64_t * id)
+{
+  if (NULL == string) {
+    return false;
+  }
+  size_t idx;
+  if (name_index_find(
+      &writer->string_index, writer->strings, writer->num_strings, string,
+      writer->allocator, &idx))
+  {
+    *id = (uint64_t)idx;
+    return true;
+  }
+  if (writer->num_strings == writer->capacity_strings) {
+    const size_t capacity = 0U == writer->capacity_strings ?
+      INIT_NUM_SNAPSHOT_STRINGS : writer->capacity_strings * 2U;
+    char ** strings = writer->allocator.reallocate(
+      writer->strings, capacity * sizeof(char *), writer->allocator.state);
+    if (NULL == strings) {
+      return false;
+    }
+    writer->strings = strings;
+    writer->capacity_strings = capacity;
+  }
+  writer->strings[writer->num_strings] = string;
+  *id = (uint64_t)writer->num_strings;
+  writer->num_strings++;
+  return true;
+}
+
+///
+/// Append the hash index of an array of names
+///
+static bool writer_add_index(
+  snapshot_writer_t * writer,
+  char * const * names,
+  size_t num_names,
+  uint64_t * offset,
+  uint64_t * capacity)
+{
+  rcl_yaml_name_index_t index = name_index_get_zero_initialized();
+  if (RCUTILS_RET_OK != name_index_update(&index, names, num_names, writer->allocator)) {
+    return false;
+  }
+  bool ret = writer_reserve(writer, index.capacity * sizeof(uint64_t), offset);
+  if (ret) {
+    for (size_t slot = 0U; slot < index.capacity; ++slot) {
+      WRITER_AT(writer, *offset, uint64_t)[slot] = (uint64_t)index.slots[slot];
+    }
+    *capacity = (uint64_t)index.capacity;
+  }
+  name_index_fini(&index, writer->allocator);
+  return ret;
+}
+
+#define WRITER_ADD_ARRAY(writer, param, array, snapshot_type) \
+  do { \
+    param->type = snapshot_type; \
+    param->size = (uint64_t)array->size; \
+    if (!writer_reserve( \
+        writer, array->size * sizeof(*array->values), &param->value.reference)) \
+    { \
+      return false; \
+    } \
+    if (0U != array->size) { \
+      memcpy( \
+        WRITER_AT(writer, param->value.reference, unsigned char), array->values, \
+        array->size * sizeof(*array->values)); \
+    } \
+  } while (0)
+
+///
+/// Fill the type and value of a parameter, appending the values of arrays
+///
+static bool writer_add_value(
+  snapshot_writer_t * writer,
+  const rcl_variant_t * value,
+  snapshot_param_t * param)
+{
+  if (NULL != value->bool_value) {
+    param->type = SNAPSHOT_TYPE_BOOL;
+    param->value.boolean = *value->bool_value;
+  } else if (NULL != value->integer_value) {
+    param->type = SNAPSHOT_TYPE_INTEGER;
+    param->value.integer = *value->integer_value;
+  } else if (NULL != value->double_value) {
+    param->type = SNAPSHOT_TYPE_DOUBLE;
+    param->value.floating = *value->double_value;
+  } else if (NULL != value->string_value) {
+    param->type = SNAPSHOT_TYPE_STRING;
+    return writer_add_string(writer, value->string_value, &param->value.reference);
+  } else if (NULL != value->byte_array_value) {
+    WRITER_ADD_ARRAY(writer, param, value->byte_array_value, SNAPSHOT_TYPE_BYTE_ARRAY);
+  } else if (NULL != value->bool_array_value) {
+    WRITER_ADD_ARRAY(writer, param, value->bool_array_value, SNAPSHOT_TYPE_BOOL_ARRAY);
+  } else if (NULL != value->integer_array_value) {
+    WRITER_ADD_ARRAY(writer, param, value->integer_array_value, SNAPSHOT_TYPE_INTEGER_ARRAY);
+  } else if (NULL != value->double_array_value) {
+    WRITER_ADD_ARRAY(writer, param, value->double_array_value, SNAPSHOT_TYPE_DOUBLE_ARRAY);
+  } else if (NULL != value->string_array_value) {
+    const rcutils_string_array_t * array = value->string_array_value;
+    param->type = SNAPSHOT_TYPE_STRING_ARRAY;
+    param->size = (uint64_t)array->size;
+    if (!writer_reserve(writer, array->size * sizeof(uint64_t), &param->value.reference)) {
+      return false;
+    }
+    for (size_t i = 0U; i < array->size; ++i) {
+      uint64_t id;
+      if (!writer_add_string(writer, array->data[i], &id)) {
+        return false;
+      }
+      WRITER_AT(writer, param->value.reference, uint64_t)[i] = id;
+    }
+  } else {
+    param->type = SNAPSHOT_TYPE_NONE;
+  }
+  return true;
+}
+
+///
+/// Append the parameters of a node
+///
+static bool writer_add_node(
+  snapshot_writer_t * writer,
+  const rcl_node_params_t * node_params,
+  snapshot_node_t * node)
+{
+  node->num_params = (uint64_t)node_params->num_params;
+  if (!writer_reserve(
+      writer, node_params->num_params * sizeof(snapshot_param_t), &node->params) ||
+    !writer_add_index(
+      writer, node_params->parameter_names, node_params->num_params, &node->index,
+      &node->index_capacity))
+  {
+    return false;
+  }
+  for (size_t param_idx = 0U; param_idx < node_params->num_params; ++param_idx) {
+    // Records are filled on the side, appending values may move the snapshot
+    snapshot_param_t param;
+    memset(&param, 0, sizeof(param));
+    if (!writer_add_string(writer, node_params->parameter_names[param_idx], &param.name) ||
+      !writer_add_value(writer, &node_params->parameter_values[param_idx], &param))
+    {
+      return false;
+    }
+    WRITER_AT(writer, node->params, snapshot_param_t)[param_idx] = param;
+  }
+  return true;
+}
+
+///
+/// Append the string table
+///
+static bool writer_add_strings(snapshot_writer_t * writer, snapshot_header_t * header)
+{
+  size_t strings_size = 0U;
+  for (size_t i = 0U; i < writer->num_strings; ++i) {
+    strings_size += strlen(writer->strings[i]) + 1U;
+  }
+  header->num_strings = (uint64_t)writer->num_strings;
+  header->strings_size = (uint64_t)strings_size;
+  if (!writer_reserve(
+      writer, writer->num_strings * sizeof(uint64_t), &header->string_offsets) ||
+    !writer_reserve(writer, strings_size, &header->strings))
+  {
+    return false;
+  }
+  uint64_t offset = header->strings;
+  for (size_t i = 0U; i < writer->num_strings; ++i) {
+    const size_t length = strlen(writer->strings[i]) + 1U;
+    WRITER_AT(writer, header->string_offsets, uint64_t)[i] = offset;
+    memcpy(WRITER_AT(writer, offset, char), writer->strings[i], length);
+    offset += length;
+  }
+  return true;
+}
+
+///
+/// Serialize a parameter structure
+///
+static bool writer_add_params(snapshot_writer_t * writer, const rcl_params_t * params_st)
+{
+  snapshot_header_t header;
+  memset(&header, 0, sizeof(header));
+  uint64_t header_offset;
+  if (!writer_reserve(writer, sizeof(snapshot_header_t), &header_offset)) {
+    return false;
+  }
+  header.num_nodes = (uint64_t)params_st->num_nodes;
+  if (!writer_reserve(writer, params_st->num_nodes * sizeof(snapshot_node_t), &header.nodes) ||
+    !writer_add_index(
+      writer, params_st->node_names, params_st->num_nodes, &header.node_index,
+      &header.node_index_capacity))
+  {
+    return false;
+  }
+  for (size_t node_idx = 0U; node_idx < params_st->num_nodes; ++node_idx) {
+    snapshot_node_t node;
+    memset(&node, 0, sizeof(node));
+    if (!writer_add_string(writer, params_st->node_names[node_idx], &node.name) ||
+      !writer_add_node(writer, &params_st->params[node_idx], &node))
+    {
+      return false;
+    }
+    WRITER_AT(writer, header.nodes, snapshot_node_t)[node_idx] = node;
+  }
+  if (!writer_add_strings(writer, &header)) {
+    return false;
+  }
+  memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.version = SNAPSHOT_VERSION;
+  header.byte_order = SNAPSHOT_BYTE_ORDER_MARK;
+  header.size = (uint64_t)writer->size;
+  *WRITER_AT(writer, header_offset, snapshot_header_t) = header;
+  return true;
+}
+
+///
+/// Write a snapshot to a temporary file next to `file_path` and rename it over `file_path`.
+/// Snapshots are mapped by their readers, truncating one in place would fault any of them
+/// touching pages past the new end.
+///
+static bool write_snapshot_file(
+  const char * file_path,
+  const void * data,
+  size_t size,
+  rcutils_allocator_t allocator)
+{
+  char * temp_path = rcutils_format_string(allocator, "%s.XXXXXX", file_path);
+  if (NULL == temp_path) {
+    RCUTILS_SET_ERROR_MSG("Error allocating memory");
+    return false;
+  }
+  FILE * file = NULL;
+#ifndef _WIN32
+  int fd = mkstemp(temp_path);
+  if (fd >= 0) {
+    // mkstemp() only lets the owner read the file
+    if (0 != fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH) ||
+      NULL == (file = fdopen(fd, "wb")))
+    {
+      close(fd);
+      remove(temp_path);
+    }
+  }
+#else
+  if (0 == _mktemp_s(temp_path, strlen(temp_path) + 1U)) {
+    file = fopen(temp_path, "wb");
+  }
+#endif
+  if (NULL == file) {
+    RCUTILS_SET_ERROR_MSG("Error opening snapshot file");
+    allocator.deallocate(temp_path, allocator.state);
+    return false;
+  }
+  bool ret = size == fwrite(data, 1U, size, file);
+  ret = 0 == fclose(file) && ret;
+  if (ret) {
+#ifndef _WIN32
+    ret = 0 == rename(temp_path, file_path);
+#else
+    ret = 0 != MoveFileExA(temp_path, file_path, MOVEFILE_REPLACE_EXISTING);
+#endif
+  }
+  if (!ret) {
+    remove(temp_path);
+    RCUTILS_SET_ERROR_MSG("Error writing snapshot file");
+  }
+  allocator.deallocate(temp_path, allocator.state);
+  return ret;
+}
+
+bool rcl_yaml_node_struct_write_snapshot(
+  const rcl_params_t * params_st,
+  const char * file_path)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(params_st, false);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(file_path, false);
+
+  snapshot_writer_t writer;
+  memset(&writer, 0, sizeof(writer));
+  writer.allocator = NULL != params_st->arena ?
+    arena_get_block_allocator(params_st->arena) : params_st->allocator;
+  writer.string_index = name_index_get_zero_initialized();
+
+  bool ret = writer_add_params(&writer, params_st);
+  if (!ret) {
+    RCUTILS_SET_ERROR_MSG("Error serializing parameters");
+  } else {
+    ret = write_snapshot_file(file_path, writer.data, writer.size, writer.allocator);
+  }
+
+  if (NULL != writer.data) {
+    writer.allocator.deallocate(writer.data, writer.allocator.state);
+  }
+  if (NULL != writer.strings) {
+    writer.allocator.deallocate(writer.strings, writer.allocator.state);
+  }
+  name_index_fini(&writer.string_index, writer.allocator);
+  return ret;
+}
+
+///
+/// Snapshot being loaded
+///
+typedef struct snapshot_s
+{
+  unsigned char * data;
+  size_t size;
+  const snapshot_header_t * header;
+  const uint64_t * string_offsets;
+} snapshot_t;
+
+///
+/// Get `count` elements of `element_size` bytes at an offset, NULL if they are not all
+/// in the snapshot
+///
+static void * snapshot_get(
+  const snapshot_t * snapshot,
+  uint64_t offset,
+  uint64_t count,
+  size_t element_size)
+{
+  if (0U != offset % SNAPSHOT_ALIGNMENT || offset > snapshot->size ||
+    count > (snapshot->size - offset) / element_size)
+  {
+    return NULL;
+  }
+  return snapshot->data + offset;
+}
+
+static char * snapshot_get_string(const snapshot_t * snapshot, uint64_t id)
+{
+  if (id >= snapshot->header->num_strings) {
+    return NULL;
+  }
+  const uint64_t offset = snapshot->string_offsets[id];
+  // The string table ends with a null character, so every string in it is terminated
+  if (offset < snapshot->header->strings ||
+    offset - snapshot->header->strings >= snapshot->header->strings_size)
+  {
+    return NULL;
+  }
+  return (char *)snapshot->data + offset;
+}
+
+///
+/// Use the slots of a name index of a snapshot in place, once checked
+///
+static bool snapshot_get_index(
+  const snapshot_t * snapshot,
+  uint64_t offset,
+  uint64_t capacity,
+  size_t num_names,
+  rcl_yaml_name_index_t * index)
+{
+  *index = name_index_get_zero_initialized();
+  if (0U == capacity) {
+    return 0U == num_names;
+  }
+  uint64_t * slots = snapshot_get(snapshot, offset, capacity, sizeof(uint64_t));
+  if (NULL == slots || 0U != (capacity & (capacity - 1U))) {
+    return false;
+  }
+  // Lookups probe until an empty slot, and expect indexes of existing names
+  size_t num_used_slots = 0U;
+  for (uint64_t slot = 0U; slot < capacity; ++slot) {
+    if (slots[slot] > num_names) {
+      return false;
+    }
+    if (0U != slots[slot]) {
+      num_used_slots++;
+    }
+  }
+  if (num_used_slots != num_names || num_used_slots > capacity / 2U) {
+    return false;
+  }
+  if (sizeof(size_t) == sizeof(uint64_t)) {
+    index->slots = (size_t *)(void *)slots;
+    index->capacity = (size_t)capacity;
+    index->size = num_names;
+  }
+  // Otherwise the index is built on the first lookup
+  return true;
+}
+
+#define SNAPSHOT_GET_ARRAY(snapshot, param, dest_array, var_array_type, allocator) \
+  do { \
+    dest_array = allocator.allocate(sizeof(var_array_type), allocator.state); \
+    if (NULL == dest_array) { \
+      return false; \
+    } \
+    dest_array->values = NULL; \
+    dest_array->size = (size_t)param->size; \
+    if (0U != param->size) { \
+      dest_array->values = snapshot_get( \
+        snapshot, param->value.reference, param->size, sizeof(*dest_array->values)); \
+      if (NULL == dest_array->values) { \
+        return false; \
+      } \
+    } \
+  } while (0)
+
+///
+/// Point a parameter value at its value in a snapshot
+///
+static bool snapshot_get_value(
+  const snapshot_t * snapshot,
+  snapshot_param_t * param,
+  rcl_variant_t * value,
+  const rcutils_allocator_t allocator)
+{
+  switch (param->type) {
+    case SNAPSHOT_TYPE_NONE:
+      return true;
+    case SNAPSHOT_TYPE_BOOL:
+      {
+        unsigned char byte;
+        memcpy(&byte, &param->value.boolean, 1U);
+        if (byte > 1U) {
+          return false;
+        }
+        value->bool_value = &param->value.boolean;
+      }
+      return true;
+    case SNAPSHOT_TYPE_INTEGER:
+      value->integer_value = &param->value.integer;
+      return true;
+    case SNAPSHOT_TYPE_DOUBLE:
+      value->double_value = &param->value.floating;
+      return true;
+    case SNAPSHOT_TYPE_STRING:
+      value->string_value = snapshot_get_string(snapshot, param->value.reference);
+      return NULL != value->string_value;
+    case SNAPSHOT_TYPE_BYTE_ARRAY:
+      SNAPSHOT_GET_ARRAY(snapshot, param, value->byte_array_value, rcl_byte_array_t, allocator);
+      return true;
+    case SNAPSHOT_TYPE_BOOL_ARRAY:
+      SNAPSHOT_GET_ARRAY(snapshot, param, value->bool_array_value, rcl_bool_array_t, allocator);
+      for (size_t i = 0U; i < value->bool_array_value->size; ++i) {
+        unsigned char byte;
+        memcpy(&byte, &value->bool_array_value->values[i], 1U);
+        if (byte > 1U) {
+          return false;
+        }
+      }
+      return true;
+    case SNAPSHOT_TYPE_INTEGER_ARRAY:
+      SNAPSHOT_GET_ARRAY(
+        snapshot, param, value->integer_array_value, rcl_int64_array_t, allocator);
+      return true;
+    case SNAPSHOT_TYPE_DOUBLE_ARRAY:
+      SNAPSHOT_GET_ARRAY(
+        snapshot, param, value->double_array_value, rcl_double_array_t, allocator);
+      return true;
+    case SNAPSHOT_TYPE_STRING_ARRAY:
+      {
+        const uint64_t * ids = snapshot_get(
+          snapshot, param->value.reference, param->size, sizeof(uint64_t));
+        if (NULL == ids) {
+          return false;
+        }
+        rcutils_string_array_t * array =
+          allocator.allocate(sizeof(rcutils_string_array_t), allocator.state);
+        if (NULL == array) {
+          return false;
+        }
+        *array = rcutils_get_zero_initialized_string_array();
+        array->allocator = allocator;
+        value->string_array_value = array;
+        if (0U != param->size) {
+          array->data = allocator.zero_allocate(
+            (size_t)param->size, sizeof(char *), allocator.state);
+          if (NULL == array->data) {
+            return false;
+          }
+        }
+        array->size = (size_t)param->size;
+        for (size_t i = 0U; i < array->size; ++i) {
+          array->data[i] = snapshot_get_string(snapshot, ids[i]);
+          if (NULL == array->data[i]) {
+            return false;
+          }
+        }
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+///
+/// Build the parameters of a node from a snapshot
+///
+static bool snapshot_get_node(
+  const snapshot_t * snapshot,
+  const snapshot_node_t * node,
+  rcl_node_params_t * node_params,
+  const rcutils_allocator_t allocator)
+{
+  snapshot_param_t * params = snapshot_get(
+    snapshot, node->params, node->num_params, sizeof(snapshot_param_t));
+  if (NULL == params) {
+    return false;
+  }
+  const size_t num_params = (size_t)node->num_params;
+  if (RCUTILS_RET_OK != node_params_init_with_capacity(
+      node_params, 0U == num_params ? 1U : num_params, allocator))
+  {
+    return false;
+  }
+  for (size_t param_idx = 0U; param_idx < num_params; ++param_idx) {
+    node_params->parameter_names[param_idx] = snapshot_get_string(
+      snapshot, params[param_idx].name);
+    if (NULL == node_params->parameter_names[param_idx] ||
+      !snapshot_get_value(
+        snapshot, &params[param_idx], &node_params->parameter_values[param_idx], allocator))
+    {
+      return false;
+    }
+    node_params->num_params++;
+  }
+  return snapshot_get_index(
+    snapshot, node->index, node->index_capacity, num_params, &node_params->parameter_index);
+}
+
+///
+/// Build a parameter structure from a snapshot
+///
+static bool snapshot_get_params(const snapshot_t * snapshot, rcl_params_t * params_st)
+{
+  const snapshot_header_t * header = snapshot->header;
+  const snapshot_node_t * nodes = snapshot_get(
+    snapshot, header->nodes, header->num_nodes, sizeof(snapshot_node_t));
+  if (NULL == nodes) {
+    return false;
+  }
+  const size_t num_nodes = (size_t)header->num_nodes;
+  if (RCUTILS_RET_OK != rcl_yaml_node_struct_reallocate(
+      params_st, 0U == num_nodes ? 1U : num_nodes, params_st->allocator))
+  {
+    return false;
+  }
+  for (size_t node_idx = 0U; node_idx < num_nodes; ++node_idx) {
+    params_st->node_names[node_idx] = snapshot_get_string(snapshot, nodes[node_idx].name);
+    if (NULL == params_st->node_names[node_idx] ||
+      !snapshot_get_node(
+        snapshot, &nodes[node_idx], &params_st->params[node_idx], params_st->allocator))
+    {
+      return false;
+    }
+    params_st->num_nodes++;
+  }
+  return snapshot_get_index(
+    snapshot, header->node_index, header->node_index_capacity, num_nodes,
+    &params_st->node_index);
+}
+
+#ifndef _WIN32
+static void unmap_snapshot(void * data, size_t size)
+{
+  munmap(data, size);
+}
+#endif
+
+///
+/// Map a snapshot file in memory until the arena is finalized
+///
+static unsigned char * map_snapshot(
+  const char * file_path,
+  rcl_yaml_arena_t * arena,
+  size_t * size)
+{
+#ifndef _WIN32
+  int fd = open(file_path, O_RDONLY);
+  if (fd < 0) {
+    return NULL;
+  }
+  struct stat file_stat;
+  if (0 != fstat(fd, &file_stat) || file_stat.st_size <= 0) {
+    close(fd);
+    return NULL;
+  }
+  *size = (size_t)file_stat.st_size;
+  // Private writable pages let parameters be modified as usual, without touching the file
+  void * data = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (MAP_FAILED == data) {
+    return NULL;
+  }
+  arena_set_fini_callback(arena, unmap_snapshot, data, *size);
+  return data;
+#else
+  FILE * file = fopen(file_path, "rb");
+  if (NULL == file) {
+    return NULL;
+  }
+  unsigned char * data = NULL;
+  long file_size = 0;
+  if (0 == fseek(file, 0, SEEK_END) && (file_size = ftell(file)) > 0 &&
+    0 == fseek(file, 0, SEEK_SET))
+  {
+    rcutils_allocator_t allocator = arena_get_allocator(arena);
+    *size = (size_t)file_size;
+    data = allocator.allocate(*size, allocator.state);
+    if (NULL != data && *size != fread(data, 1U, *size, file)) {
+      data = NULL;
+    }
+  }
+  fclose(file);
+  return data;
+#endif
+}
+
+rcl_params_t * rcl_yaml_node_struct_load_snapshot(
+  const char * file_path,
+  const rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(file_path, NULL);
+  rcl_params_t * params_st = rcl_yaml_node_struct_init_with_arena(allocator);
+  if (NULL == params_st) {
+    return NULL;
+  }
+
+  snapshot_t snapshot;
+  snapshot.data = map_snapshot(file_path, params_st->arena, &snapshot.size);
+  if (NULL == snapshot.data) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("Error reading snapshot file %s", file_path);
+    rcl_yaml_node_struct_fini(params_st);
+    return NULL;
+  }
+  snapshot.header = snapshot_get(&snapshot, 0U, 1U, sizeof(snapshot_header_t));
+  if (NULL == snapshot.header ||
+    0 != memcmp(snapshot.header->magic, SNAPSHOT_MAGIC, sizeof(snapshot.header->magic)) ||
+    SNAPSHOT_VERSION != snapshot.header->version ||
+    SNAPSHOT_BYTE_ORDER_MARK != snapshot.header->byte_order ||
+    snapshot.size != snapshot.header->size)
+  {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "%s is not a parameter snapshot of this version and byte order", file_path);
+    rcl_yaml_node_struct_fini(params_st);
+    return NULL;
+  }
+  snapshot.string_offsets = snapshot_get(
+    &snapshot, snapshot.header->string_offsets, snapshot.header->num_strings, sizeof(uint64_t));
+  const char * strings = snapshot_get(
+    &snapshot, snapshot.header->strings, snapshot.header->strings_size, sizeof(char));
+  if (NULL == snapshot.string_offsets || NULL == strings ||
+    (0U != snapshot.header->strings_size &&
+    '\0' != strings[snapshot.header->strings_size - 1U]) ||
+    !snapshot_get_params(&snapshot, params_st))
+  {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("Parameter snapshot %s is corrupted", file_path);
+    rcl_yaml_node_struct_fini(params_st);
+    return NULL;
+  }
+  return params_st;
+}
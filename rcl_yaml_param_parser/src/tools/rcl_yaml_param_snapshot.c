@@ -0,0 +1,52 @@
+// Copyright 2023 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compile parameter files into a snapshot to be loaded with rcl_yaml_node_struct_load_snapshot()
+
+#include <stdio.h>
+
+#include "rcl_yaml_param_parser/parser.h"
+#include "rcl_yaml_param_parser/types.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+
+int main(int argc, char ** argv)
+{
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s OUTPUT_FILE PARAMS_FILE...\n", argv[0]);
+    fprintf(stderr, "Parameters of later files override those of earlier ones.\n");
+    return 2;
+  }
+
+  rcl_params_t * params_st = rcl_yaml_node_struct_init_with_arena(
+    rcutils_get_default_allocator());
+  if (NULL == params_st) {
+    fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+    return 1;
+  }
+  int ret = 0;
+  for (int i = 2; i < argc && 0 == ret; ++i) {
+    if (!rcl_parse_yaml_file(argv[i], params_st)) {
+      fprintf(stderr, "Error parsing %s: %s\n", argv[i], rcutils_get_error_string().str);
+      ret = 1;
+    }
+  }
+  if (0 == ret && !rcl_yaml_node_struct_write_snapshot(params_st, argv[1])) {
+    fprintf(stderr, "Error writing %s: %s\n", argv[1], rcutils_get_error_string().str);
+    ret = 1;
+  }
+  rcl_yaml_node_struct_fini(params_st);
+  return ret;
+}
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <string.h>
+
 #include "rcutils/allocator.h"
 #include "rcutils/error_handling.h"
 #include "rcutils/strdup.h"
@@ -60,6 +62,13 @@
     dest_array->size = src_array->size; \
   } while (0)
 
+#define RCL_YAML_VARIANT_ARRAYS_EQUAL(lhs_array, rhs_array) \
+  (NULL != (rhs_array) && (lhs_array)->size == (rhs_array)->size && \
+  (0U == (lhs_array)->size || \
+  0 == memcmp( \
+    (lhs_array)->values, (rhs_array)->values, \
+    sizeof(*(lhs_array)->values) * (lhs_array)->size)))
+
 void rcl_yaml_variant_fini(
   rcl_variant_t * param_var,
   const rcutils_allocator_t allocator)
@@ -71,45 +80,98 @@ void rcl_yaml_variant_fini(
   if (NULL != param_var->bool_value) {
     allocator.deallocate(param_var->bool_value, allocator.state);
     param_var->bool_value = NULL;
-  } else if (NULL != param_var->integer_value) {
+  }
+  if (NULL != param_var->integer_value) {
     allocator.deallocate(param_var->integer_value, allocator.state);
     param_var->integer_value = NULL;
-  } else if (NULL != param_var->double_value) {
+  }
+  if (NULL != param_var->double_value) {
     allocator.deallocate(param_var->double_value, allocator.state);
     param_var->double_value = NULL;
-  } else if (NULL != param_var->string_value) {
+  }
+  if (NULL != param_var->string_value) {
     allocator.deallocate(param_var->string_value, allocator.state);
     param_var->string_value = NULL;
-  } else if (NULL != param_var->bool_array_value) {
+  }
+  if (NULL != param_var->bool_array_value) {
     if (NULL != param_var->bool_array_value->values) {
       allocator.deallocate(param_var->bool_array_value->values, allocator.state);
     }
     allocator.deallocate(param_var->bool_array_value, allocator.state);
     param_var->bool_array_value = NULL;
-  } else if (NULL != param_var->integer_array_value) {
+  }
+  if (NULL != param_var->integer_array_value) {
     if (NULL != param_var->integer_array_value->values) {
       allocator.deallocate(param_var->integer_array_value->values, allocator.state);
     }
     allocator.deallocate(param_var->integer_array_value, allocator.state);
     param_var->integer_array_value = NULL;
-  } else if (NULL != param_var->double_array_value) {
+  }
+  if (NULL != param_var->double_array_value) {
     if (NULL != param_var->double_array_value->values) {
       allocator.deallocate(param_var->double_array_value->values, allocator.state);
     }
     allocator.deallocate(param_var->double_array_value, allocator.state);
     param_var->double_array_value = NULL;
-  } else if (NULL != param_var->string_array_value) {
+  }
+  if (NULL != param_var->string_array_value) {
     if (RCUTILS_RET_OK != rcutils_string_array_fini(param_var->string_array_value)) {
       // Log and continue ...
       RCUTILS_SAFE_FWRITE_TO_STDERR("Error deallocating string array");
     }
     allocator.deallocate(param_var->string_array_value, allocator.state);
     param_var->string_array_value = NULL;
-  } else {
-    /// Nothing to do to keep pclint happy
   }
 }
 
+bool rcl_yaml_variant_is_empty(const rcl_variant_t * param_var)
+{
+  if (NULL != param_var->bool_value || NULL != param_var->integer_value ||
+    NULL != param_var->double_value || NULL != param_var->string_value ||
+    NULL != param_var->byte_array_value || NULL != param_var->bool_array_value ||
+    NULL != param_var->integer_array_value || NULL != param_var->double_array_value ||
+    NULL != param_var->string_array_value)
+  {
+    return false;
+  }
+  return true;
+}
+
+bool rcl_yaml_variant_equal(const rcl_variant_t * lhs, const rcl_variant_t * rhs)
+{
+  if (NULL != lhs->bool_value) {
+    return NULL != rhs->bool_value && *lhs->bool_value == *rhs->bool_value;
+  } else if (NULL != lhs->integer_value) {
+    return NULL != rhs->integer_value && *lhs->integer_value == *rhs->integer_value;
+  } else if (NULL != lhs->double_value) {
+    return NULL != rhs->double_value &&
+           0 == memcmp(lhs->double_value, rhs->double_value, sizeof(double));
+  } else if (NULL != lhs->string_value) {
+    return NULL != rhs->string_value && 0 == strcmp(lhs->string_value, rhs->string_value);
+  } else if (NULL != lhs->byte_array_value) {
+    return RCL_YAML_VARIANT_ARRAYS_EQUAL(lhs->byte_array_value, rhs->byte_array_value);
+  } else if (NULL != lhs->bool_array_value) {
+    return RCL_YAML_VARIANT_ARRAYS_EQUAL(lhs->bool_array_value, rhs->bool_array_value);
+  } else if (NULL != lhs->integer_array_value) {
+    return RCL_YAML_VARIANT_ARRAYS_EQUAL(lhs->integer_array_value, rhs->integer_array_value);
+  } else if (NULL != lhs->double_array_value) {
+    return RCL_YAML_VARIANT_ARRAYS_EQUAL(lhs->double_array_value, rhs->double_array_value);
+  } else if (NULL != lhs->string_array_value) {
+    const rcutils_string_array_t * lhs_array = lhs->string_array_value;
+    const rcutils_string_array_t * rhs_array = rhs->string_array_value;
+    if (NULL == rhs_array || lhs_array->size != rhs_array->size) {
+      return false;
+    }
+    for (size_t str_idx = 0U; str_idx < lhs_array->size; ++str_idx) {
+      if (0 != strcmp(lhs_array->data[str_idx], rhs_array->data[str_idx])) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return rcl_yaml_variant_is_empty(rhs);
+}
+
 bool rcl_yaml_variant_copy(
   rcl_variant_t * out_param_var, const rcl_variant_t * param_var, rcutils_allocator_t allocator)
 {
@@ -155,7 +217,7 @@ bool rcl_yaml_variant_copy(
     rcutils_ret_t ret = rcutils_string_array_init(
       out_param_var->string_array_value,
       param_var->string_array_value->size,
-      &(param_var->string_array_value->allocator));
+      &allocator);
     if (RCUTILS_RET_OK != ret) {
       if (RCUTILS_RET_BAD_ALLOC == ret) {
         RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem for string array\n");
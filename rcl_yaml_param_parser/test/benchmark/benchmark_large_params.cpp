@@ -0,0 +1,366 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcl_yaml_param_parser/parser.h"
+
+#include "rcpputils/filesystem_helper.hpp"
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+// Roughly the parameters of a large robot brought up by a single launch file
+constexpr size_t kNumNodes = 2000U;
+constexpr size_t kNumNamespaces = 50U;
+constexpr size_t kNamespaceDepth = 6U;
+constexpr size_t kNumWildcardSections = 200U;
+constexpr size_t kArraySize = 256U;
+constexpr size_t kNumOverrideFiles = 4U;
+
+std::string indent(size_t depth)
+{
+  return std::string(2U * depth, ' ');
+}
+
+std::string namespace_path(size_t node_idx)
+{
+  std::string path;
+  for (size_t depth = 0U; depth < kNamespaceDepth; ++depth) {
+    path += "/ns" + std::to_string(depth) + "_" +
+      std::to_string((node_idx + depth) % kNumNamespaces);
+  }
+  return path;
+}
+
+std::string array_of(size_t size, const std::string & prefix, const std::string & suffix)
+{
+  std::string array = "[";
+  for (size_t i = 0U; i < size; ++i) {
+    if (0U != i) {
+      array += ", ";
+    }
+    array += prefix + std::to_string(i) + suffix;
+  }
+  return array + "]";
+}
+
+void write_node_parameters(std::ofstream & out, size_t node_idx, size_t depth)
+{
+  const std::string pad = indent(depth);
+  out << pad << "ros__parameters:\n" <<
+    pad << "  use_sim_time: false\n" <<
+    pad << "  id: " << node_idx << "\n" <<
+    pad << "  rate: " << node_idx << ".25\n" <<
+    pad << "  frame_id: \"frame_" << node_idx << "\"\n" <<
+    pad << "  qos:\n" <<
+    pad << "    depth: 10\n" <<
+    pad << "    reliability: reliable\n" <<
+    pad << "    deadline:\n" <<
+    pad << "      sec: 1\n" <<
+    pad << "      nsec: 500000\n" <<
+    pad << "  topics: [\"in_" << node_idx << "\", \"out_" << node_idx << "\"]\n" <<
+    pad << "  enabled_sensors: [true, false, true, true]\n";
+  // Only some nodes carry long arrays, e.g. calibration tables and covariances
+  if (0U == node_idx % 10U) {
+    out << pad << "  calibration: " << array_of(kArraySize, "", ".5") << "\n" <<
+      pad << "  channels: " << array_of(kArraySize, "", "") << "\n" <<
+      pad << "  joint_names: " << array_of(kArraySize / 4U, "joint_", "") << "\n";
+  }
+}
+
+// Half of the nodes are nested by namespace, the other half use fully qualified keys.
+// Returns the indentation of the node's parameters.
+size_t write_node_key(std::ofstream & out, size_t node_idx)
+{
+  const std::string node_name = "node_" + std::to_string(node_idx);
+  if (0U != node_idx % 2U) {
+    out << namespace_path(node_idx) << "/" << node_name << ":\n";
+    return 1U;
+  }
+  size_t depth = 0U;
+  for (; depth < kNamespaceDepth; ++depth) {
+    out << indent(depth) << "ns" << depth << "_" << (node_idx + depth) % kNumNamespaces << ":\n";
+  }
+  out << indent(depth) << node_name << ":\n";
+  return depth + 1U;
+}
+
+void write_wildcard_section(std::ofstream & out, size_t section_idx)
+{
+  switch (section_idx % 4U) {
+    case 0U:
+      out << "/**:\n";
+      break;
+    case 1U:
+      out << "/ns0_" << section_idx % kNumNamespaces << "/**:\n";
+      break;
+    case 2U:
+      out << "/ns0_" << section_idx % kNumNamespaces << "/*/node_" << section_idx << ":\n";
+      break;
+    default:
+      out << "/**/node_" << section_idx << ":\n";
+      break;
+  }
+  out << "  ros__parameters:\n" <<
+    "    wildcard_" << section_idx << ": " << section_idx << "\n" <<
+    "    log_level: \"info\"\n";
+}
+
+// Later launch files typically override a fraction of the parameters of the first one
+void write_override_file(std::ofstream & out, size_t file_idx)
+{
+  for (size_t node_idx = file_idx; node_idx < kNumNodes; node_idx += 8U) {
+    const std::string pad = indent(write_node_key(out, node_idx));
+    out << pad << "ros__parameters:\n" <<
+      pad << "  rate: " << file_idx << ".5\n" <<
+      pad << "  override_" << file_idx << ": true\n";
+  }
+}
+
+class LargeParamFiles
+{
+public:
+  LargeParamFiles()
+  : dir_(rcpputils::fs::temp_directory_path() / "rcl_yaml_param_parser_benchmark")
+  {
+    rcpputils::fs::create_directories(dir_);
+    std::ofstream nodes_file(add_file("nodes.yaml"));
+    for (size_t node_idx = 0U; node_idx < kNumNodes; ++node_idx) {
+      write_node_parameters(nodes_file, node_idx, write_node_key(nodes_file, node_idx));
+    }
+    std::ofstream wildcards_file(add_file("wildcards.yaml"));
+    for (size_t section_idx = 0U; section_idx < kNumWildcardSections; ++section_idx) {
+      write_wildcard_section(wildcards_file, section_idx);
+    }
+    for (size_t file_idx = 0U; file_idx < kNumOverrideFiles; ++file_idx) {
+      std::ofstream override_file(add_file("overrides_" + std::to_string(file_idx) + ".yaml"));
+      write_override_file(override_file, file_idx);
+    }
+  }
+
+  ~LargeParamFiles()
+  {
+    rcpputils::fs::remove_all(dir_);
+  }
+
+  const char * nodes() const
+  {
+    return paths_[0].c_str();
+  }
+
+  const char * wildcards() const
+  {
+    return paths_[1].c_str();
+  }
+
+  std::vector<const char *> all() const
+  {
+    std::vector<const char *> file_paths;
+    for (const std::string & path : paths_) {
+      file_paths.push_back(path.c_str());
+    }
+    return file_paths;
+  }
+
+private:
+  std::string add_file(const std::string & file_name)
+  {
+    paths_.push_back((dir_ / file_name).string());
+    return paths_.back();
+  }
+
+  rcpputils::fs::path dir_;
+  std::vector<std::string> paths_;
+};
+
+// Generated once, the inputs take a while to write
+const LargeParamFiles & large_param_files()
+{
+  static const LargeParamFiles files;
+  return files;
+}
+
+// The files are parsed one after the other, unless parallel is set. Then they are parsed by
+// rcl_parse_yaml_files(), which uses several threads for large enough files.
+rcl_params_t * parse_files(
+  benchmark::State & st, const std::vector<const char *> & file_paths, bool use_arena,
+  bool parallel)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcl_params_t * params_hdl = use_arena ?
+    rcl_yaml_node_struct_init_with_arena(allocator) : rcl_yaml_node_struct_init(allocator);
+  if (NULL == params_hdl) {
+    st.SkipWithError(rcutils_get_error_string().str);
+    return NULL;
+  }
+  bool res = true;
+  if (parallel) {
+    res = rcl_parse_yaml_files(file_paths.data(), file_paths.size(), params_hdl);
+  } else {
+    for (const char * file_path : file_paths) {
+      res = res && rcl_parse_yaml_file(file_path, params_hdl);
+    }
+  }
+  if (!res) {
+    st.SkipWithError(rcutils_get_error_string().str);
+    rcl_yaml_node_struct_fini(params_hdl);
+    return NULL;
+  }
+  return params_hdl;
+}
+
+void parse_large_files(
+  benchmark::State & st, const std::vector<const char *> & file_paths, bool parallel)
+{
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rcl_params_t * params_hdl = parse_files(st, file_paths, false, parallel);
+    if (NULL == params_hdl) {
+      break;
+    }
+    rcl_yaml_node_struct_fini(params_hdl);
+  }
+}
+}  // namespace
+
+BENCHMARK_F(PerformanceTest, parser_yaml_many_nodes)(benchmark::State & st)
+{
+  std::vector<const char *> file_paths{large_param_files().nodes()};
+  reset_heap_counters();
+  parse_large_files(st, file_paths, false);
+}
+
+BENCHMARK_F(PerformanceTest, parser_yaml_many_nodes_arena)(benchmark::State & st)
+{
+  std::vector<const char *> file_paths{large_param_files().nodes()};
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rcl_params_t * params_hdl = parse_files(st, file_paths, true, false);
+    if (NULL == params_hdl) {
+      break;
+    }
+    rcl_yaml_node_struct_fini(params_hdl);
+  }
+}
+
+BENCHMARK_F(PerformanceTest, parser_yaml_many_wildcards)(benchmark::State & st)
+{
+  std::vector<const char *> file_paths{large_param_files().wildcards()};
+  reset_heap_counters();
+  parse_large_files(st, file_paths, false);
+}
+
+BENCHMARK_F(PerformanceTest, parser_yaml_override_files)(benchmark::State & st)
+{
+  std::vector<const char *> file_paths = large_param_files().all();
+  reset_heap_counters();
+  parse_large_files(st, file_paths, false);
+}
+
+BENCHMARK_F(PerformanceTest, parser_yaml_override_files_parallel)(benchmark::State & st)
+{
+  std::vector<const char *> file_paths = large_param_files().all();
+  reset_heap_counters();
+  parse_large_files(st, file_paths, true);
+}
+
+BENCHMARK_F(PerformanceTest, parser_yaml_lookup_parameters)(benchmark::State & st)
+{
+  rcl_params_t * params_hdl = parse_files(st, large_param_files().all(), false, false);
+  if (NULL == params_hdl) {
+    return;
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(params_hdl);
+  });
+  // Look the parameters up in file order, as a node does when it declares them
+  std::vector<std::pair<std::string, std::string>> names;
+  for (size_t node_idx = 0U; node_idx < params_hdl->num_nodes; ++node_idx) {
+    const rcl_node_params_t & node_params = params_hdl->params[node_idx];
+    for (size_t param_idx = 0U; param_idx < node_params.num_params; ++param_idx) {
+      names.emplace_back(
+        params_hdl->node_names[node_idx], node_params.parameter_names[param_idx]);
+    }
+  }
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    for (const auto & name : names) {
+      const rcl_variant_t * value =
+        rcl_yaml_node_struct_find(name.first.c_str(), name.second.c_str(), params_hdl);
+      if (NULL == value) {
+        st.SkipWithError(("Parameter not found: " + name.second).c_str());
+        break;
+      }
+      benchmark::DoNotOptimize(value);
+    }
+  }
+  st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * names.size()));
+}
+
+static void copy_params(benchmark::State & st, const rcl_params_t * params_hdl)
+{
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rcl_params_t * params_copy = rcl_yaml_node_struct_copy(params_hdl);
+    if (NULL == params_copy) {
+      st.SkipWithError(rcutils_get_error_string().str);
+      break;
+    }
+    rcl_yaml_node_struct_fini(params_copy);
+  }
+}
+
+BENCHMARK_F(PerformanceTest, parser_yaml_copy_params)(benchmark::State & st)
+{
+  rcl_params_t * params_hdl = parse_files(st, large_param_files().all(), false, false);
+  if (NULL == params_hdl) {
+    return;
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(params_hdl);
+  });
+  reset_heap_counters();
+  copy_params(st, params_hdl);
+}
+
+// Structures backed by an arena are always deep-copied
+BENCHMARK_F(PerformanceTest, parser_yaml_copy_params_arena)(benchmark::State & st)
+{
+  rcl_params_t * params_hdl = parse_files(st, large_param_files().all(), true, false);
+  if (NULL == params_hdl) {
+    return;
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(params_hdl);
+  });
+  reset_heap_counters();
+  copy_params(st, params_hdl);
+}
@@ -12,7 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <fstream>
 #include <string>
+#include <vector>
 
 #include "performance_test_fixture/performance_test_fixture.hpp"
 
@@ -43,3 +45,180 @@ BENCHMARK_F(PerformanceTest, parser_yaml_param)(benchmark::State & st)
     rcl_yaml_node_struct_fini(params_hdl);
   }
 }
+
+BENCHMARK_F(PerformanceTest, parser_yaml_param_arena)(benchmark::State & st)
+{
+  std::string path =
+    (rcpputils::fs::current_path() / "test" / "benchmark" / "benchmark_params.yaml").string();
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rcl_params_t * params_hdl =
+      rcl_yaml_node_struct_init_with_arena(rcutils_get_default_allocator());
+    if (NULL == params_hdl) {
+      st.SkipWithError(rcutils_get_error_string().str);
+    }
+    bool res = rcl_parse_yaml_file(path.c_str(), params_hdl);
+    if (!res) {
+      st.SkipWithError(rcutils_get_error_string().str);
+    }
+    rcl_yaml_node_struct_fini(params_hdl);
+  }
+}
+
+// As many files as a launch file typically passes to a process
+constexpr size_t kNumParamFiles = 8U;
+// Enough for the files to hold well over the 64 KiB below which
+// rcl_parse_yaml_files() parses them in turn rather than concurrently
+constexpr size_t kNumNodesPerParamFile = 200U;
+
+// Parameter files of the same nodes, each overriding the values of the previous ones
+class ParamFiles
+{
+public:
+  ParamFiles()
+  : dir_(rcpputils::fs::temp_directory_path() / "rcl_yaml_param_parser_benchmark_files")
+  {
+    rcpputils::fs::create_directories(dir_);
+    for (size_t file_idx = 0U; file_idx < kNumParamFiles; ++file_idx) {
+      paths_.push_back((dir_ / ("params_" + std::to_string(file_idx) + ".yaml")).string());
+      std::ofstream out(paths_.back());
+      for (size_t node_idx = 0U; node_idx < kNumNodesPerParamFile; ++node_idx) {
+        out << "/ns_" << node_idx % 10U << "/node_" << node_idx << ":\n" <<
+          "  ros__parameters:\n" <<
+          "    rate: " << file_idx << "." << node_idx << "\n" <<
+          "    frame_id: \"frame_" << node_idx << "_" << file_idx << "\"\n" <<
+          "    qos:\n" <<
+          "      depth: " << file_idx + node_idx << "\n" <<
+          "      reliability: reliable\n" <<
+          "    gains: [" << file_idx << ".0, 0.5, 0.25]\n" <<
+          "    file_" << file_idx << ": true\n";
+      }
+    }
+  }
+
+  ~ParamFiles()
+  {
+    rcpputils::fs::remove_all(dir_);
+  }
+
+  std::vector<const char *> paths() const
+  {
+    std::vector<const char *> file_paths;
+    for (const std::string & path : paths_) {
+      file_paths.push_back(path.c_str());
+    }
+    return file_paths;
+  }
+
+private:
+  rcpputils::fs::path dir_;
+  std::vector<std::string> paths_;
+};
+
+// Generated once, outside of the measured heap allocations
+static const ParamFiles & param_files()
+{
+  static const ParamFiles files;
+  return files;
+}
+
+static void parse_param_files(
+  benchmark::State & st, const std::vector<const char *> & file_paths, bool parallel)
+{
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rcl_params_t * params_hdl = rcl_yaml_node_struct_init(rcutils_get_default_allocator());
+    if (NULL == params_hdl) {
+      st.SkipWithError(rcutils_get_error_string().str);
+    }
+    bool res = true;
+    if (parallel) {
+      res = rcl_parse_yaml_files(file_paths.data(), file_paths.size(), params_hdl);
+    } else {
+      for (const char * file_path : file_paths) {
+        res = res && rcl_parse_yaml_file(file_path, params_hdl);
+      }
+    }
+    if (!res) {
+      st.SkipWithError(rcutils_get_error_string().str);
+    }
+    rcl_yaml_node_struct_fini(params_hdl);
+  }
+}
+
+BENCHMARK_F(PerformanceTest, parser_yaml_param_files_sequential)(benchmark::State & st)
+{
+  const std::vector<const char *> file_paths = param_files().paths();
+  reset_heap_counters();
+  parse_param_files(st, file_paths, false);
+}
+
+BENCHMARK_F(PerformanceTest, parser_yaml_param_files_parallel)(benchmark::State & st)
+{
+  const std::vector<const char *> file_paths = param_files().paths();
+  reset_heap_counters();
+  parse_param_files(st, file_paths, true);
+}
+
+constexpr size_t kSequenceSize = 10000U;
+
+static std::string make_sequence(const std::string & prefix, const std::string & suffix)
+{
+  std::string sequence = "[";
+  for (size_t i = 0U; i < kSequenceSize; ++i) {
+    if (0U != i) {
+      sequence += ", ";
+    }
+    sequence += prefix + std::to_string(i) + suffix;
+  }
+  return sequence + "]";
+}
+
+static void parse_sequence(benchmark::State & st, const std::string & sequence)
+{
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rcl_params_t * params_hdl = rcl_yaml_node_struct_init(rcutils_get_default_allocator());
+    if (NULL == params_hdl) {
+      st.SkipWithError(rcutils_get_error_string().str);
+    }
+    bool res = rcl_parse_yaml_value("node", "param", sequence.c_str(), params_hdl);
+    if (!res) {
+      st.SkipWithError(rcutils_get_error_string().str);
+    }
+    rcl_yaml_node_struct_fini(params_hdl);
+  }
+}
+
+BENCHMARK_F(PerformanceTest, parser_yaml_large_bool_array)(benchmark::State & st)
+{
+  std::string sequence = "[";
+  for (size_t i = 0U; i < kSequenceSize; ++i) {
+    sequence += 0U == i ? "true" : ", false";
+  }
+  sequence += "]";
+  reset_heap_counters();
+  parse_sequence(st, sequence);
+}
+
+BENCHMARK_F(PerformanceTest, parser_yaml_large_integer_array)(benchmark::State & st)
+{
+  std::string sequence = make_sequence("", "");
+  reset_heap_counters();
+  parse_sequence(st, sequence);
+}
+
+BENCHMARK_F(PerformanceTest, parser_yaml_large_double_array)(benchmark::State & st)
+{
+  std::string sequence = make_sequence("", ".5");
+  reset_heap_counters();
+  parse_sequence(st, sequence);
+}
+
+BENCHMARK_F(PerformanceTest, parser_yaml_large_string_array)(benchmark::State & st)
+{
+  std::string sequence = make_sequence("value_", "");
+  reset_heap_counters();
+  parse_sequence(st, sequence);
+}
@@ -15,7 +15,11 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <string>
+#include <system_error>
+#include <tuple>
 #include <vector>
 
 #include "osrf_testing_tools_cpp/scope_exit.hpp"
@@ -603,6 +607,74 @@ TEST(test_file_parser, wildcards) {
   EXPECT_TRUE(res) << rcutils_get_error_string().str;
 }
 
+TEST(test_file_parser, wildcards_for_nodes) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  ASSERT_TRUE(NULL != test_path) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    allocator.deallocate(test_path, allocator.state);
+  });
+  char * path = rcutils_join_path(test_path, "wildcards.yaml", allocator);
+  ASSERT_TRUE(NULL != path) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    allocator.deallocate(path, allocator.state);
+  });
+  EXPECT_TRUE(rcutils_exists(path));
+
+  struct
+  {
+    std::vector<const char *> node_names;
+    std::vector<std::string> expected_node_names;
+  } cases[] = {
+    {{}, {}},
+    {{"/some_node1"}, {"/**", "/*", "/**/some_node1"}},
+    {{"/ns/some_node3"}, {"/**", "/**/some_node3"}},
+    {{"/foo1"}, {"/**", "/*", "/foo1/**"}},
+    {{"/foo2/some_node6", "/foo4/x/some_node6", "/foo5/any"},
+      {"/**", "/foo2/*", "/foo4/*/some_node6", "/foo5/*"}},
+    {{"/foo10/a/b/bar/bar1/bar2/c/d"}, {"/**", "/foo10/**/bar/bar1/bar2/**"}},
+    {{"/foo11/a/bar/bar1/bar2/c"}, {"/**", "/foo11/*/bar/bar1/bar2/*"}},
+  };
+  for (const auto & test_case : cases) {
+    rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+    ASSERT_TRUE(NULL != params_hdl) << rcutils_get_error_string().str;
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      rcl_yaml_node_struct_fini(params_hdl);
+    });
+    bool res = rcl_parse_yaml_file_for_nodes(
+      path, test_case.node_names.data(), test_case.node_names.size(), params_hdl);
+    ASSERT_TRUE(res) << rcutils_get_error_string().str;
+    std::vector<std::string> node_names(
+      params_hdl->node_names, params_hdl->node_names + params_hdl->num_nodes);
+    EXPECT_EQ(test_case.expected_node_names, node_names);
+    for (size_t node_idx = 0U; node_idx < params_hdl->num_nodes; ++node_idx) {
+      rcl_variant_t * param_value = rcl_yaml_node_struct_get(
+        params_hdl->node_names[node_idx], "id", params_hdl);
+      ASSERT_TRUE(NULL != param_value);
+      ASSERT_TRUE(NULL != param_value->integer_value);
+      EXPECT_EQ(10, *param_value->integer_value);
+    }
+  }
+
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  ASSERT_TRUE(NULL != params_hdl) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(params_hdl);
+  });
+  const char * node_names[] = {"/some_node1", nullptr};
+  EXPECT_FALSE(rcl_parse_yaml_file_for_nodes(path, nullptr, 1U, params_hdl));
+  rcutils_reset_error();
+  EXPECT_FALSE(rcl_parse_yaml_file_for_nodes(path, node_names, 2U, params_hdl));
+  rcutils_reset_error();
+  EXPECT_EQ(0U, params_hdl->num_nodes);
+}
+
 TEST(test_file_parser, wildcards_node_slash) {
   rcutils_reset_error();
   EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
@@ -674,6 +746,393 @@ TEST(test_file_parser, wildcards_partial) {
   }
 }
 
+static void expect_same_double(double expected, double value)
+{
+  if (std::isnan(expected)) {
+    EXPECT_TRUE(std::isnan(value));
+  } else {
+    EXPECT_EQ(expected, value);
+  }
+}
+
+// Check that two parameter structures hold the same nodes, parameters and values, in order
+static void expect_same_params_in_order(const rcl_params_t * expected, const rcl_params_t * params)
+{
+  ASSERT_EQ(expected->num_nodes, params->num_nodes);
+  for (size_t node_idx = 0U; node_idx < expected->num_nodes; ++node_idx) {
+    EXPECT_STREQ(expected->node_names[node_idx], params->node_names[node_idx]);
+    const rcl_node_params_t * expected_node = &expected->params[node_idx];
+    const rcl_node_params_t * node = &params->params[node_idx];
+    ASSERT_EQ(expected_node->num_params, node->num_params);
+    for (size_t param_idx = 0U; param_idx < expected_node->num_params; ++param_idx) {
+      EXPECT_STREQ(
+        expected_node->parameter_names[param_idx], node->parameter_names[param_idx]);
+      const rcl_variant_t & expected_value = expected_node->parameter_values[param_idx];
+      const rcl_variant_t & value = node->parameter_values[param_idx];
+      ASSERT_EQ(NULL == expected_value.bool_value, NULL == value.bool_value);
+      if (NULL != value.bool_value) {
+        EXPECT_EQ(*expected_value.bool_value, *value.bool_value);
+      }
+      ASSERT_EQ(NULL == expected_value.integer_value, NULL == value.integer_value);
+      if (NULL != value.integer_value) {
+        EXPECT_EQ(*expected_value.integer_value, *value.integer_value);
+      }
+      ASSERT_EQ(NULL == expected_value.double_value, NULL == value.double_value);
+      if (NULL != value.double_value) {
+        expect_same_double(*expected_value.double_value, *value.double_value);
+      }
+      ASSERT_EQ(NULL == expected_value.string_value, NULL == value.string_value);
+      if (NULL != value.string_value) {
+        EXPECT_STREQ(expected_value.string_value, value.string_value);
+      }
+      ASSERT_EQ(NULL == expected_value.bool_array_value, NULL == value.bool_array_value);
+      if (NULL != value.bool_array_value) {
+        ASSERT_EQ(expected_value.bool_array_value->size, value.bool_array_value->size);
+        for (size_t i = 0U; i < value.bool_array_value->size; ++i) {
+          EXPECT_EQ(expected_value.bool_array_value->values[i], value.bool_array_value->values[i]);
+        }
+      }
+      ASSERT_EQ(NULL == expected_value.integer_array_value, NULL == value.integer_array_value);
+      if (NULL != value.integer_array_value) {
+        ASSERT_EQ(expected_value.integer_array_value->size, value.integer_array_value->size);
+        for (size_t i = 0U; i < value.integer_array_value->size; ++i) {
+          EXPECT_EQ(
+            expected_value.integer_array_value->values[i], value.integer_array_value->values[i]);
+        }
+      }
+      ASSERT_EQ(NULL == expected_value.double_array_value, NULL == value.double_array_value);
+      if (NULL != value.double_array_value) {
+        ASSERT_EQ(expected_value.double_array_value->size, value.double_array_value->size);
+        for (size_t i = 0U; i < value.double_array_value->size; ++i) {
+          expect_same_double(
+            expected_value.double_array_value->values[i], value.double_array_value->values[i]);
+        }
+      }
+      ASSERT_EQ(NULL == expected_value.string_array_value, NULL == value.string_array_value);
+      if (NULL != value.string_array_value) {
+        ASSERT_EQ(expected_value.string_array_value->size, value.string_array_value->size);
+        for (size_t i = 0U; i < value.string_array_value->size; ++i) {
+          EXPECT_STREQ(
+            expected_value.string_array_value->data[i], value.string_array_value->data[i]);
+        }
+      }
+    }
+  }
+}
+
+TEST(test_file_parser, parse_files) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  ASSERT_TRUE(NULL != test_path) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    allocator.deallocate(test_path, allocator.state);
+  });
+  const std::vector<std::string> filenames = {
+    "correct_config.yaml",
+    "overlay.yaml",
+    "multi_ns_correct.yaml",
+    "overlay_types.yaml",
+    "root_ns.yaml",
+    "wildcards.yaml",
+    "special_float.yaml",
+    "correct_config.yaml",
+    "overlay_types.yaml",
+  };
+  std::vector<std::string> paths;
+  for (const auto & filename : filenames) {
+    paths.push_back(std::string(test_path) + "/" + filename);
+  }
+  std::vector<const char *> file_paths;
+  for (const auto & path : paths) {
+    file_paths.push_back(path.c_str());
+  }
+
+  rcl_params_t * expected = rcl_yaml_node_struct_init(allocator);
+  ASSERT_TRUE(NULL != expected) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(expected);
+  });
+  ASSERT_TRUE(rcl_parse_yaml_value("camera", "loc", "1.5", expected));
+  for (const char * file_path : file_paths) {
+    ASSERT_TRUE(rcl_parse_yaml_file(file_path, expected)) << rcutils_get_error_string().str;
+  }
+
+  // Overrides replace the whole value of parameters, nested ones included
+  rcl_variant_t * loc = rcl_yaml_node_struct_get("camera", "loc", expected);
+  ASSERT_TRUE(NULL != loc);
+  ASSERT_TRUE(NULL != loc->integer_value);
+  EXPECT_EQ(5, *loc->integer_value);
+  EXPECT_TRUE(NULL == loc->double_value);
+  EXPECT_TRUE(NULL == loc->string_value);
+  rcl_variant_t * angle = rcl_yaml_node_struct_get("camera", "cam_spec.angle", expected);
+  ASSERT_TRUE(NULL != angle);
+  EXPECT_TRUE(NULL == angle->double_value);
+  ASSERT_TRUE(NULL != angle->double_array_value);
+  EXPECT_EQ(2U, angle->double_array_value->size);
+  size_t camera_idx = 0U;
+  while (camera_idx < expected->num_nodes &&
+    std::string("camera") != expected->node_names[camera_idx])
+  {
+    ++camera_idx;
+  }
+  ASSERT_LT(camera_idx, expected->num_nodes);
+  EXPECT_EQ(4U, expected->params[camera_idx].num_params);
+
+  for (size_t num_files = 0U; num_files <= file_paths.size(); num_files += 3U) {
+    rcl_params_t * expected_prefix = rcl_yaml_node_struct_init(allocator);
+    ASSERT_TRUE(NULL != expected_prefix) << rcutils_get_error_string().str;
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      rcl_yaml_node_struct_fini(expected_prefix);
+    });
+    for (size_t i = 0U; i < num_files; ++i) {
+      ASSERT_TRUE(rcl_parse_yaml_file(file_paths[i], expected_prefix));
+    }
+    rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+    ASSERT_TRUE(NULL != params_hdl) << rcutils_get_error_string().str;
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      rcl_yaml_node_struct_fini(params_hdl);
+    });
+    EXPECT_TRUE(rcl_parse_yaml_files(file_paths.data(), num_files, params_hdl)) <<
+      rcutils_get_error_string().str;
+    expect_same_params_in_order(expected_prefix, params_hdl);
+  }
+
+  // Parameters already present are overridden as by a sequential parse, arenas included
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  ASSERT_TRUE(NULL != params_hdl) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(params_hdl);
+  });
+  ASSERT_TRUE(rcl_parse_yaml_value("camera", "loc", "1.5", params_hdl));
+  EXPECT_TRUE(rcl_parse_yaml_files(file_paths.data(), file_paths.size(), params_hdl)) <<
+    rcutils_get_error_string().str;
+  expect_same_params_in_order(expected, params_hdl);
+
+  rcl_params_t * arena_params_hdl = rcl_yaml_node_struct_init_with_arena(allocator);
+  ASSERT_TRUE(NULL != arena_params_hdl) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(arena_params_hdl);
+  });
+  ASSERT_TRUE(rcl_parse_yaml_value("camera", "loc", "1.5", arena_params_hdl));
+  EXPECT_TRUE(rcl_parse_yaml_files(file_paths.data(), file_paths.size(), arena_params_hdl)) <<
+    rcutils_get_error_string().str;
+  expect_same_params_in_order(expected, arena_params_hdl);
+
+  // Files large enough to be parsed on several threads where there are cores for them
+  std::vector<std::string> large_paths;
+  for (size_t file_idx = 0U; file_idx < 5U; ++file_idx) {
+    large_paths.push_back(
+      (std::filesystem::temp_directory_path() /
+      ("test_parse_files_" + std::to_string(file_idx) + ".yaml")).string());
+    std::ofstream file(large_paths.back());
+    for (size_t node_idx = file_idx; node_idx < file_idx + 20U; ++node_idx) {
+      file << "node_" << node_idx << ":\n  ros__parameters:\n";
+      for (size_t param_idx = 0U; param_idx < 100U; ++param_idx) {
+        file << "    param_" << param_idx << ": " << file_idx << "\n";
+        file << "    ns_" << param_idx % 7U << ":\n      value_" << param_idx << ": [" <<
+          file_idx << ".5, 1.0]\n";
+      }
+    }
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    for (const auto & path : large_paths) {
+      std::error_code error;
+      std::filesystem::remove(path, error);
+    }
+  });
+  std::vector<const char *> large_file_paths;
+  for (const auto & path : large_paths) {
+    large_file_paths.push_back(path.c_str());
+  }
+  large_file_paths.push_back(file_paths[0]);
+  large_file_paths.push_back(large_file_paths[1]);
+  rcl_params_t * large_expected = rcl_yaml_node_struct_init(allocator);
+  ASSERT_TRUE(NULL != large_expected) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(large_expected);
+  });
+  for (const char * file_path : large_file_paths) {
+    ASSERT_TRUE(rcl_parse_yaml_file(file_path, large_expected)) <<
+      rcutils_get_error_string().str;
+  }
+  rcl_params_t * large_params_hdl = rcl_yaml_node_struct_init(allocator);
+  ASSERT_TRUE(NULL != large_params_hdl) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(large_params_hdl);
+  });
+  EXPECT_TRUE(
+    rcl_parse_yaml_files(large_file_paths.data(), large_file_paths.size(), large_params_hdl)) <<
+    rcutils_get_error_string().str;
+  expect_same_params_in_order(large_expected, large_params_hdl);
+
+  // The first file failing to parse is reported
+  const std::string missing_path = std::string(test_path) + "/missing.yaml";
+  const std::string bad_path = std::string(test_path) + "/no_value1.yaml";
+  file_paths[2] = bad_path.c_str();
+  file_paths[6] = missing_path.c_str();
+  rcl_params_t * bad_params_hdl = rcl_yaml_node_struct_init(allocator);
+  ASSERT_TRUE(NULL != bad_params_hdl) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(bad_params_hdl);
+  });
+  EXPECT_FALSE(rcl_parse_yaml_files(file_paths.data(), file_paths.size(), bad_params_hdl));
+  EXPECT_NE(std::string::npos, std::string(rcutils_get_error_string().str).find(bad_path));
+  rcutils_reset_error();
+
+  file_paths[1] = nullptr;
+  EXPECT_FALSE(rcl_parse_yaml_files(file_paths.data(), file_paths.size(), bad_params_hdl));
+  rcutils_reset_error();
+  EXPECT_FALSE(rcl_parse_yaml_files(nullptr, 1U, bad_params_hdl));
+  rcutils_reset_error();
+}
+
+TEST(test_file_parser, reload) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  const std::string path =
+    (std::filesystem::temp_directory_path() / "test_reload.yaml").string();
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    std::error_code error;
+    std::filesystem::remove(path, error);
+  });
+  const std::string old_contents =
+    "robot:\n  ros__parameters:\n"
+    "    speed: 1.5\n    name: r2\n    gains: [1.0, 2.0]\n    mode: 3\n    obsolete: true\n"
+    "camera:\n  ros__parameters:\n    fps: 30\n"
+    "old_node:\n  ros__parameters:\n    param: 1\n";
+  const std::string new_contents =
+    "robot:\n  ros__parameters:\n"
+    "    speed: 2.5\n    name: r2\n    gains: [1.0, 2.0]\n    mode: auto\n    added: [a, b]\n"
+    "camera:\n  ros__parameters:\n    fps: 30\n"
+    "new_node:\n  ros__parameters:\n    param: .nan\n";
+  std::ofstream(path) << new_contents;
+  rcl_params_t * expected = rcl_yaml_node_struct_init(allocator);
+  ASSERT_TRUE(NULL != expected) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(expected);
+  });
+  ASSERT_TRUE(rcl_parse_yaml_file(path.c_str(), expected)) << rcutils_get_error_string().str;
+  std::ofstream(path) << old_contents;
+  rcl_params_t * old_expected = rcl_yaml_node_struct_init(allocator);
+  ASSERT_TRUE(NULL != old_expected) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(old_expected);
+  });
+  ASSERT_TRUE(rcl_parse_yaml_file(path.c_str(), old_expected)) << rcutils_get_error_string().str;
+
+  for (bool use_arena : {false, true}) {
+    std::ofstream(path) << old_contents;
+    rcl_params_t * params_hdl = use_arena ?
+      rcl_yaml_node_struct_init_with_arena(allocator) : rcl_yaml_node_struct_init(allocator);
+    ASSERT_TRUE(NULL != params_hdl) << rcutils_get_error_string().str;
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      rcl_yaml_node_struct_fini(params_hdl);
+    });
+    ASSERT_TRUE(rcl_parse_yaml_file(path.c_str(), params_hdl)) << rcutils_get_error_string().str;
+    rcl_variant_t * gains = rcl_yaml_node_struct_get("robot", "gains", params_hdl);
+    ASSERT_TRUE(NULL != gains);
+    const rcl_double_array_t * gains_value = gains->double_array_value;
+
+    rcl_params_diff_t diff = rcl_yaml_params_diff_get_zero_initialized();
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      rcl_yaml_params_diff_fini(&diff);
+    });
+    std::ofstream(path) << new_contents;
+    ASSERT_TRUE(rcl_yaml_node_struct_reload(path.c_str(), params_hdl, &diff)) <<
+      rcutils_get_error_string().str;
+    expect_same_params_in_order(expected, params_hdl);
+
+    // Unchanged values are kept as they were
+    gains = rcl_yaml_node_struct_get("robot", "gains", params_hdl);
+    ASSERT_TRUE(NULL != gains);
+    EXPECT_EQ(gains_value, gains->double_array_value);
+
+    ASSERT_EQ(6U, diff.num_changes);
+    const std::vector<std::tuple<rcl_param_change_kind_t, std::string, std::string>> changes = {
+      {RCL_PARAM_CHANGE_CHANGED, "robot", "speed"},
+      {RCL_PARAM_CHANGE_CHANGED, "robot", "mode"},
+      {RCL_PARAM_CHANGE_REMOVED, "robot", "obsolete"},
+      {RCL_PARAM_CHANGE_REMOVED, "old_node", "param"},
+      {RCL_PARAM_CHANGE_ADDED, "robot", "added"},
+      {RCL_PARAM_CHANGE_ADDED, "new_node", "param"},
+    };
+    for (size_t i = 0U; i < changes.size(); ++i) {
+      EXPECT_EQ(std::get<0>(changes[i]), diff.changes[i].kind) << i;
+      EXPECT_EQ(std::get<1>(changes[i]), diff.changes[i].node_name) << i;
+      EXPECT_EQ(std::get<2>(changes[i]), diff.changes[i].parameter_name) << i;
+    }
+    ASSERT_TRUE(NULL != diff.changes[0].value.double_value);
+    EXPECT_EQ(2.5, *diff.changes[0].value.double_value);
+    EXPECT_TRUE(NULL == diff.changes[1].value.integer_value);
+    ASSERT_TRUE(NULL != diff.changes[1].value.string_value);
+    EXPECT_STREQ("auto", diff.changes[1].value.string_value);
+    EXPECT_TRUE(NULL == diff.changes[2].value.bool_value);
+    ASSERT_TRUE(NULL != diff.changes[4].value.string_array_value);
+    EXPECT_EQ(2U, diff.changes[4].value.string_array_value->size);
+    ASSERT_TRUE(NULL != diff.changes[5].value.double_value);
+    EXPECT_TRUE(std::isnan(*diff.changes[5].value.double_value));
+
+    // Reloading the same file changes nothing
+    rcl_params_diff_t same_diff = rcl_yaml_params_diff_get_zero_initialized();
+    EXPECT_TRUE(rcl_yaml_node_struct_reload(path.c_str(), params_hdl, &same_diff)) <<
+      rcutils_get_error_string().str;
+    EXPECT_EQ(0U, same_diff.num_changes);
+    rcl_yaml_params_diff_fini(&same_diff);
+    expect_same_params_in_order(expected, params_hdl);
+
+    // Failures leave the parameters as they were
+    EXPECT_FALSE(rcl_yaml_node_struct_reload(path.c_str(), params_hdl, &diff));
+    rcutils_reset_error();
+    rcl_params_diff_t missing_diff = rcl_yaml_params_diff_get_zero_initialized();
+    const std::string missing_path = path + ".missing";
+    EXPECT_FALSE(rcl_yaml_node_struct_reload(missing_path.c_str(), params_hdl, &missing_diff));
+    rcutils_reset_error();
+    EXPECT_EQ(0U, missing_diff.num_changes);
+    expect_same_params_in_order(expected, params_hdl);
+
+    // Copies sharing parameters keep them as they were
+    rcl_params_t * params_copy = rcl_yaml_node_struct_copy(params_hdl);
+    ASSERT_TRUE(NULL != params_copy) << rcutils_get_error_string().str;
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      rcl_yaml_node_struct_fini(params_copy);
+    });
+    std::ofstream(path) << old_contents;
+    rcl_params_diff_t old_diff = rcl_yaml_params_diff_get_zero_initialized();
+    EXPECT_TRUE(rcl_yaml_node_struct_reload(path.c_str(), params_hdl, &old_diff)) <<
+      rcutils_get_error_string().str;
+    EXPECT_EQ(6U, old_diff.num_changes);
+    rcl_yaml_params_diff_fini(&old_diff);
+    expect_same_params_in_order(old_expected, params_hdl);
+    expect_same_params_in_order(expected, params_copy);
+  }
+
+  rcl_params_diff_t diff = rcl_yaml_params_diff_get_zero_initialized();
+  EXPECT_FALSE(rcl_yaml_node_struct_reload(nullptr, expected, &diff));
+  rcutils_reset_error();
+  EXPECT_FALSE(rcl_yaml_node_struct_reload(path.c_str(), nullptr, &diff));
+  rcutils_reset_error();
+  EXPECT_FALSE(rcl_yaml_node_struct_reload(path.c_str(), expected, nullptr));
+  rcutils_reset_error();
+  rcl_yaml_params_diff_fini(nullptr);
+}
+
 int32_t main(int32_t argc, char ** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -14,7 +14,15 @@
 
 #include <yaml.h>
 
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
 #include <string>
+#include <system_error>
+#include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -114,6 +122,9 @@ TEST(RclYamlParamParser, node_copy) {
   EXPECT_NE(copy, nullptr);
   rcl_yaml_node_struct_fini(copy);
 
+  // Parameters without a shared count are copied instead of being shared
+  rcl_yaml_shared_count_t * shared_count = params_st->params[0].shared_count;
+  params_st->params[0].shared_count = nullptr;
   params_st->allocator = get_time_bomb_allocator();
 
   // init of out_params_st fails
@@ -123,7 +134,8 @@ TEST(RclYamlParamParser, node_copy) {
   set_time_bomb_allocator_calloc_count(params_st->allocator, 1);
   EXPECT_EQ(nullptr, rcl_yaml_node_struct_copy(params_st));
 
-  constexpr int expected_num_calloc_calls = 5;
+  // Including the name indexes of the node and of its parameters
+  constexpr int expected_num_calloc_calls = 7;
   for (int i = 0; i < expected_num_calloc_calls; ++i) {
     // Check various locations for allocation failures
     set_time_bomb_allocator_calloc_count(params_st->allocator, i);
@@ -138,7 +150,8 @@ TEST(RclYamlParamParser, node_copy) {
   // Reset calloc countdown
   set_time_bomb_allocator_calloc_count(params_st->allocator, -1);
 
-  constexpr int expected_num_malloc_calls = 3;
+  // Including the shared count of the copied parameters
+  constexpr int expected_num_malloc_calls = 4;
   for (int i = 0; i < expected_num_malloc_calls; ++i) {
     set_time_bomb_allocator_malloc_count(params_st->allocator, i);
     EXPECT_EQ(nullptr, rcl_yaml_node_struct_copy(params_st));
@@ -150,7 +163,7 @@ TEST(RclYamlParamParser, node_copy) {
   EXPECT_NE(nullptr, copy);
   rcl_yaml_node_struct_fini(copy);
 
-  constexpr int num_malloc_calls_until_copy_param = 2;
+  constexpr int num_malloc_calls_until_copy_param = 3;
 
   // Check integer value
   int64_t temp_int = 42;
@@ -251,8 +264,79 @@ TEST(RclYamlParamParser, node_copy) {
     EXPECT_EQ(nullptr, rcl_yaml_node_struct_copy(params_st));
   }
 
+  params_st->params[0].shared_count = shared_count;
   rcl_yaml_node_struct_fini(params_st);
 }
+
+TEST(RclYamlParamParser, node_copy_shares_parameters) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcl_params_t * params_st = rcl_yaml_node_struct_init(allocator);
+  ASSERT_NE(params_st, nullptr);
+  ASSERT_TRUE(rcl_parse_yaml_value("node", "int", "1", params_st));
+  ASSERT_TRUE(rcl_parse_yaml_value("node", "array", "[1.0, 2.0]", params_st));
+  ASSERT_TRUE(rcl_parse_yaml_value("other_node", "string", "value", params_st));
+
+  rcl_params_t * copy = rcl_yaml_node_struct_copy(params_st);
+  ASSERT_NE(copy, nullptr);
+  rcl_params_t * other_copy = rcl_yaml_node_struct_copy(copy);
+  ASSERT_NE(other_copy, nullptr);
+  for (const rcl_params_t * copied : {copy, other_copy}) {
+    ASSERT_EQ(2U, copied->num_nodes);
+    for (size_t node_idx = 0U; node_idx < copied->num_nodes; ++node_idx) {
+      EXPECT_STREQ(params_st->node_names[node_idx], copied->node_names[node_idx]);
+      EXPECT_EQ(params_st->params[node_idx].parameter_values,
+        copied->params[node_idx].parameter_values);
+    }
+  }
+
+  // Modifying a copy copies the parameters of the node only
+  ASSERT_TRUE(rcl_parse_yaml_value("node", "int", "2", copy));
+  EXPECT_NE(params_st->params[0].parameter_values, copy->params[0].parameter_values);
+  EXPECT_EQ(params_st->params[1].parameter_values, copy->params[1].parameter_values);
+  EXPECT_EQ(params_st->params[0].parameter_values, other_copy->params[0].parameter_values);
+  const rcl_variant_t * found = rcl_yaml_node_struct_find("node", "int", copy);
+  ASSERT_NE(found, nullptr);
+  ASSERT_NE(found->integer_value, nullptr);
+  EXPECT_EQ(2, *found->integer_value);
+  found = rcl_yaml_node_struct_find("node", "array", copy);
+  ASSERT_NE(found, nullptr);
+  ASSERT_NE(found->double_array_value, nullptr);
+  EXPECT_EQ(2U, found->double_array_value->size);
+
+  // Finding a value leaves the parameters shared, and adds nothing
+  found = rcl_yaml_node_struct_find("other_node", "string", other_copy);
+  ASSERT_NE(found, nullptr);
+  EXPECT_STREQ("value", found->string_value);
+  EXPECT_EQ(params_st->params[1].parameter_values, other_copy->params[1].parameter_values);
+  size_t num_params = other_copy->params[1].num_params;
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_find("other_node", "missing", other_copy));
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_find("missing_node", "string", other_copy));
+  EXPECT_EQ(num_params, other_copy->params[1].num_params);
+  EXPECT_EQ(2U, other_copy->num_nodes);
+  EXPECT_EQ(params_st->params[1].parameter_values, other_copy->params[1].parameter_values);
+
+  // Getting a value to modify it unshares the parameters of the node
+  rcl_variant_t * value = rcl_yaml_node_struct_get("other_node", "string", other_copy);
+  ASSERT_NE(value, nullptr);
+  EXPECT_NE(params_st->params[1].parameter_values, other_copy->params[1].parameter_values);
+  ASSERT_NE(value->string_value, nullptr);
+  value->string_value[0] = 'V';
+  found = rcl_yaml_node_struct_find("other_node", "string", params_st);
+  ASSERT_NE(found, nullptr);
+  EXPECT_STREQ("value", found->string_value);
+
+  // The parameters live as long as a structure shares them
+  rcl_yaml_node_struct_fini(params_st);
+  found = rcl_yaml_node_struct_find("node", "int", other_copy);
+  ASSERT_NE(found, nullptr);
+  ASSERT_NE(found->integer_value, nullptr);
+  EXPECT_EQ(1, *found->integer_value);
+  rcl_yaml_node_struct_fini(other_copy);
+  found = rcl_yaml_node_struct_find("other_node", "string", copy);
+  ASSERT_NE(found, nullptr);
+  EXPECT_STREQ("value", found->string_value);
+  rcl_yaml_node_struct_fini(copy);
+}
 // // This just tests a couple of basic failures that test_parse_yaml.cpp misses.
 // // See that file for more thorough testing of bad yaml files
 TEST(RclYamlParamParser, test_file) {
@@ -312,6 +396,93 @@ TEST(RclYamlParamParser, test_parse_yaml_value) {
   rcl_yaml_node_struct_fini(params_st);
 }
 
+TEST(RclYamlParamParser, test_parse_yaml_value_scalar_types) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcl_params_t * params_st = rcl_yaml_node_struct_init(allocator);
+  ASSERT_NE(params_st, nullptr);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(params_st);
+  });
+
+  auto parse = [params_st](const char * yaml_value) -> rcl_variant_t * {
+      if (!rcl_parse_yaml_value("node", "param", yaml_value, params_st)) {
+        return nullptr;
+      }
+      return rcl_yaml_node_struct_get("node", "param", params_st);
+    };
+
+  for (const char * yaml_value : {
+      "Y", "y", "yes", "Yes", "YES", "true", "True", "TRUE", "on", "On", "ON"})
+  {
+    rcl_variant_t * variant = parse(yaml_value);
+    ASSERT_NE(variant, nullptr) << yaml_value;
+    ASSERT_NE(variant->bool_value, nullptr) << yaml_value;
+    EXPECT_TRUE(*variant->bool_value) << yaml_value;
+  }
+  for (const char * yaml_value : {
+      "N", "n", "no", "No", "NO", "false", "False", "FALSE", "off", "Off", "OFF"})
+  {
+    rcl_variant_t * variant = parse(yaml_value);
+    ASSERT_NE(variant, nullptr) << yaml_value;
+    ASSERT_NE(variant->bool_value, nullptr) << yaml_value;
+    EXPECT_FALSE(*variant->bool_value) << yaml_value;
+  }
+
+  const std::vector<std::pair<const char *, int64_t>> integers = {
+    {"0", 0}, {"-0", 0}, {"+42", 42}, {"-42", -42}, {"0x1A", 26}, {"010", 8},
+    {"9223372036854775807", INT64_MAX}, {"-9223372036854775808", INT64_MIN}};
+  for (const auto & integer : integers) {
+    rcl_variant_t * variant = parse(integer.first);
+    ASSERT_NE(variant, nullptr) << integer.first;
+    ASSERT_NE(variant->integer_value, nullptr) << integer.first;
+    EXPECT_EQ(integer.second, *variant->integer_value) << integer.first;
+  }
+
+  // Doubles are converted exactly as strtod() does in the C locale
+  for (const char * yaml_value : {
+      "0.0", "-0.0", "1.5", "0.1", "-3.14159", "1e3", "1E-7", "5.", ".5", "-.5", "08",
+      "00.25", "123456789.123456789", "2.2250738585072014e-308", "1.7976931348623157e308",
+      "0x1p-2", "9223372036854775808", "0.30000000000000004", "4503599627370497.0"})
+  {
+    rcl_variant_t * variant = parse(yaml_value);
+    ASSERT_NE(variant, nullptr) << yaml_value;
+    ASSERT_NE(variant->double_value, nullptr) << yaml_value;
+    const double expected = strtod(yaml_value, nullptr);
+    EXPECT_EQ(0, memcmp(&expected, variant->double_value, sizeof(double))) << yaml_value;
+  }
+  for (const char * yaml_value : {".nan", ".NaN", ".NAN", "nan"}) {
+    rcl_variant_t * variant = parse(yaml_value);
+    ASSERT_NE(variant, nullptr) << yaml_value;
+    ASSERT_NE(variant->double_value, nullptr) << yaml_value;
+    EXPECT_TRUE(std::isnan(*variant->double_value)) << yaml_value;
+  }
+  for (const char * yaml_value : {".inf", ".Inf", ".INF", "+.inf", "+.Inf", "+.INF", "inf"}) {
+    rcl_variant_t * variant = parse(yaml_value);
+    ASSERT_NE(variant, nullptr) << yaml_value;
+    ASSERT_NE(variant->double_value, nullptr) << yaml_value;
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), *variant->double_value) << yaml_value;
+  }
+  for (const char * yaml_value : {"-.inf", "-.Inf", "-.INF"}) {
+    rcl_variant_t * variant = parse(yaml_value);
+    ASSERT_NE(variant, nullptr) << yaml_value;
+    ASSERT_NE(variant->double_value, nullptr) << yaml_value;
+    EXPECT_EQ(-std::numeric_limits<double>::infinity(), *variant->double_value) << yaml_value;
+  }
+
+  const std::vector<std::pair<const char *, const char *>> strings = {
+    {"yES", "yES"}, {"truth", "truth"}, {"onwards", "onwards"}, {"nano", "nano"},
+    {"+", "+"}, {"1e", "1e"}, {"1e999", "1e999"}, {"1.2.3", "1.2.3"},
+    {"1_000", "1_000"}, {"'5'", "5"}, {"\"true\"", "true"}, {"!!str 1.5", "1.5"},
+    {"!!str .inf", ".inf"}};
+  for (const auto & string : strings) {
+    rcl_variant_t * variant = parse(string.first);
+    ASSERT_NE(variant, nullptr) << string.first;
+    ASSERT_NE(variant->string_value, nullptr) << string.first;
+    EXPECT_STREQ(string.second, variant->string_value) << string.first;
+  }
+}
+
 TEST(RclYamlParamParser, test_yaml_node_struct_get) {
   const char node_name[] = "node name";
   const char param_name[] = "param name";
@@ -342,6 +513,355 @@ TEST(RclYamlParamParser, test_yaml_node_struct_get) {
   rcl_yaml_node_struct_fini(params_st);
 }
 
+TEST(RclYamlParamParser, test_yaml_node_struct_get_many) {
+  constexpr size_t num_nodes = 20U;
+  constexpr size_t num_params = 500U;
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcl_params_t * params_st = rcl_yaml_node_struct_init(allocator);
+  ASSERT_NE(params_st, nullptr);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(params_st);
+  });
+
+  for (size_t node = 0U; node < num_nodes; ++node) {
+    const std::string node_name = "node_" + std::to_string(node);
+    for (size_t param = 0U; param < num_params; ++param) {
+      const std::string param_name = "param_" + std::to_string(param);
+      const std::string value = std::to_string(node * num_params + param);
+      ASSERT_TRUE(
+        rcl_parse_yaml_value(node_name.c_str(), param_name.c_str(), value.c_str(), params_st)) <<
+        rcutils_get_error_string().str;
+    }
+  }
+  // Parsing a parameter again updates it
+  ASSERT_TRUE(rcl_parse_yaml_value("node_3", "param_7", "-1", params_st));
+  ASSERT_EQ(num_nodes, params_st->num_nodes);
+
+  rcl_params_t * copy = rcl_yaml_node_struct_copy(params_st);
+  ASSERT_NE(copy, nullptr);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(copy);
+  });
+
+  for (rcl_params_t * params : {params_st, copy}) {
+    for (size_t node = 0U; node < num_nodes; ++node) {
+      const std::string node_name = "node_" + std::to_string(node);
+      for (size_t param = 0U; param < num_params; ++param) {
+        const std::string param_name = "param_" + std::to_string(param);
+        rcl_variant_t * result =
+          rcl_yaml_node_struct_get(node_name.c_str(), param_name.c_str(), params);
+        ASSERT_NE(nullptr, result);
+        ASSERT_NE(nullptr, result->integer_value);
+        if (3U == node && 7U == param) {
+          EXPECT_EQ(-1, *result->integer_value);
+        } else {
+          EXPECT_EQ(static_cast<int64_t>(node * num_params + param), *result->integer_value);
+        }
+      }
+      EXPECT_EQ(num_params, params->params[node].num_params);
+    }
+    EXPECT_EQ(num_nodes, params->num_nodes);
+  }
+}
+
+TEST(RclYamlParamParser, test_parse_yaml_value_large_sequences) {
+  constexpr size_t num_values = 10000U;
+  std::string bools = "[";
+  std::string integers = "[";
+  std::string doubles = "[";
+  std::string strings = "[";
+  for (size_t i = 0U; i < num_values; ++i) {
+    const std::string separator = 0U == i ? "" : ", ";
+    bools += separator + (0U == i % 3U ? "true" : "false");
+    integers += separator + std::to_string(i);
+    doubles += separator + std::to_string(i) + ".5";
+    strings += separator + "value_" + std::to_string(i);
+  }
+  bools += "]";
+  integers += "]";
+  doubles += "]";
+  strings += "]";
+
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcl_params_t * params_st = rcl_yaml_node_struct_init(allocator);
+  ASSERT_NE(params_st, nullptr);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(params_st);
+  });
+  ASSERT_TRUE(rcl_parse_yaml_value("node", "bools", bools.c_str(), params_st));
+  ASSERT_TRUE(rcl_parse_yaml_value("node", "integers", integers.c_str(), params_st));
+  ASSERT_TRUE(rcl_parse_yaml_value("node", "doubles", doubles.c_str(), params_st));
+  ASSERT_TRUE(rcl_parse_yaml_value("node", "strings", strings.c_str(), params_st));
+  // Parsing a sequence again replaces it
+  ASSERT_TRUE(rcl_parse_yaml_value("node", "integers", "[3, 2, 1]", params_st));
+
+  rcl_variant_t * bools_value = rcl_yaml_node_struct_get("node", "bools", params_st);
+  ASSERT_NE(nullptr, bools_value);
+  ASSERT_NE(nullptr, bools_value->bool_array_value);
+  ASSERT_EQ(num_values, bools_value->bool_array_value->size);
+  rcl_variant_t * doubles_value = rcl_yaml_node_struct_get("node", "doubles", params_st);
+  ASSERT_NE(nullptr, doubles_value);
+  ASSERT_NE(nullptr, doubles_value->double_array_value);
+  ASSERT_EQ(num_values, doubles_value->double_array_value->size);
+  rcl_variant_t * strings_value = rcl_yaml_node_struct_get("node", "strings", params_st);
+  ASSERT_NE(nullptr, strings_value);
+  ASSERT_NE(nullptr, strings_value->string_array_value);
+  ASSERT_EQ(num_values, strings_value->string_array_value->size);
+  for (size_t i = 0U; i < num_values; ++i) {
+    EXPECT_EQ(0U == i % 3U, bools_value->bool_array_value->values[i]);
+    EXPECT_EQ(static_cast<double>(i) + 0.5, doubles_value->double_array_value->values[i]);
+    EXPECT_STREQ(
+      ("value_" + std::to_string(i)).c_str(), strings_value->string_array_value->data[i]);
+  }
+
+  rcl_variant_t * result = rcl_yaml_node_struct_get("node", "integers", params_st);
+  ASSERT_NE(nullptr, result);
+  ASSERT_NE(nullptr, result->integer_array_value);
+  ASSERT_EQ(3U, result->integer_array_value->size);
+  EXPECT_EQ(3, result->integer_array_value->values[0]);
+  EXPECT_EQ(2, result->integer_array_value->values[1]);
+  EXPECT_EQ(1, result->integer_array_value->values[2]);
+}
+
+static void * counting_allocate(size_t size, void * state)
+{
+  ++*static_cast<size_t *>(state);
+  return rcutils_get_default_allocator().allocate(size, nullptr);
+}
+
+static void counting_deallocate(void * pointer, void * state)
+{
+  (void)state;
+  rcutils_get_default_allocator().deallocate(pointer, nullptr);
+}
+
+static void * counting_reallocate(void * pointer, size_t size, void * state)
+{
+  ++*static_cast<size_t *>(state);
+  return rcutils_get_default_allocator().reallocate(pointer, size, nullptr);
+}
+
+static void * counting_zero_allocate(
+  size_t number_of_elements, size_t size_of_element, void * state)
+{
+  ++*static_cast<size_t *>(state);
+  return rcutils_get_default_allocator().zero_allocate(
+    number_of_elements, size_of_element, nullptr);
+}
+
+#define EXPECT_SAME_ARRAY(expected, value, compare) \
+  do { \
+    ASSERT_NE(nullptr, value); \
+    ASSERT_EQ(expected->size, value->size); \
+    for (size_t i = 0U; i < expected->size; ++i) { \
+      compare(expected->values[i], value->values[i]); \
+    } \
+  } while (0)
+
+// Check that every parameter of `expected` has the same value in `params_st`
+static void expect_same_params(const rcl_params_t * expected_st, rcl_params_t * params_st)
+{
+  ASSERT_EQ(expected_st->num_nodes, params_st->num_nodes);
+  for (size_t node_idx = 0U; node_idx < expected_st->num_nodes; ++node_idx) {
+    const char * node_name = expected_st->node_names[node_idx];
+    const rcl_node_params_t * node_params = &expected_st->params[node_idx];
+    for (size_t param_idx = 0U; param_idx < node_params->num_params; ++param_idx) {
+      const char * param_name = node_params->parameter_names[param_idx];
+      const rcl_variant_t * expected = &node_params->parameter_values[param_idx];
+      const rcl_variant_t * value = rcl_yaml_node_struct_get(node_name, param_name, params_st);
+      ASSERT_NE(nullptr, value) << node_name << " " << param_name;
+      if (NULL != expected->bool_value) {
+        ASSERT_NE(nullptr, value->bool_value);
+        EXPECT_EQ(*expected->bool_value, *value->bool_value);
+      } else if (NULL != expected->integer_value) {
+        ASSERT_NE(nullptr, value->integer_value);
+        EXPECT_EQ(*expected->integer_value, *value->integer_value);
+      } else if (NULL != expected->double_value) {
+        ASSERT_NE(nullptr, value->double_value);
+        EXPECT_EQ(*expected->double_value, *value->double_value);
+      } else if (NULL != expected->string_value) {
+        ASSERT_NE(nullptr, value->string_value);
+        EXPECT_STREQ(expected->string_value, value->string_value);
+      } else if (NULL != expected->bool_array_value) {
+        EXPECT_SAME_ARRAY(expected->bool_array_value, value->bool_array_value, EXPECT_EQ);
+      } else if (NULL != expected->integer_array_value) {
+        EXPECT_SAME_ARRAY(expected->integer_array_value, value->integer_array_value, EXPECT_EQ);
+      } else if (NULL != expected->double_array_value) {
+        EXPECT_SAME_ARRAY(expected->double_array_value, value->double_array_value, EXPECT_EQ);
+      } else if (NULL != expected->string_array_value) {
+        ASSERT_NE(nullptr, value->string_array_value);
+        ASSERT_EQ(expected->string_array_value->size, value->string_array_value->size);
+        for (size_t i = 0U; i < expected->string_array_value->size; ++i) {
+          EXPECT_STREQ(
+            expected->string_array_value->data[i], value->string_array_value->data[i]);
+        }
+      }
+    }
+  }
+}
+
+TEST(RclYamlParamParser, test_parse_yaml_file_with_arena) {
+  char cur_dir[1024];
+  ASSERT_TRUE(rcutils_get_cwd(cur_dir, sizeof(cur_dir)));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * path = rcutils_join_path(cur_dir, "test/correct_config.yaml", allocator);
+  ASSERT_NE(nullptr, path);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    allocator.deallocate(path, allocator.state);
+  });
+
+  size_t num_allocations = 0U;
+  size_t num_arena_allocations = 0U;
+  rcutils_allocator_t counting_allocator = rcutils_get_zero_initialized_allocator();
+  counting_allocator.allocate = counting_allocate;
+  counting_allocator.deallocate = counting_deallocate;
+  counting_allocator.reallocate = counting_reallocate;
+  counting_allocator.zero_allocate = counting_zero_allocate;
+
+  counting_allocator.state = &num_allocations;
+  rcl_params_t * params_st = rcl_yaml_node_struct_init(counting_allocator);
+  ASSERT_NE(nullptr, params_st);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(params_st);
+  });
+  ASSERT_TRUE(rcl_parse_yaml_file(path, params_st)) << rcutils_get_error_string().str;
+  EXPECT_EQ(nullptr, params_st->arena);
+
+  // Allocating the arena or its first block fails
+  rcutils_allocator_t time_bomb_allocator = get_time_bomb_allocator();
+  set_time_bomb_allocator_malloc_count(time_bomb_allocator, 0);
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_init_with_arena(time_bomb_allocator));
+  rcutils_reset_error();
+  set_time_bomb_allocator_malloc_count(time_bomb_allocator, 1);
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_init_with_arena(time_bomb_allocator));
+  rcutils_reset_error();
+
+  counting_allocator.state = &num_arena_allocations;
+  rcl_params_t * arena_params_st = rcl_yaml_node_struct_init_with_arena(counting_allocator);
+  ASSERT_NE(nullptr, arena_params_st);
+  ASSERT_NE(nullptr, arena_params_st->arena);
+  ASSERT_TRUE(rcl_parse_yaml_file(path, arena_params_st)) << rcutils_get_error_string().str;
+  ASSERT_TRUE(rcl_parse_yaml_value("camera", "loc", "back", arena_params_st));
+  ASSERT_TRUE(rcl_parse_yaml_value("camera", "loc", "front", arena_params_st));
+  // A few blocks instead of an allocation for every name and value
+  EXPECT_LT(num_arena_allocations * 10U, num_allocations);
+
+  // The copy has an arena of its own and outlives the original
+  rcl_params_t * copy = rcl_yaml_node_struct_copy(arena_params_st);
+  rcl_yaml_node_struct_fini(arena_params_st);
+  ASSERT_NE(nullptr, copy);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(copy);
+  });
+  EXPECT_NE(nullptr, copy->arena);
+
+  expect_same_params(params_st, copy);
+}
+
+TEST(RclYamlParamParser, test_yaml_node_struct_snapshot) {
+  char cur_dir[1024];
+  ASSERT_TRUE(rcutils_get_cwd(cur_dir, sizeof(cur_dir)));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * path = rcutils_join_path(cur_dir, "test/correct_config.yaml", allocator);
+  ASSERT_NE(nullptr, path);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    allocator.deallocate(path, allocator.state);
+  });
+  const std::string snapshot_path =
+    (std::filesystem::temp_directory_path() / "test_yaml_node_struct_snapshot.bin").string();
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    std::error_code error;
+    std::filesystem::remove(snapshot_path, error);
+  });
+
+  rcl_params_t * params_st = rcl_yaml_node_struct_init(allocator);
+  ASSERT_NE(nullptr, params_st);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(params_st);
+  });
+  ASSERT_TRUE(rcl_parse_yaml_file(path, params_st)) << rcutils_get_error_string().str;
+  ASSERT_TRUE(rcl_parse_yaml_value("snapshot", "bools", "[true, false, true]", params_st));
+  ASSERT_TRUE(rcl_parse_yaml_value("snapshot", "integers", "[1, -2, 3]", params_st));
+  ASSERT_TRUE(rcl_parse_yaml_value("snapshot", "flag", "false", params_st));
+  // A parameter without a value
+  ASSERT_NE(nullptr, rcl_yaml_node_struct_get("snapshot", "none", params_st));
+
+  EXPECT_FALSE(rcl_yaml_node_struct_write_snapshot(params_st, cur_dir));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_load_snapshot(path, allocator));
+  rcutils_reset_error();
+  ASSERT_TRUE(rcl_yaml_node_struct_write_snapshot(params_st, snapshot_path.c_str())) <<
+    rcutils_get_error_string().str;
+
+  rcl_params_t * loaded = rcl_yaml_node_struct_load_snapshot(snapshot_path.c_str(), allocator);
+  ASSERT_NE(nullptr, loaded) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(loaded);
+  });
+  EXPECT_NE(nullptr, loaded->arena);
+  expect_same_params(params_st, loaded);
+
+  // Loaded parameters can be modified and copied like parsed ones
+  ASSERT_TRUE(rcl_parse_yaml_value("camera", "loc", "\"back\"", loaded));
+  ASSERT_TRUE(rcl_parse_yaml_value("snapshot", "added", "42", loaded));
+  ASSERT_TRUE(rcl_parse_yaml_value("added", "added", "[1.0, 2.0]", loaded));
+  rcl_params_t * copy = rcl_yaml_node_struct_copy(loaded);
+  ASSERT_NE(nullptr, copy);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(copy);
+  });
+  expect_same_params(loaded, copy);
+  rcl_variant_t * value = rcl_yaml_node_struct_get("snapshot", "added", copy);
+  ASSERT_NE(nullptr, value);
+  ASSERT_NE(nullptr, value->integer_value);
+  EXPECT_EQ(42, *value->integer_value);
+
+  // Overwriting a snapshot, here with a smaller one, leaves the loaded one intact
+  rcl_params_t * small = rcl_yaml_node_struct_init(allocator);
+  ASSERT_NE(nullptr, small);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(small);
+  });
+  ASSERT_TRUE(rcl_parse_yaml_value("small", "flag", "true", small));
+  ASSERT_TRUE(rcl_yaml_node_struct_write_snapshot(small, snapshot_path.c_str())) <<
+    rcutils_get_error_string().str;
+  expect_same_params(copy, loaded);
+
+  // Snapshots that are truncated, or of another version, are rejected
+  std::string contents;
+  {
+    std::ifstream file(snapshot_path, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  ASSERT_GT(contents.size(), 64U);
+  const std::vector<std::string> corrupted = {
+    contents.substr(0U, contents.size() / 2U),
+    contents.substr(0U, 16U),
+    "RCLPARAX" + contents.substr(8U),
+    contents.substr(0U, 8U) + '\x7f' + contents.substr(9U),
+  };
+  for (const std::string & data : corrupted) {
+    {
+      std::ofstream file(snapshot_path, std::ios::binary | std::ios::trunc);
+      file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+    EXPECT_EQ(nullptr, rcl_yaml_node_struct_load_snapshot(snapshot_path.c_str(), allocator));
+    rcutils_reset_error();
+  }
+}
+
 // Just testing basic parameters, this is exercised more in test_parse_yaml.cpp
 TEST(RclYamlParamParser, test_yaml_node_struct_print) {
   rcl_yaml_node_struct_print(nullptr);
@@ -14,6 +14,7 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
 #include <type_traits>
 
 #include "osrf_testing_tools_cpp/scope_exit.hpp"
@@ -216,3 +217,65 @@ TEST(TestYamlVariant, copy_string_array_maybe_fail) {
     rcl_yaml_variant_fini(&dest_variant, allocator);
   });
 }
+
+TEST(TestYamlVariant, equal) {
+  bool true_value = true;
+  bool false_value = false;
+  int64_t int_value = 1;
+  double double_value = 1.0;
+  double other_double_value = -0.0;
+  double zero_value = 0.0;
+  double nan_value = std::numeric_limits<double>::quiet_NaN();
+  char string_value[] = "string";
+  char other_string_value[] = "other";
+  double double_values[] = {1.0, 2.0};
+  double other_double_values[] = {1.0, 3.0};
+  rcl_double_array_t double_array = {double_values, 2U};
+  rcl_double_array_t other_double_array = {other_double_values, 2U};
+  rcl_double_array_t short_double_array = {double_values, 1U};
+
+  rcl_variant_t lhs{};
+  rcl_variant_t rhs{};
+  EXPECT_TRUE(rcl_yaml_variant_equal(&lhs, &rhs));
+  lhs.bool_value = &true_value;
+  EXPECT_FALSE(rcl_yaml_variant_equal(&lhs, &rhs));
+  EXPECT_FALSE(rcl_yaml_variant_equal(&rhs, &lhs));
+  rhs.bool_value = &false_value;
+  EXPECT_FALSE(rcl_yaml_variant_equal(&lhs, &rhs));
+  rhs.bool_value = &true_value;
+  EXPECT_TRUE(rcl_yaml_variant_equal(&lhs, &rhs));
+
+  rhs = rcl_variant_t{};
+  rhs.integer_value = &int_value;
+  EXPECT_FALSE(rcl_yaml_variant_equal(&lhs, &rhs));
+  lhs = rcl_variant_t{};
+  lhs.double_value = &double_value;
+  EXPECT_FALSE(rcl_yaml_variant_equal(&lhs, &rhs));
+  rhs = rcl_variant_t{};
+  rhs.double_value = &double_value;
+  EXPECT_TRUE(rcl_yaml_variant_equal(&lhs, &rhs));
+  lhs.double_value = &nan_value;
+  rhs.double_value = &nan_value;
+  EXPECT_TRUE(rcl_yaml_variant_equal(&lhs, &rhs));
+  lhs.double_value = &zero_value;
+  rhs.double_value = &other_double_value;
+  EXPECT_FALSE(rcl_yaml_variant_equal(&lhs, &rhs));
+
+  lhs = rcl_variant_t{};
+  rhs = rcl_variant_t{};
+  lhs.string_value = string_value;
+  rhs.string_value = other_string_value;
+  EXPECT_FALSE(rcl_yaml_variant_equal(&lhs, &rhs));
+  rhs.string_value = string_value;
+  EXPECT_TRUE(rcl_yaml_variant_equal(&lhs, &rhs));
+
+  lhs = rcl_variant_t{};
+  rhs = rcl_variant_t{};
+  lhs.double_array_value = &double_array;
+  rhs.double_array_value = &other_double_array;
+  EXPECT_FALSE(rcl_yaml_variant_equal(&lhs, &rhs));
+  rhs.double_array_value = &short_double_array;
+  EXPECT_FALSE(rcl_yaml_variant_equal(&lhs, &rhs));
+  rhs.double_array_value = &double_array;
+  EXPECT_TRUE(rcl_yaml_variant_equal(&lhs, &rhs));
+}